@@ -46,6 +46,8 @@
 
 #include "SDL_main.h"
 #include "SDL_stdinc.h"
+#include "SDL_asyncio.h"
+#include "SDL_atomic.h"
 #include "SDL_audio.h"
 #include "SDL_cdrom.h"
 #include "SDL_cpuinfo.h"
@@ -60,6 +62,7 @@
 #include "SDL_revision.h"
 #include "SDL_pixels.h"
 #include "SDL_platform.h"
+#include "SDL_taskpool.h"
 #include "SDL_thread.h"
 #include "SDL_timer.h"
 #include "SDL_video.h"
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+
+/** @file SDL_asyncio.h
+ *  Background file reads for streaming assets
+ *
+ *  Requests go into a bounded queue served by one I/O thread, which reads
+ *  each file whole into memory and can hand it to a loader such as
+ *  SDL_LoadWAV_RW() or SDL_LoadBMP_RW() before reporting completion.
+ *  Completion is polled with SDL_AsyncIOStatus(), waited for with
+ *  SDL_AsyncIOWait(), or delivered as an SDL_ASYNCIODONE event.
+ */
+#ifndef SDL_asyncio_h_
+#define SDL_asyncio_h_
+
+#include "SDL_stdinc.h"
+#include "SDL_error.h"
+#include "SDL_rwops.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** An asynchronous read, defined in SDL_asyncio.c */
+struct SDL_AsyncIO;
+typedef struct SDL_AsyncIO SDL_AsyncIO;
+
+/** A loader run on the I/O thread with a read-only memory RWops on the
+ *  file contents, which it must close, e.g. SDL_LoadBMP_RW(src, 1). Its
+ *  return value is kept for SDL_AsyncIOResult(), and returning NULL fails
+ *  the request. The contents stay valid until SDL_AsyncIOFree(), so the
+ *  loader may keep pointers into them.
+ */
+typedef void *(SDLCALL *SDL_AsyncIOFunction)(SDL_RWops *src, void *data);
+
+/** @name Values returned by SDL_AsyncIOStatus() and SDL_AsyncIOWait() */
+/*@{*/
+#define SDL_ASYNCIO_FAILED    -1   /**< The read or the loader failed */
+#define SDL_ASYNCIO_PENDING    0   /**< Queued or in progress */
+#define SDL_ASYNCIO_DONE       1   /**< Finished */
+/*@}*/
+
+/** @name Flags for SDL_AsyncReadFile() */
+/*@{*/
+#define SDL_ASYNCIO_EVENT     0x01  /**< Post SDL_ASYNCIODONE when finished */
+#define SDL_ASYNCIO_NOWAIT    0x02  /**< Fail instead of waiting for room in a full queue */
+/*@}*/
+
+/** Queue a read of the whole file.
+ *  @param load If not NULL, called on the I/O thread once the file is read.
+ *  @param data Passed to load() and found in SDL_ASYNCIODONE events.
+ *  @param flags A mask of SDL_ASYNCIO_* flags.
+ *  @return The request, or NULL on error. Free it with SDL_AsyncIOFree().
+ *
+ *  If the I/O thread can't be started the read is done before returning.
+ */
+extern DECLSPEC SDL_AsyncIO *SDLCALL SDL_AsyncReadFile(const char *file, SDL_AsyncIOFunction load, void *data, int flags);
+
+/** Returns SDL_ASYNCIO_PENDING, SDL_ASYNCIO_DONE or SDL_ASYNCIO_FAILED.
+ *  On failure SDL_GetError() gives the reason.
+ */
+extern DECLSPEC int SDLCALL SDL_AsyncIOStatus(SDL_AsyncIO *io);
+
+/** Wait for the request to finish, returns SDL_ASYNCIO_DONE or SDL_ASYNCIO_FAILED */
+extern DECLSPEC int SDLCALL SDL_AsyncIOWait(SDL_AsyncIO *io);
+
+/** Returns the file contents of a finished request and stores their length
+ *  in 'size', or NULL if it isn't finished. Valid until SDL_AsyncIOFree().
+ */
+extern DECLSPEC const void *SDLCALL SDL_AsyncIOData(SDL_AsyncIO *io, int *size);
+
+/** Returns what the loader returned, or NULL if it isn't finished */
+extern DECLSPEC void *SDLCALL SDL_AsyncIOResult(SDL_AsyncIO *io);
+
+/** Free the request and the file contents. A request still in the queue is
+ *  dropped unread. One being read is freed by the I/O thread when it
+ *  finishes, so wait for it first if its loader allocates anything. A
+ *  finished request must not be freed while its event is still queued.
+ */
+extern DECLSPEC void SDLCALL SDL_AsyncIOFree(SDL_AsyncIO *io);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#include "close_code.h"
+
+#endif /* SDL_asyncio_h_ */
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+
+/** @file SDL_atomic.h
+ *  Atomic operations, memory barriers and spinlocks
+ *
+ *  @note These are low-level primitives for hot paths that cannot afford a
+ *  mutex. If you are not sure you need them, use SDL_mutex.h instead.
+ */
+#ifndef SDL_atomic_h_
+#define SDL_atomic_h_
+
+#include "SDL_stdinc.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/** @name Spinlock functions                                     */ /*@{*/
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/** The atomic spinlock type, 0 means unlocked.
+ *
+ *  Spinlocks never sleep in the kernel on the fast path, so they should
+ *  only protect a handful of instructions.
+ */
+typedef int SDL_SpinLock;
+
+/** Try to lock a spinlock without waiting.
+ *  @return SDL_TRUE if the lock was taken, SDL_FALSE if it is held elsewhere.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_AtomicTryLock(SDL_SpinLock *lock);
+
+/** Lock a spinlock, spinning (and eventually yielding) until it is free */
+extern DECLSPEC void SDLCALL SDL_AtomicLock(SDL_SpinLock *lock);
+
+/** Unlock a spinlock taken with SDL_AtomicLock() or SDL_AtomicTryLock() */
+extern DECLSPEC void SDLCALL SDL_AtomicUnlock(SDL_SpinLock *lock);
+
+/*@}*/
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/** @name Memory barriers                                        */ /*@{*/
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/** Prevent the compiler from reordering loads and stores across this point.
+ *  This does not emit any instruction and does not order the CPU.
+ */
+#if defined(__GNUC__)
+#define SDL_CompilerBarrier()    __asm__ __volatile__ ("" : : : "memory")
+#else
+#define SDL_CompilerBarrier()    \
+	{ SDL_SpinLock _tmp = 0; SDL_AtomicLock(&_tmp); SDL_AtomicUnlock(&_tmp); }
+#endif
+
+/** Memory barriers for publishing data to another thread.
+ *
+ *  Write the data, then call SDL_MemoryBarrierRelease() before setting the
+ *  flag. The reader checks the flag, then calls SDL_MemoryBarrierAcquire()
+ *  before reading the data. The atomic functions below already imply a full
+ *  barrier, so these are only needed around plain loads and stores.
+ */
+#if defined(__GNUC__) && defined(__aarch64__)
+#define SDL_MemoryBarrierRelease()    __asm__ __volatile__ ("dmb ish" : : : "memory")
+#define SDL_MemoryBarrierAcquire()    __asm__ __volatile__ ("dmb ishld" : : : "memory")
+#elif defined(__GNUC__) && defined(__arm__)
+#if defined(__ARM_ARCH_7__) || defined(__ARM_ARCH_7A__) || defined(__ARM_ARCH_7R__) || \
+    defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7S__) || \
+    (defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+#define SDL_MemoryBarrierRelease()    __asm__ __volatile__ ("dmb ish" : : : "memory")
+#define SDL_MemoryBarrierAcquire()    __asm__ __volatile__ ("dmb ish" : : : "memory")
+#elif defined(__ARM_ARCH_6__) || defined(__ARM_ARCH_6J__) || defined(__ARM_ARCH_6K__) || \
+      defined(__ARM_ARCH_6T2__) || defined(__ARM_ARCH_6Z__) || defined(__ARM_ARCH_6ZK__)
+/* ARMv6 has no dmb instruction, the barrier lives in the CP15 register space */
+#define SDL_MemoryBarrierRelease()    __asm__ __volatile__ ("mcr p15, 0, %0, c7, c10, 5" : : "r"(0) : "memory")
+#define SDL_MemoryBarrierAcquire()    __asm__ __volatile__ ("mcr p15, 0, %0, c7, c10, 5" : : "r"(0) : "memory")
+#else
+/* ARMv5 and older are uniprocessor only */
+#define SDL_MemoryBarrierRelease()    SDL_CompilerBarrier()
+#define SDL_MemoryBarrierAcquire()    SDL_CompilerBarrier()
+#endif
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+/* x86 never reorders stores with stores or loads with loads */
+#define SDL_MemoryBarrierRelease()    SDL_CompilerBarrier()
+#define SDL_MemoryBarrierAcquire()    SDL_CompilerBarrier()
+#elif defined(__GNUC__) && defined(__GCC_ATOMIC_INT_LOCK_FREE)
+#define SDL_MemoryBarrierRelease()    __atomic_thread_fence(__ATOMIC_RELEASE)
+#define SDL_MemoryBarrierAcquire()    __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#define SDL_MemoryBarrierRelease()    SDL_CompilerBarrier()
+#define SDL_MemoryBarrierAcquire()    SDL_CompilerBarrier()
+#endif
+
+/*@}*/
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/** @name Atomic integer and pointer functions                   */ /*@{*/
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/** An integer that is only ever accessed through the functions below.
+ *  Wrapping it in a structure keeps it from being used by accident as a
+ *  plain int.
+ */
+typedef struct SDL_atomic_t {
+	int value;
+} SDL_atomic_t;
+
+/** Set an atomic variable to newval only if it currently holds oldval.
+ *  @return SDL_TRUE if the value was swapped, SDL_FALSE otherwise.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_AtomicCAS(SDL_atomic_t *a, int oldval, int newval);
+
+/** Set an atomic variable to a value.
+ *  @return The previous value of the atomic variable.
+ */
+extern DECLSPEC int SDLCALL SDL_AtomicSet(SDL_atomic_t *a, int v);
+
+/** Get the value of an atomic variable */
+extern DECLSPEC int SDLCALL SDL_AtomicGet(SDL_atomic_t *a);
+
+/** Add to an atomic variable, use a negative value to subtract.
+ *  @return The previous value of the atomic variable.
+ */
+extern DECLSPEC int SDLCALL SDL_AtomicAdd(SDL_atomic_t *a, int v);
+
+/** Increment an atomic variable used as a reference count */
+#define SDL_AtomicIncRef(a)    SDL_AtomicAdd(a, 1)
+
+/** Decrement an atomic variable used as a reference count.
+ *  @return SDL_TRUE if the variable reached zero after decrementing.
+ */
+#define SDL_AtomicDecRef(a)    (SDL_AtomicAdd(a, -1) == 1)
+
+/** Set a pointer to newval only if it currently holds oldval.
+ *  @return SDL_TRUE if the pointer was swapped, SDL_FALSE otherwise.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_AtomicCASPtr(void **a, void *oldval, void *newval);
+
+/** Set a pointer to a value atomically.
+ *  @return The previous value of the pointer.
+ */
+extern DECLSPEC void *SDLCALL SDL_AtomicSetPtr(void **a, void *v);
+
+/** Get the value of a pointer atomically */
+extern DECLSPEC void *SDLCALL SDL_AtomicGetPtr(void **a);
+
+/*@}*/
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#include "close_code.h"
+
+#endif /* SDL_atomic_h_ */
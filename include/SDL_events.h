@@ -75,11 +75,11 @@ typedef enum {
 	SDL_JOYBUTTONUP,     /**< Joystick button released */
 	SDL_QUIT,            /**< User-requested quit */
 	SDL_SYSWMEVENT,      /**< System specific event */
-	SDL_EVENT_RESERVEDA, /**< Reserved for future use.. */
-	SDL_EVENT_RESERVEDB, /**< Reserved for future use.. */
+	SDL_JOYDEVICEADDED,  /**< Joystick plugged in */
+	SDL_JOYDEVICEREMOVED, /**< Joystick unplugged */
 	SDL_VIDEORESIZE,     /**< User resized video mode */
 	SDL_VIDEOEXPOSE,     /**< Screen needs to be redrawn */
-	SDL_EVENT_RESERVED2, /**< Reserved for future use.. */
+	SDL_ASYNCIODONE,     /**< Asynchronous file read finished */
 	SDL_EVENT_RESERVED3, /**< Reserved for future use.. */
 	SDL_EVENT_RESERVED4, /**< Reserved for future use.. */
 	SDL_EVENT_RESERVED5, /**< Reserved for future use.. */
@@ -111,9 +111,12 @@ typedef enum {
 	SDL_JOYHATMOTIONMASK = SDL_EVENTMASK(SDL_JOYHATMOTION),
 	SDL_JOYBUTTONDOWNMASK = SDL_EVENTMASK(SDL_JOYBUTTONDOWN),
 	SDL_JOYBUTTONUPMASK = SDL_EVENTMASK(SDL_JOYBUTTONUP),
-	SDL_JOYEVENTMASK = SDL_EVENTMASK(SDL_JOYAXISMOTION) | SDL_EVENTMASK(SDL_JOYBALLMOTION) | SDL_EVENTMASK(SDL_JOYHATMOTION) | SDL_EVENTMASK(SDL_JOYBUTTONDOWN) | SDL_EVENTMASK(SDL_JOYBUTTONUP),
+	SDL_JOYDEVICEADDEDMASK = SDL_EVENTMASK(SDL_JOYDEVICEADDED),
+	SDL_JOYDEVICEREMOVEDMASK = SDL_EVENTMASK(SDL_JOYDEVICEREMOVED),
+	SDL_JOYEVENTMASK = SDL_EVENTMASK(SDL_JOYAXISMOTION) | SDL_EVENTMASK(SDL_JOYBALLMOTION) | SDL_EVENTMASK(SDL_JOYHATMOTION) | SDL_EVENTMASK(SDL_JOYBUTTONDOWN) | SDL_EVENTMASK(SDL_JOYBUTTONUP) | SDL_EVENTMASK(SDL_JOYDEVICEADDED) | SDL_EVENTMASK(SDL_JOYDEVICEREMOVED),
 	SDL_VIDEORESIZEMASK = SDL_EVENTMASK(SDL_VIDEORESIZE),
 	SDL_VIDEOEXPOSEMASK = SDL_EVENTMASK(SDL_VIDEOEXPOSE),
+	SDL_ASYNCIODONEMASK = SDL_EVENTMASK(SDL_ASYNCIODONE),
 	SDL_QUITMASK = SDL_EVENTMASK(SDL_QUIT),
 	SDL_SYSWMEVENTMASK = SDL_EVENTMASK(SDL_SYSWMEVENT)
 } SDL_EventMask;
@@ -203,6 +206,14 @@ typedef struct SDL_JoyButtonEvent {
 	Uint8 state;    /**< SDL_PRESSED or SDL_RELEASED */
 } SDL_JoyButtonEvent;
 
+/** Joystick hotplug event structure */
+typedef struct SDL_JoyDeviceEvent {
+	Uint8 type;     /**< SDL_JOYDEVICEADDED or SDL_JOYDEVICEREMOVED */
+	Uint8 which;    /**< The joystick device index. Indices stay valid until
+					 *   the joystick subsystem is shut down, and a device
+					 *   coming back on the same node gets its old index */
+} SDL_JoyDeviceEvent;
+
 /** The "window resized" event
  *  When you get this event, you are responsible for setting a new video
  *  mode with the new width and height.
@@ -223,6 +234,15 @@ typedef struct SDL_QuitEvent {
 	Uint8 type;     /**< SDL_QUIT */
 } SDL_QuitEvent;
 
+/** Asynchronous read completion, see SDL_asyncio.h */
+struct SDL_AsyncIO;
+typedef struct SDL_AsyncIOEvent {
+	Uint8 type;     /**< SDL_ASYNCIODONE */
+	int status;     /**< SDL_ASYNCIO_DONE or SDL_ASYNCIO_FAILED */
+	struct SDL_AsyncIO *io; /**< The finished request */
+	void *data;     /**< The data pointer given to SDL_AsyncReadFile() */
+} SDL_AsyncIOEvent;
+
 /** A user-defined event type */
 typedef struct SDL_UserEvent {
 	Uint8 type;     /**< SDL_USEREVENT through SDL_NUMEVENTS-1 */
@@ -251,9 +271,11 @@ typedef union SDL_Event {
 	SDL_JoyBallEvent jball;
 	SDL_JoyHatEvent jhat;
 	SDL_JoyButtonEvent jbutton;
+	SDL_JoyDeviceEvent jdevice;
 	SDL_ResizeEvent resize;
 	SDL_ExposeEvent expose;
 	SDL_QuitEvent quit;
+	SDL_AsyncIOEvent asyncio;
 	SDL_UserEvent user;
 	SDL_SysWMEvent syswm;
 } SDL_Event;
@@ -364,6 +386,31 @@ extern DECLSPEC SDL_EventFilter SDLCALL SDL_GetEventFilter(void);
 */
 extern DECLSPEC Uint8 SDLCALL SDL_EventState(Uint8 type, int state);
 
+/**
+ * Return when the input behind the event most recently returned by
+ * SDL_PollEvent(), SDL_WaitEvent() or SDL_PeepEvents() happened, in
+ * SDL_GetTicks() milliseconds.  Backends that read the kernel's input
+ * timestamps report those, other events are stamped when queued.
+ * For SDL_PeepEvents() returning several events this is the last one's.
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetEventTimestamp(void);
+
+/** Report rate of an input device, as returned by SDL_GetInputRates() */
+typedef struct SDL_InputRate {
+	char device[64];  /**< The device node, e.g. /dev/input/event3 */
+	Uint32 reports;   /**< Complete input reports per second */
+	Uint32 events;    /**< Raw input events per second */
+} SDL_InputRate;
+
+/**
+ * Fill in the report rates of up to 'maxrates' input devices the event
+ * backend reads from directly, such as evdev keyboards, mice and opened
+ * joysticks. The rates are measured over the last full second.
+ *
+ * @return the number of entries filled in.
+ */
+extern DECLSPEC int SDLCALL SDL_GetInputRates(SDL_InputRate *rates, int maxrates);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -1158,6 +1158,109 @@ extern DECLSPEC int SDLCALL SDL_HapticUnpause(SDL_Haptic *haptic);
  */
 extern DECLSPEC int SDLCALL SDL_HapticStopAll(SDL_Haptic *haptic);
 
+/**
+ *  \brief Queues new parameters for an effect.
+ *
+ *  Unlike SDL_HapticUpdateEffect() nothing is sent to the device yet. Only
+ *  the last parameters queued before SDL_HapticFlush() are uploaded, and
+ *  only if they differ from what the device already has.
+ *
+ *  \param haptic Haptic device that has the effect.
+ *  \param effect Effect to update.
+ *  \param data New effect properties to use.
+ *  \return 0 on success or -1 on error.
+ *
+ *  \sa SDL_HapticFlush
+ */
+extern DECLSPEC int SDLCALL SDL_HapticQueueUpdate(SDL_Haptic *haptic, int effect, SDL_HapticEffect *data);
+
+/**
+ *  \brief Queues running an effect until the next SDL_HapticFlush().
+ *
+ *  \param haptic Haptic device to run the effect on.
+ *  \param effect Identifier of the haptic effect to run.
+ *  \param iterations Number of iterations to run the effect, must be at
+ *         least 1. Use SDL_HAPTIC_INFINITY for infinity.
+ *  \return 0 on success or -1 on error.
+ *
+ *  \sa SDL_HapticFlush
+ */
+extern DECLSPEC int SDLCALL SDL_HapticQueueRun(SDL_Haptic *haptic, int effect, Uint32 iterations);
+
+/**
+ *  \brief Queues stopping an effect until the next SDL_HapticFlush().
+ *
+ *  \param haptic Haptic device to stop the effect on.
+ *  \param effect Identifier of the effect to stop.
+ *  \return 0 on success or -1 on error.
+ *
+ *  \sa SDL_HapticFlush
+ */
+extern DECLSPEC int SDLCALL SDL_HapticQueueStop(SDL_Haptic *haptic, int effect);
+
+/**
+ *  \brief Sends everything queued on a haptic device.
+ *
+ *  Changed effects are uploaded first, then all queued runs and stops go
+ *  to the device together. Call it once per frame.
+ *
+ *  \param haptic Haptic device to flush.
+ *  \return 0 on success or -1 on error.
+ *
+ *  \sa SDL_HapticQueueUpdate
+ *  \sa SDL_HapticQueueRun
+ *  \sa SDL_HapticQueueStop
+ */
+extern DECLSPEC int SDLCALL SDL_HapticFlush(SDL_Haptic *haptic);
+
+/**
+ *  \brief Checks to see if rumble is supported on a haptic device.
+ *
+ *  \param haptic Haptic device to check for rumble support.
+ *  \return SDL_TRUE if effect is supported, SDL_FALSE if it isn't or -1 on error.
+ *
+ *  \sa SDL_HapticRumbleInit
+ *  \sa SDL_HapticRumblePlay
+ */
+extern DECLSPEC int SDLCALL SDL_HapticRumbleSupported(SDL_Haptic *haptic);
+
+/**
+ *  \brief Initializes the haptic device for simple rumble playback.
+ *
+ *  \param haptic Haptic device to initialize for simple rumble playback.
+ *  \return 0 on success or -1 on error.
+ *
+ *  \sa SDL_HapticRumblePlay
+ *  \sa SDL_HapticRumbleStop
+ */
+extern DECLSPEC int SDLCALL SDL_HapticRumbleInit(SDL_Haptic *haptic);
+
+/**
+ *  \brief Runs simple rumble on a haptic device.
+ *
+ *  Meant to be called every frame: the effect is only uploaded again when
+ *  the strength or length changed, and it is started with a single write.
+ *
+ *  \param haptic Haptic device to play rumble effect on.
+ *  \param strength Strength of the rumble to play as a 0-1 float value.
+ *  \param length Length of the rumble to play in milliseconds.
+ *  \return 0 on success or -1 on error.
+ *
+ *  \sa SDL_HapticRumbleInit
+ *  \sa SDL_HapticRumbleStop
+ */
+extern DECLSPEC int SDLCALL SDL_HapticRumblePlay(SDL_Haptic *haptic, float strength, Uint32 length);
+
+/**
+ *  \brief Stops the simple rumble on a haptic device.
+ *
+ *  \param haptic Haptic to stop the rumble on.
+ *  \return 0 on success or -1 on error.
+ *
+ *  \sa SDL_HapticRumblePlay
+ */
+extern DECLSPEC int SDLCALL SDL_HapticRumbleStop(SDL_Haptic *haptic);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
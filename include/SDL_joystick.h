@@ -149,6 +149,12 @@ extern DECLSPEC int SDLCALL SDL_JoystickNumButtons(SDL_Joystick *joystick);
  */
 extern DECLSPEC void SDLCALL SDL_JoystickUpdate(void);
 
+/**
+ * Passed to SDL_JoystickEventState() to turn off joystick events while the
+ * event loop keeps updating the joystick state.
+ */
+#define SDL_JOYSTICK_STATEONLY 2
+
 /**
  * Enable/disable joystick event polling.
  *
@@ -156,7 +162,12 @@ extern DECLSPEC void SDLCALL SDL_JoystickUpdate(void);
  * yourself and check the state of the joystick when you want joystick
  * information.
  *
- * @param[in] state The state can be one of SDL_QUERY, SDL_ENABLE or SDL_IGNORE.
+ * With SDL_JOYSTICK_STATEONLY no joystick events are generated at all, but
+ * SDL_PumpEvents() (or the event thread) still calls SDL_JoystickUpdate(),
+ * so the state can be read with SDL_JoystickGetState() every frame.
+ *
+ * @param[in] state The state can be one of SDL_QUERY, SDL_ENABLE, SDL_IGNORE
+ *                  or SDL_JOYSTICK_STATEONLY.
  */
 extern DECLSPEC int SDLCALL SDL_JoystickEventState(int state);
 
@@ -208,6 +219,42 @@ extern DECLSPEC int SDLCALL SDL_JoystickGetBall(SDL_Joystick *joystick, int ball
  */
 extern DECLSPEC Uint8 SDLCALL SDL_JoystickGetButton(SDL_Joystick *joystick, int button);
 
+/**
+ *  @name Joystick State Limits
+ *  Controls past these indices are not part of an SDL_JoystickState.
+ */
+/*@{*/
+#define SDL_JOYSTATE_MAX_AXES    64
+#define SDL_JOYSTATE_MAX_HATS    8
+#define SDL_JOYSTATE_MAX_BALLS   4
+#define SDL_JOYSTATE_MAX_BUTTONS 128
+/*@}*/
+
+/** Snapshot of every control on a joystick */
+typedef struct SDL_JoystickState {
+	Uint8 which;    /**< The joystick device index */
+	int naxes;      /**< Number of valid entries in axes */
+	int nhats;      /**< Number of valid entries in hats */
+	int nballs;     /**< Number of valid entries in balls */
+	int nbuttons;   /**< Number of valid entries in buttons */
+	Sint16 axes[SDL_JOYSTATE_MAX_AXES];
+	Uint8 hats[SDL_JOYSTATE_MAX_HATS];
+	Uint8 buttons[SDL_JOYSTATE_MAX_BUTTONS];
+	struct {
+		int dx;
+		int dy;
+	} balls[SDL_JOYSTATE_MAX_BALLS];  /**< Ball motion since the last read */
+} SDL_JoystickState;
+
+/**
+ * Copy the current state of all axes, hats, balls and buttons of a joystick
+ * into 'state' in one go. Call it after SDL_JoystickUpdate() or
+ * SDL_PumpEvents(). Like SDL_JoystickGetBall(), the ball deltas are reset.
+ *
+ * @return This returns 0, or -1 if you passed it invalid parameters.
+ */
+extern DECLSPEC int SDLCALL SDL_JoystickGetState(SDL_Joystick *joystick, SDL_JoystickState *state);
+
 /**
  * Close a joystick previously opened with SDL_JoystickOpen()
  */
@@ -136,6 +136,22 @@ extern DECLSPEC void SDLCALL SDL_SetModState(SDLMod modstate);
  */
 extern DECLSPEC char *SDLCALL SDL_GetKeyName(SDLKey key);
 
+/** One entry of a key remap table */
+typedef struct SDL_KeyRemap {
+	Uint16 code;     /**< Raw key or button code of the input device */
+	SDLKey sym;      /**< Reported as this key, SDLK_UNKNOWN to drop it */
+	Uint8 button;    /**< Or as this mouse button if not 0 */
+} SDL_KeyRemap;
+
+/**
+ * Remap the raw keys and buttons of input devices that SDL reads directly,
+ * like the Linux event devices of the fbcon and KMS/DRM drivers. The table
+ * is applied on top of the default mapping, a NULL table restores it.
+ *
+ * @return 0, or -1 if the video driver can't remap keys.
+ */
+extern DECLSPEC int SDLCALL SDL_SetKeyRemap(const SDL_KeyRemap *table, int count);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
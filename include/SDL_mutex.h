@@ -68,6 +68,15 @@ typedef struct SDL_mutex SDL_mutex;
 /** Create a mutex, initialized unlocked */
 extern DECLSPEC SDL_mutex *SDLCALL SDL_CreateMutex(void);
 
+/** Create a non-recursive mutex, initialized unlocked.
+ *
+ *  It is locked and unlocked with SDL_mutexP() and SDL_mutexV() like any
+ *  other mutex, but locking it twice from the same thread deadlocks. In
+ *  exchange it skips the recursion bookkeeping, which is noticeably
+ *  cheaper on ARM glibc and uClibc.
+ */
+extern DECLSPEC SDL_mutex *SDLCALL SDL_CreateFastMutex(void);
+
 #define SDL_LockMutex(m)    SDL_mutexP(m)
 
 /** Lock the mutex
@@ -90,6 +99,53 @@ extern DECLSPEC void SDLCALL SDL_DestroyMutex(SDL_mutex *mutex);
 
 /*@}*/
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/** @name Read/write lock functions                              */ /*@{*/
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/** The SDL read/write lock structure, defined in SDL_sysrwlock.c
+ *
+ *  Any number of readers may hold the lock at the same time, a writer
+ *  holds it alone. Neither kind of lock is recursive.
+ */
+struct SDL_rwlock;
+typedef struct SDL_rwlock SDL_rwlock;
+
+/** Create a read/write lock, initialized unlocked */
+extern DECLSPEC SDL_rwlock *SDLCALL SDL_CreateRWLock(void);
+
+/** Lock for shared (read-only) access
+ *  @return 0, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_LockRWLockForReading(SDL_rwlock *rwlock);
+
+/** Lock for exclusive (read/write) access
+ *  @return 0, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_LockRWLockForWriting(SDL_rwlock *rwlock);
+
+/** Non-blocking variant of SDL_LockRWLockForReading().
+ *  @return 0 if the lock was taken,
+ *  SDL_MUTEX_TIMEDOUT if it would block, and -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_TryLockRWLockForReading(SDL_rwlock *rwlock);
+
+/** Non-blocking variant of SDL_LockRWLockForWriting().
+ *  @return 0 if the lock was taken,
+ *  SDL_MUTEX_TIMEDOUT if it would block, and -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_TryLockRWLockForWriting(SDL_rwlock *rwlock);
+
+/** Release a read or write lock held by the current thread
+ *  @return 0, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_UnlockRWLock(SDL_rwlock *rwlock);
+
+/** Destroy a read/write lock */
+extern DECLSPEC void SDLCALL SDL_DestroyRWLock(SDL_rwlock *rwlock);
+
+/*@}*/
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /** @name Semaphore functions                                    */ /*@{*/
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
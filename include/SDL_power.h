@@ -72,6 +72,11 @@ typedef enum {
  *             can't determine a value, or we're not running on a battery.
  *
  * @return The state of the battery (if any).
+ *
+ * @note The answer comes from a snapshot that a background thread refreshes,
+ *       so this is cheap enough to call every frame. The snapshot is at most
+ *       SDL_POWER_MAXAGE milliseconds old (5000 by default), setting it to 0
+ *       queries the system on every call.
  ******************************************************************************/
 extern DECLSPEC SDL_PowerState SDLCALL SDL_GetPowerInfo(int *secs, int *pct);
 /*!@}*/
@@ -46,6 +46,16 @@
 extern "C" {
 #endif
 
+/** @name RWops types, as found in SDL_RWops::type */
+/*@{*/
+#define SDL_RWOPS_UNKNOWN   0U  /**< Unknown stream type */
+#define SDL_RWOPS_STDFILE   2U  /**< Stdio file */
+#define SDL_RWOPS_MEMORY    4U  /**< Memory stream */
+#define SDL_RWOPS_MEMORY_RO 5U  /**< Read-only memory stream */
+#define SDL_RWOPS_MAPPED    6U  /**< Read-only memory-mapped file */
+#define SDL_RWOPS_FDFILE    7U  /**< Read-only file descriptor with read-ahead */
+/*@}*/
+
 /** This is the read/write operation structure -- very basic */
 
 typedef struct SDL_RWops {
@@ -94,6 +104,11 @@ typedef struct SDL_RWops {
 			Uint8 *here;
 			Uint8 *stop;
 		} mem;
+		struct {
+			void *file;
+			Uint8 *here;
+			Uint8 *stop;
+		} fdio;
 		struct {
 			void *data1;
 		} unknown;
@@ -105,6 +120,11 @@ typedef struct SDL_RWops {
 /** @name Functions to create SDL_RWops structures from various data sources */
 /*@{*/
 
+/** Opens a file with a stdio mode string.
+ *  With SDL_RWOPS_FD=1 in the environment, read-only modes ("r", "rb")
+ *  return an SDL_RWOPS_FDFILE RWops with a read-ahead buffer rather than an
+ *  SDL_RWOPS_STDFILE one, and there is no hidden.stdio.fp to look at.
+ */
 extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromFile(const char *file, const char *mode);
 
 #ifdef HAVE_STDIO_H
@@ -115,6 +135,37 @@ extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMem(void *mem, int size);
 
 extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromConstMem(const void *mem, int size);
 
+/** @name Access hints for SDL_RWFromMappedFile() */
+/*@{*/
+#define SDL_RWMAP_SEQUENTIAL   0x01  /**< Will be read front to back */
+#define SDL_RWMAP_WILLNEED     0x02  /**< Start reading it in right away */
+/*@}*/
+
+/** Maps a whole file read-only, reads and seeks never touch the file again.
+ *  'flags' is a mask of SDL_RWMAP_* hints. Fails on systems without mmap().
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMappedFile(const char *file, int flags);
+
+/** Returns the start of the data behind a memory or mapped RWops and stores
+ *  its length in 'size', so loaders can parse it in place. Returns NULL for
+ *  any other kind of RWops. The memory belongs to the RWops.
+ */
+extern DECLSPEC const void *SDLCALL SDL_RWGetMemory(SDL_RWops *context, int *size);
+
+/** A read-only pack of files made by test/packassets, mapped once */
+typedef struct SDL_Archive SDL_Archive;
+
+/** Opens an archive and checks its table of contents, NULL on error */
+extern DECLSPEC SDL_Archive *SDLCALL SDL_OpenArchive(const char *file);
+
+/** Returns a read-only RWops on the file called 'name' in the archive.
+ *  Stored files are read in place, compressed ones are unpacked to memory.
+ *  Close it before closing the archive.
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromArchive(SDL_Archive *archive, const char *name);
+
+extern DECLSPEC void SDLCALL SDL_CloseArchive(SDL_Archive *archive);
+
 extern DECLSPEC SDL_RWops *SDLCALL SDL_AllocRW(void);
 
 extern DECLSPEC void SDLCALL SDL_FreeRW(SDL_RWops *area);
@@ -135,8 +186,18 @@ extern DECLSPEC void SDLCALL SDL_FreeRW(SDL_RWops *area);
 #define SDL_RWread(ctx, ptr, size, n)    (ctx)->read(ctx, ptr, size, n)
 #define SDL_RWwrite(ctx, ptr, size, n)    (ctx)->write(ctx, ptr, size, n)
 #define SDL_RWclose(ctx)        (ctx)->close(ctx)
+#define SDL_RWtell64(ctx)        SDL_RWseek64(ctx, 0, RW_SEEK_CUR)
 /*@}*/
 
+/** Seeks like SDL_RWseek() but with 64-bit offsets, for files past 2 GiB.
+ *  RWops made outside SDL only reach what their own seek can.
+ *  Returns the final offset, or -1 on error.
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_RWseek64(SDL_RWops *context, Sint64 offset, int whence);
+
+/** Returns the size of the data source in bytes, or -1 if it isn't known */
+extern DECLSPEC Sint64 SDLCALL SDL_RWsize(SDL_RWops *context);
+
 /** @name Read an item of the specified endianness and return in native format */
 /*@{*/
 extern DECLSPEC Uint16 SDLCALL SDL_ReadLE16(SDL_RWops *src);
@@ -320,6 +320,23 @@ extern DECLSPEC void SDLCALL SDL_free(void *mem);
 
 #endif
 
+/** Heap usage, as reported by SDL_GetMemoryStats() */
+typedef struct SDL_MemoryStats {
+	size_t footprint;       /**< Bytes currently obtained from the system */
+	size_t peak_footprint;  /**< Highest footprint so far */
+	size_t in_use;          /**< Bytes in allocated blocks */
+	int allocations;        /**< Blocks currently allocated */
+	int arenas;             /**< Heaps the allocations are spread over */
+} SDL_MemoryStats;
+
+/**
+ * Fill in heap usage for SDL_malloc().  With the C library allocator
+ * only what it reports is filled in and the rest is left at zero.
+ *
+ * @return 0 on success, or -1 if the allocator can't report usage
+ */
+extern DECLSPEC int SDLCALL SDL_GetMemoryStats(SDL_MemoryStats *stats);
+
 #ifdef HAVE_ALLOCA
 #define SDL_stack_alloc(type, count) (type*)alloca(sizeof(type)*(count))
 #define SDL_stack_free(data)
@@ -352,6 +369,30 @@ extern DECLSPEC void SDLCALL SDL_qsort(void *base, size_t nmemb, size_t size, in
 
 #endif
 
+/** A sort key and the value it carries, such as an index into a sprite list */
+typedef struct SDL_SortKey {
+	Uint32 key;
+	Uint32 value;
+} SDL_SortKey;
+
+/**
+ * Stable radix sort of keys into ascending order, without a comparator.
+ * Flip the sign bit of signed keys (key ^ 0x80000000) so they order right.
+ *
+ * @param scratch Space for count keys, or NULL to allocate it per call
+ * @return 0 on success, or -1 if scratch space couldn't be allocated
+ */
+extern DECLSPEC int SDLCALL SDL_RadixSort(SDL_SortKey *keys, SDL_SortKey *scratch, size_t count);
+
+/**
+ * Stable merge sort with the same arguments as SDL_qsort().  Input that
+ * is already nearly in order is merged with few comparisons.
+ *
+ * @param scratch Space for nmemb elements, or NULL to allocate it per call
+ * @return 0 on success, or -1 if scratch space couldn't be allocated
+ */
+extern DECLSPEC int SDLCALL SDL_MergeSort(void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *), void *scratch);
+
 #ifdef HAVE_ABS
 #define SDL_abs        abs
 #else
@@ -394,23 +435,8 @@ extern DECLSPEC void *SDLCALL SDL_memset(void *dst, int c, size_t len);
 
 #endif
 
-#ifndef SDL_memset4
-#define SDL_memset4(dst, val, len)               \
-do {                                             \
-    unsigned _count = (len);                     \
-    unsigned _n = (_count + 3) / 4;              \
-    Uint32 *_p = SDL_static_cast(Uint32 *, dst); \
-    Uint32 _val = (val);                         \
-    if (len == 0) break;                         \
-        switch (_count % 4) {                    \
-        case 0: do {    *_p++ = _val;            \
-        case 3:         *_p++ = _val;            \
-        case 2:         *_p++ = _val;            \
-        case 1:         *_p++ = _val;            \
-        } while ( --_n );                        \
-    }                                            \
-} while(0)
-#endif
+/** Fill 'dwords' 32-bit words at dst with val, for pixel fills */
+extern DECLSPEC void SDLCALL SDL_memset4(void *dst, Uint32 val, size_t dwords);
 
 /* We can count on memcpy existing on Mac OS X and being well-tuned. */
 #ifndef SDL_memcpy
@@ -783,6 +809,23 @@ extern DECLSPEC char *SDLCALL SDL_iconv_string(const char *tocode, const char *f
 #define SDL_iconv_utf8_ucs2(S)        (Uint16 *)SDL_iconv_string("UCS-2", "UTF-8", S, SDL_strlen(S)+1)
 #define SDL_iconv_utf8_ucs4(S)        (Uint32 *)SDL_iconv_string("UCS-4", "UTF-8", S, SDL_strlen(S)+1)
 
+/**
+ * @name Bulk Unicode Conversion
+ * Convert whole buffers between UTF-8 and native UTF-16, UCS-4 or Latin-1.
+ * Lengths count units of the buffer's type and nothing is terminated.  At
+ * most dstlen units are written, dst may be NULL to measure, and the
+ * length of the full conversion is returned like snprintf() does.
+ * Invalid input becomes U+FFFD, or '?' where Latin-1 has no character.
+ */
+/*@{*/
+extern DECLSPEC size_t SDLCALL SDL_UTF8ToUTF16(const char *src, size_t srclen, Uint16 *dst, size_t dstlen);
+extern DECLSPEC size_t SDLCALL SDL_UTF16ToUTF8(const Uint16 *src, size_t srclen, char *dst, size_t dstlen);
+extern DECLSPEC size_t SDLCALL SDL_UTF8ToUCS4(const char *src, size_t srclen, Uint32 *dst, size_t dstlen);
+extern DECLSPEC size_t SDLCALL SDL_UCS4ToUTF8(const Uint32 *src, size_t srclen, char *dst, size_t dstlen);
+extern DECLSPEC size_t SDLCALL SDL_UTF8ToLatin1(const char *src, size_t srclen, char *dst, size_t dstlen);
+extern DECLSPEC size_t SDLCALL SDL_Latin1ToUTF8(const char *src, size_t srclen, char *dst, size_t dstlen);
+/*@}*/
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
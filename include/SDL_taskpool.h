@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+
+/** @file SDL_taskpool.h
+ *  A fixed-size pool of worker threads for short tasks
+ *
+ *  Every worker keeps its own deque of tasks. Tasks submitted from inside a
+ *  task go to the current worker's deque, others are spread round-robin,
+ *  and an idle worker steals from the others. A thread waiting on tasks
+ *  runs queued tasks itself instead of sleeping.
+ */
+#ifndef SDL_taskpool_h_
+#define SDL_taskpool_h_
+
+#include "SDL_stdinc.h"
+#include "SDL_error.h"
+#include "SDL_atomic.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The SDL task pool structure, defined in SDL_taskpool.c */
+struct SDL_TaskPool;
+typedef struct SDL_TaskPool SDL_TaskPool;
+
+/** A task, called once with the data pointer given to SDL_TaskSubmit() */
+typedef void (SDLCALL *SDL_TaskFunction)(void *data);
+
+/** A parallel-for body, called for the half-open range [start, end) */
+typedef void (SDLCALL *SDL_ParallelForFunction)(int start, int end, void *data);
+
+/** Create a task pool.
+ *  @param num_workers The number of worker threads, or 0 to use one less
+ *  than SDL_GetCPUCount() (at least one), since the thread waiting on the
+ *  tasks helps run them.
+ *  @return The new pool, or NULL on error.
+ *
+ *  If threads are not available the pool runs every task inline as it is
+ *  submitted.
+ */
+extern DECLSPEC SDL_TaskPool *SDLCALL SDL_TaskPoolCreate(int num_workers);
+
+/** Wait for every submitted task, stop the workers and free the pool */
+extern DECLSPEC void SDLCALL SDL_TaskPoolDestroy(SDL_TaskPool *pool);
+
+/** Get the number of worker threads in the pool */
+extern DECLSPEC int SDLCALL SDL_TaskPoolWorkers(SDL_TaskPool *pool);
+
+/** Queue a task on the pool.
+ *  @param pending If not NULL, incremented now and decremented once the
+ *  task has run, so a group of tasks can be waited on with SDL_TaskWait().
+ *  @return 0, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_TaskSubmit(SDL_TaskPool *pool, SDL_TaskFunction func, void *data, SDL_atomic_t *pending);
+
+/** Wait until the pending counter reaches zero, or until every task
+ *  submitted to the pool has run if pending is NULL. The calling thread
+ *  runs queued tasks while it waits, so tasks may wait on other tasks.
+ */
+extern DECLSPEC void SDLCALL SDL_TaskWait(SDL_TaskPool *pool, SDL_atomic_t *pending);
+
+/** Run func over [start, end) split into chunks of at most grain items,
+ *  and wait for all of them. A grain of 0 picks a size that gives every
+ *  thread a few chunks to balance the load. If pool is NULL the whole
+ *  range runs on the calling thread.
+ *  @return 0, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_TaskParallelFor(SDL_TaskPool *pool, int start, int end, int grain, SDL_ParallelForFunction func, void *data);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+
+#include "close_code.h"
+
+#endif /* SDL_taskpool_h_ */
@@ -125,6 +125,29 @@ extern DECLSPEC void SDLCALL SDL_WaitThread(SDL_Thread *thread, int *status);
 /** Forcefully kill a thread without worrying about its state */
 extern DECLSPEC void SDLCALL SDL_KillThread(SDL_Thread *thread);
 
+/** Thread local storage ID, 0 is the invalid ID */
+typedef unsigned int SDL_TLSID;
+
+/** Create an identifier that is globally visible to all threads but
+ *  refers to data that is thread-specific.
+ *  @return The newly created thread local storage identifier, or 0 on error
+ */
+extern DECLSPEC SDL_TLSID SDLCALL SDL_TLSCreate(void);
+
+/** Get the value associated with a thread local storage ID for the
+ *  current thread.
+ *  @return The value, or NULL if no value has been set
+ */
+extern DECLSPEC void *SDLCALL SDL_TLSGet(SDL_TLSID id);
+
+/** Set the value associated with a thread local storage ID for the
+ *  current thread.
+ *  The destructor, if not NULL, is called with the value when the thread
+ *  exits.
+ *  @return 0 on success, -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_TLSSet(SDL_TLSID id, const void *value, void (SDLCALL *destructor)(void *));
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -66,6 +66,16 @@ extern DECLSPEC Uint32 SDLCALL SDL_GetTicks(void);
 /** Wait a specified number of milliseconds before returning */
 extern DECLSPEC void SDLCALL SDL_Delay(Uint32 ms);
 
+/**
+ * Get the current value of the high resolution counter.
+ * The counter is monotonic and counts SDL_GetPerformanceFrequency() ticks
+ * per second; only differences between two values are meaningful.
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_GetPerformanceCounter(void);
+
+/** Get the count per second of the high resolution counter */
+extern DECLSPEC Uint64 SDLCALL SDL_GetPerformanceFrequency(void);
+
 /** Function prototype for the timer callback function */
 typedef Uint32 (SDLCALL *SDL_TimerCallback)(Uint32 interval);
 
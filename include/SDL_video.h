@@ -427,6 +427,62 @@ extern DECLSPEC void SDLCALL SDL_UpdateRect(SDL_Surface *screen, Sint32 x, Sint3
  */
 extern DECLSPEC int SDLCALL SDL_Flip(SDL_Surface *screen);
 
+/** @name Frame Pacing
+ *  Present frames at a steady cadence locked to the display refresh.
+ *
+ *  SDL_PacedFlip() sleeps until the next presentation deadline and then
+ *  calls SDL_Flip(). Deadlines advance by a whole number of refresh periods
+ *  from an ideal schedule rather than from the time of the last flip, so
+ *  scheduling jitter never accumulates; the average presentation lateness
+ *  is fed back into the wakeup time. Frames that overrun their slot are
+ *  counted as missed and the schedule skips ahead instead of bursting.
+ */
+/*@{*/
+
+/** Frame pacing statistics, see SDL_GetFrameStats() */
+typedef struct SDL_FrameStats {
+	Uint32 refresh_period; /**< Duration of one display refresh, in microseconds */
+	Uint32 interval;       /**< Display refreshes per presented frame */
+	Uint32 frames;         /**< Frames presented since the last reset */
+	Uint32 missed;         /**< Display refreshes missed since the last reset */
+	Sint32 drift;          /**< Average presentation lateness, in microseconds */
+	Uint32 last_frame;     /**< Duration of the last frame, in microseconds */
+	Uint32 worst_frame;    /**< Longest frame since the last reset, in microseconds */
+} SDL_FrameStats;
+
+/**
+ * Get the duration of one display refresh of the current video mode, in
+ * microseconds, as reported by the video driver.
+ * Returns 0 if the driver can't tell. The dummy driver reports a synthetic
+ * period set with the SDL_VIDEO_REFRESHRATE environment variable.
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetRefreshPeriod(void);
+
+/**
+ * Set how many display refreshes each frame presented by SDL_PacedFlip()
+ * should last, e.g. 2 to run at 30 fps on a 60 Hz display.
+ * This function returns 0 if successful, or -1 if there was an error.
+ */
+extern DECLSPEC int SDLCALL SDL_SetFrameInterval(int interval);
+
+/**
+ * Wait for the next presentation deadline and then call SDL_Flip().
+ * If the driver does not report a refresh period, 60 Hz is assumed.
+ * This function returns the value returned by SDL_Flip().
+ */
+extern DECLSPEC int SDLCALL SDL_PacedFlip(SDL_Surface *screen);
+
+/** Fill 'stats' with the frame pacing statistics */
+extern DECLSPEC void SDLCALL SDL_GetFrameStats(SDL_FrameStats *stats);
+
+/**
+ * Clear the frame pacing statistics and restart the presentation schedule.
+ * This is done automatically by SDL_SetVideoMode().
+ */
+extern DECLSPEC void SDLCALL SDL_ResetFrameStats(void);
+
+/*@}*/
+
 /**
  * Set the gamma correction for each of the color channels.
  * The gamma values range (approximately) between 0.1 and 10.0
@@ -594,6 +650,15 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP_RW(SDL_RWops *src, int freesrc)
 /** Convenience macro -- load a surface from a file */
 #define SDL_LoadBMP(file)    SDL_LoadBMP_RW(SDL_RWFromFile(file, "rb"), 1)
 
+/**
+ * Like SDL_LoadBMP_RW(), but when 'src' is a memory or mapped RWops and the
+ * image is an uncompressed top-down BMP with aligned rows, the surface uses
+ * the pixels where they are instead of copying them (SDL_PREALLOC is set).
+ * Such a surface is read-only and 'src' must stay open until it is freed.
+ * Anything else is loaded as usual. The source is never closed.
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP_InPlace(SDL_RWops *src);
+
 /**
  * Save a surface to a seekable SDL data source (memory or file.)
  * If 'freedst' is non-zero, the source will be closed after being written.
@@ -62,6 +62,14 @@ extern int SDL_CDROMInit(void);
 extern void SDL_CDROMQuit(void);
 
 #endif
+#ifndef SDL_POWER_DISABLED
+
+extern void SDL_PowerQuit(void);
+
+#endif
+
+extern void SDL_AsyncIOQuit(void);
+
 #if !SDL_TIMERS_DISABLED
 
 extern void SDL_StartTicks(void);
@@ -252,7 +260,11 @@ void SDL_Quit(void) {
 #ifdef DEBUG_BUILD
 	printf("[SDL_Quit] : Enter! Calling QuitSubSystem()\n"); fflush(stdout);
 #endif
+	SDL_AsyncIOQuit();
 	SDL_QuitSubSystem(SDL_INIT_EVERYTHING);
+#ifndef SDL_POWER_DISABLED
+	SDL_PowerQuit();
+#endif
 
 #ifdef CHECK_LEAKS
 #ifdef DEBUG_BUILD
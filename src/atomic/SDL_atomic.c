@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* Atomic integer and pointer operations */
+
+#include "SDL_atomic.h"
+#include "SDL_atomic_c.h"
+
+#if !SDL_ATOMIC_BUILTINS && !SDL_ATOMIC_SYNC
+/* Without compiler support every operation is serialized through a small
+   table of spinlocks, picked by address so unrelated variables rarely
+   contend.
+*/
+static SDL_SpinLock locks[32];
+
+static SDL_SpinLock *enterLock(void *a) {
+	SDL_SpinLock *lock = &locks[(((size_t) a) >> 3) & 0x1f];
+
+	SDL_AtomicLock(lock);
+	return lock;
+}
+
+#define leaveLock(lock)    SDL_AtomicUnlock(lock)
+#endif
+
+SDL_bool SDL_AtomicCAS(SDL_atomic_t *a, int oldval, int newval) {
+#if SDL_ATOMIC_BUILTINS
+	return __atomic_compare_exchange_n(&a->value, &oldval, newval, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? SDL_TRUE : SDL_FALSE;
+#elif SDL_ATOMIC_SYNC
+	return __sync_bool_compare_and_swap(&a->value, oldval, newval) ? SDL_TRUE : SDL_FALSE;
+#else
+	SDL_bool retval = SDL_FALSE;
+	SDL_SpinLock *lock = enterLock(a);
+
+	if(a->value == oldval) {
+		a->value = newval;
+		retval = SDL_TRUE;
+	}
+	leaveLock(lock);
+	return retval;
+#endif
+}
+
+int SDL_AtomicSet(SDL_atomic_t *a, int v) {
+#if SDL_ATOMIC_BUILTINS
+	return __atomic_exchange_n(&a->value, v, __ATOMIC_SEQ_CST);
+#else
+	int value;
+
+	do {
+		value = a->value;
+	} while (!SDL_AtomicCAS(a, value, v));
+	return value;
+#endif
+}
+
+int SDL_AtomicGet(SDL_atomic_t *a) {
+#if SDL_ATOMIC_BUILTINS
+	return __atomic_load_n(&a->value, __ATOMIC_SEQ_CST);
+#elif SDL_ATOMIC_SYNC
+	return __sync_or_and_fetch(&a->value, 0);
+#else
+	int value;
+
+	do {
+		value = a->value;
+	} while (!SDL_AtomicCAS(a, value, value));
+	return value;
+#endif
+}
+
+int SDL_AtomicAdd(SDL_atomic_t *a, int v) {
+#if SDL_ATOMIC_BUILTINS
+	return __atomic_fetch_add(&a->value, v, __ATOMIC_SEQ_CST);
+#elif SDL_ATOMIC_SYNC
+	return __sync_fetch_and_add(&a->value, v);
+#else
+	int value;
+
+	do {
+		value = a->value;
+	} while (!SDL_AtomicCAS(a, value, value + v));
+	return value;
+#endif
+}
+
+SDL_bool SDL_AtomicCASPtr(void **a, void *oldval, void *newval) {
+#if SDL_ATOMIC_BUILTINS
+	return __atomic_compare_exchange_n(a, &oldval, newval, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? SDL_TRUE : SDL_FALSE;
+#elif SDL_ATOMIC_SYNC
+	return __sync_bool_compare_and_swap(a, oldval, newval) ? SDL_TRUE : SDL_FALSE;
+#else
+	SDL_bool retval = SDL_FALSE;
+	SDL_SpinLock *lock = enterLock(a);
+
+	if(*a == oldval) {
+		*a = newval;
+		retval = SDL_TRUE;
+	}
+	leaveLock(lock);
+	return retval;
+#endif
+}
+
+void *SDL_AtomicSetPtr(void **a, void *v) {
+#if SDL_ATOMIC_BUILTINS
+	return __atomic_exchange_n(a, v, __ATOMIC_SEQ_CST);
+#else
+	void *value;
+
+	do {
+		value = *a;
+	} while (!SDL_AtomicCASPtr(a, value, v));
+	return value;
+#endif
+}
+
+void *SDL_AtomicGetPtr(void **a) {
+#if SDL_ATOMIC_BUILTINS
+	return __atomic_load_n(a, __ATOMIC_SEQ_CST);
+#elif SDL_ATOMIC_SYNC
+	return __sync_val_compare_and_swap(a, (void *) 0, (void *) 0);
+#else
+	void *value;
+
+	do {
+		value = *a;
+	} while (!SDL_AtomicCASPtr(a, value, value));
+	return value;
+#endif
+}
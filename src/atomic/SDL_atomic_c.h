@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+#ifndef SDL_atomic_c_h_
+#define SDL_atomic_c_h_
+
+/* Pick the best primitive the compiler gives us.
+   GCC 4.7+ and clang have the __atomic builtins, which know how to emit
+   ldrex/strex on ARMv6/v7, ldaxr/stlxr (or LSE) on ARMv8 and lock-prefixed
+   instructions on x86. GCC 4.1+ has the older __sync builtins, which are
+   full barriers on every call. Anything else falls back to inline assembly.
+*/
+#if defined(__GNUC__) && defined(__GCC_ATOMIC_INT_LOCK_FREE)
+#define SDL_ATOMIC_BUILTINS 1
+#elif defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+#define SDL_ATOMIC_SYNC 1
+#endif
+
+/* Hint to the CPU that we are busy-waiting */
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define SDL_CPUPause()    __asm__ __volatile__ ("pause" : : : "memory")
+#elif defined(__GNUC__) && (defined(__aarch64__) || \
+      (defined(__arm__) && (defined(__ARM_ARCH_6K__) || defined(__ARM_ARCH_6ZK__) || \
+       defined(__ARM_ARCH_6T2__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7))))
+#define SDL_CPUPause()    __asm__ __volatile__ ("yield" : : : "memory")
+#elif defined(__GNUC__)
+#define SDL_CPUPause()    __asm__ __volatile__ ("" : : : "memory")
+#else
+#define SDL_CPUPause()
+#endif
+
+#endif /* SDL_atomic_c_h_ */
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* Spinlocks built on the atomic test-and-set of the platform */
+
+#include "SDL_atomic.h"
+#include "SDL_timer.h"
+#include "SDL_atomic_c.h"
+
+/* How many times to spin on a held lock before yielding the CPU */
+#define SPINLOCK_SPINS    128
+
+SDL_bool SDL_AtomicTryLock(SDL_SpinLock *lock) {
+#if SDL_ATOMIC_BUILTINS
+	return (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) == 0) ? SDL_TRUE : SDL_FALSE;
+#elif SDL_ATOMIC_SYNC
+	return (__sync_lock_test_and_set(lock, 1) == 0) ? SDL_TRUE : SDL_FALSE;
+#elif defined(__GNUC__) && defined(__arm__)
+	/* ARMv5 and older: swp is atomic on a uniprocessor */
+	int result;
+	__asm__ __volatile__ ("swp %0, %1, [%2]" : "=&r"(result) : "r"(1), "r"(lock) : "memory");
+	return (result == 0) ? SDL_TRUE : SDL_FALSE;
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	int result = 1;
+	__asm__ __volatile__ ("xchgl %0, (%1)" : "+r"(result) : "r"(lock) : "memory");
+	return (result == 0) ? SDL_TRUE : SDL_FALSE;
+#elif SDL_THREADS_DISABLED
+	if(*lock) {
+		return SDL_FALSE;
+	}
+	*lock = 1;
+	return SDL_TRUE;
+#else
+#error Need an atomic test-and-set for this platform
+#endif
+}
+
+void SDL_AtomicLock(SDL_SpinLock *lock) {
+	int spins = 0;
+
+	while (!SDL_AtomicTryLock(lock)) {
+		/* Wait on a plain load until the lock looks free, so we don't
+		   bounce the cache line between cores with failed exchanges */
+		while (*(volatile SDL_SpinLock *) lock) {
+			if(spins < SPINLOCK_SPINS) {
+				++spins;
+				SDL_CPUPause();
+			} else {
+				SDL_Delay(0);
+			}
+		}
+	}
+}
+
+void SDL_AtomicUnlock(SDL_SpinLock *lock) {
+#if SDL_ATOMIC_BUILTINS
+	__atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+#elif SDL_ATOMIC_SYNC
+	__sync_lock_release(lock);
+#else
+	SDL_MemoryBarrierRelease();
+	*(volatile SDL_SpinLock *) lock = 0;
+#endif
+}
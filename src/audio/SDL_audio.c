@@ -156,18 +156,36 @@ int SDLCALL SDL_RunAudio(void *audiop) {
 	return (0);
 }
 
+/* The mixer lock is a fast mutex so the audio thread pays the minimum for
+   it on every buffer. Applications are allowed to nest SDL_LockAudio(),
+   so the recursion is counted here instead of inside the mutex.
+*/
 static void SDL_LockAudio_Default(SDL_AudioDevice *audio) {
-	if(audio->thread && (SDL_ThreadID() == audio->threadid)) {
+	Uint32 this_thread = SDL_ThreadID();
+
+	if(audio->thread && (this_thread == audio->threadid)) {
+		return;
+	}
+	if(audio->lock_depth && (audio->lock_owner == this_thread)) {
+		++audio->lock_depth;
 		return;
 	}
 	SDL_mutexP(audio->mixer_lock);
+	audio->lock_owner = this_thread;
+	audio->lock_depth = 1;
 }
 
 static void SDL_UnlockAudio_Default(SDL_AudioDevice *audio) {
 	if(audio->thread && (SDL_ThreadID() == audio->threadid)) {
 		return;
 	}
-	SDL_mutexV(audio->mixer_lock);
+	if(audio->lock_depth == 0) {
+		return;
+	}
+	if(--audio->lock_depth == 0) {
+		audio->lock_owner = 0;
+		SDL_mutexV(audio->mixer_lock);
+	}
 }
 
 static Uint16 SDL_ParseAudioFormat(const char *string) {
@@ -96,8 +96,10 @@ struct SDL_AudioDevice {
 	/* Fake audio buffer for when the audio hardware is busy */
 	Uint8 *fake_stream;
 
-	/* A semaphore for locking the mixing buffers */
+	/* A non-recursive mutex for locking the mixing buffers */
 	SDL_mutex *mixer_lock;
+	Uint32 lock_owner;      /* Application thread holding mixer_lock */
+	int lock_depth;         /* Nested SDL_LockAudio() calls by lock_owner */
 
 	/* A thread to feed the audio device */
 	SDL_Thread *thread;
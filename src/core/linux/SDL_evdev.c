@@ -0,0 +1,636 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+#include "SDL_evdev.h"
+
+#ifdef SDL_USE_EVDEV
+
+/* Keyboard and mouse input straight from the kernel's event devices */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "SDL_keysym.h"
+#include "../../events/SDL_sysevents.h"
+#include "../../timer/SDL_timer_c.h"
+
+/* Older headers only have the timeval member */
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
+/* How many input events are read from a device at once, can be changed
+   with SDL_EVDEV_READ_BATCH */
+#define DEFAULT_READ_BATCH    64
+#define MAX_READ_BATCH        256
+
+static int read_batch = DEFAULT_READ_BATCH;
+
+#ifndef KEY_CNT
+#define KEY_CNT    (KEY_MAX + 1)
+#endif
+
+/* Set in an evdev_keymap entry for codes reported as a mouse button */
+#define EVDEV_MOUSE_BUTTON    0x8000
+
+/* What each key and button code is reported as, worked out once from the
+   default keymap, SDL_EVDEV_KEYMAP and SDL_SetKeyRemap() */
+static Uint16 evdev_keymap[KEY_CNT];
+static SDL_bool evdev_keymap_ready = SDL_FALSE;
+
+/* Devices kept by SDL_EVDEV_Init() */
+static SDL_evdevice *evdev_devices = NULL;
+static int evdev_classes = 0;
+static SDL_EVDEV_KeyHook evdev_hook = NULL;
+static void *evdev_userdata = NULL;
+static int evdev_ref_count = 0;
+
+/* Every managed device plus the udev monitor, so a pump only touches the
+   devices that have something to read */
+#define EVDEV_MAX_READY    32
+
+static int evdev_epoll = -1;
+static int evdev_udev_fd = -1;
+
+static const SDLKey keymap[] = {
+	[KEY_ESC] = SDLK_ESCAPE,
+	[KEY_1] = SDLK_1,
+	[KEY_2] = SDLK_2,
+	[KEY_3] = SDLK_3,
+	[KEY_4] = SDLK_4,
+	[KEY_5] = SDLK_5,
+	[KEY_6] = SDLK_6,
+	[KEY_7] = SDLK_7,
+	[KEY_8] = SDLK_8,
+	[KEY_9] = SDLK_9,
+	[KEY_0] = SDLK_0,
+	[KEY_MINUS] = SDLK_MINUS,
+
+	[KEY_EQUAL] = SDLK_EQUALS,
+	[KEY_BACKSPACE] = SDLK_BACKSPACE,
+	[KEY_TAB] = SDLK_TAB,
+	[KEY_Q] = SDLK_q,
+	[KEY_W] = SDLK_w,
+	[KEY_E] = SDLK_e,
+	[KEY_R] = SDLK_r,
+	[KEY_T] = SDLK_t,
+	[KEY_Y] = SDLK_y,
+	[KEY_U] = SDLK_u,
+	[KEY_I] = SDLK_i,
+	[KEY_O] = SDLK_o,
+	[KEY_P] = SDLK_p,
+	[KEY_LEFTBRACE] = SDLK_LEFTBRACKET,
+	[KEY_RIGHTBRACE] = SDLK_RIGHTBRACKET,
+	[KEY_ENTER] = SDLK_RETURN,
+	[KEY_LEFTCTRL] = SDLK_LCTRL,
+	[KEY_A] = SDLK_a,
+	[KEY_S] = SDLK_s,
+	[KEY_D] = SDLK_d,
+	[KEY_F] = SDLK_f,
+	[KEY_G] = SDLK_g,
+	[KEY_H] = SDLK_h,
+	[KEY_J] = SDLK_j,
+	[KEY_K] = SDLK_k,
+	[KEY_L] = SDLK_l,
+	[KEY_SEMICOLON] = SDLK_SEMICOLON,
+	[KEY_APOSTROPHE] = SDLK_QUOTE,
+	/* [KEY_GRAVE] = SDLK_GRAVE, ??? */
+	[KEY_LEFTSHIFT] = SDLK_LSHIFT,
+	[KEY_BACKSLASH] = SDLK_BACKSLASH,
+	[KEY_Z] = SDLK_z,
+	[KEY_X] = SDLK_x,
+	[KEY_C] = SDLK_c,
+	[KEY_V] = SDLK_v,
+	[KEY_B] = SDLK_b,
+	[KEY_N] = SDLK_n,
+	[KEY_M] = SDLK_m,
+	[KEY_COMMA] = SDLK_COMMA,
+	[KEY_DOT] = SDLK_PERIOD,
+	[KEY_SLASH] = SDLK_SLASH,
+	[KEY_RIGHTSHIFT] = SDLK_RSHIFT,
+	[KEY_KPASTERISK] = SDLK_KP_MULTIPLY,
+	[KEY_LEFTALT] = SDLK_LALT,
+	[KEY_SPACE] = SDLK_SPACE,
+	[KEY_CAPSLOCK] = SDLK_CAPSLOCK,
+	[KEY_F1] = SDLK_F1,
+	[KEY_F2] = SDLK_F2,
+	[KEY_F3] = SDLK_F3,
+	[KEY_F4] = SDLK_F4,
+	[KEY_F5] = SDLK_F5,
+	[KEY_F6] = SDLK_F6,
+	[KEY_F7] = SDLK_F7,
+	[KEY_F8] = SDLK_F8,
+	[KEY_F9] = SDLK_F9,
+	[KEY_F10] = SDLK_F10,
+	[KEY_NUMLOCK] = SDLK_NUMLOCK,
+	[KEY_SCROLLLOCK] = SDLK_SCROLLOCK,
+	[KEY_KP7] = SDLK_KP7,
+	[KEY_KP8] = SDLK_KP8,
+	[KEY_KP9] = SDLK_KP9,
+	[KEY_KPMINUS] = SDLK_KP_MINUS,
+	[KEY_KP4] = SDLK_KP4,
+	[KEY_KP5] = SDLK_KP5,
+	[KEY_KP6] = SDLK_KP6,
+	[KEY_KPPLUS] = SDLK_KP_PLUS,
+	[KEY_KP1] = SDLK_KP1,
+	[KEY_KP2] = SDLK_KP2,
+	[KEY_KP3] = SDLK_KP3,
+	[KEY_KP0] = SDLK_KP0,
+	[KEY_KPDOT] = SDLK_KP_PERIOD,
+
+	[KEY_F11] = SDLK_F11,
+	[KEY_F12] = SDLK_F12,
+	[KEY_KPENTER] = SDLK_KP_ENTER,
+	[KEY_RIGHTCTRL] = SDLK_RCTRL,
+	[KEY_KPSLASH] = SDLK_KP_DIVIDE,
+	[KEY_SYSRQ] = SDLK_SYSREQ,
+	[KEY_RIGHTALT] = SDLK_RALT,
+	/*[KEY_LINEFEED] = SDLK_LINEFEED, ??? */
+	[KEY_HOME] = SDLK_HOME,
+	[KEY_UP] = SDLK_UP,
+	[KEY_PAGEUP] = SDLK_PAGEUP,
+	[KEY_LEFT] = SDLK_LEFT,
+	[KEY_RIGHT] = SDLK_RIGHT,
+	[KEY_END] = SDLK_END,
+	[KEY_DOWN] = SDLK_DOWN,
+	[KEY_PAGEDOWN] = SDLK_PAGEDOWN,
+	[KEY_INSERT] = SDLK_INSERT,
+	[KEY_DELETE] = SDLK_DELETE,
+
+	[KEY_POWER] = SDLK_POWER,
+	[KEY_KPEQUAL] = SDLK_KP_EQUALS,
+	[KEY_PAUSE] = SDLK_PAUSE,
+
+	[KEY_LEFTMETA] = SDLK_LMETA,
+	[KEY_RIGHTMETA] = SDLK_RMETA,
+	[KEY_COMPOSE] = SDLK_COMPOSE,
+
+	[KEY_UNDO] = SDLK_UNDO,
+	[KEY_HELP] = SDLK_HELP,
+	[KEY_MENU] = SDLK_MENU,
+
+	[KEY_F13] = SDLK_F13,
+	[KEY_F14] = SDLK_F14,
+	[KEY_F15] = SDLK_F15,
+
+	[KEY_PRINT] = SDLK_PRINT,
+
+	[BTN_LEFT] = SDL_BUTTON_LEFT,
+	[BTN_RIGHT] = SDL_BUTTON_RIGHT,
+	[BTN_MIDDLE] = SDL_BUTTON_MIDDLE,
+};
+
+static void SDL_EVDEV_MapKey(int code, SDLKey sym, Uint8 button) {
+	if(code < 0 || code >= KEY_CNT) {
+		return;
+	}
+	if(button) {
+		evdev_keymap[code] = EVDEV_MOUSE_BUTTON | button;
+	} else {
+		evdev_keymap[code] = (Uint16) sym;
+	}
+}
+
+/* SDL_EVDEV_KEYMAP="code=sym,..." with an SDLKey value, or mN for mouse button N */
+static void SDL_EVDEV_EnvKeymap(void) {
+	const char *env = SDL_getenv("SDL_EVDEV_KEYMAP");
+	char *end;
+	long code, sym;
+	int button;
+
+	while (env && *env) {
+		code = SDL_strtol(env, &end, 0);
+		if(end == env || *end != '=') {
+			break;
+		}
+		env = end + 1;
+		button = (*env == 'm');
+		if(button) {
+			++env;
+		}
+		sym = SDL_strtol(env, &end, 0);
+		if(end == env) {
+			break;
+		}
+		/* Keys index the keystate arrays, so skip anything out of range */
+		if(button ? (sym > 0 && sym <= 0xFF) : (sym > 0 && sym < SDLK_LAST)) {
+			SDL_EVDEV_MapKey(code, button ? SDLK_UNKNOWN : (SDLKey) sym, button ? (Uint8) sym : 0);
+		}
+		env = end;
+		if(*env == ',') {
+			++env;
+		}
+	}
+}
+
+int SDL_EVDEV_SetKeymap(const SDL_KeyRemap *table, int count) {
+	unsigned int code;
+	int i;
+
+	for (i = 0; table && i < count; ++i) {
+		if(table[i].code >= KEY_CNT || (int) table[i].sym < 0 || table[i].sym >= SDLK_LAST) {
+			SDL_SetError("Can't remap code %d to %d", table[i].code, table[i].sym);
+			return (-1);
+		}
+	}
+
+	SDL_memset(evdev_keymap, 0, sizeof(evdev_keymap));
+	for (code = 0; code < SDL_arraysize(keymap); ++code) {
+		if(code >= BTN_LEFT && code <= BTN_TASK) {
+			SDL_EVDEV_MapKey(code, SDLK_UNKNOWN, (Uint8) keymap[code]);
+		} else {
+			SDL_EVDEV_MapKey(code, keymap[code], 0);
+		}
+	}
+	SDL_EVDEV_EnvKeymap();
+	for (i = 0; table && i < count; ++i) {
+		SDL_EVDEV_MapKey(table[i].code, table[i].sym, table[i].button);
+	}
+
+	evdev_keymap_ready = SDL_TRUE;
+	return (0);
+}
+
+SDL_evdevice *SDL_EVDEV_OpenDevice(const char *path) {
+	SDL_evdevice *dev;
+	int clock_id;
+
+	if(!evdev_keymap_ready) {
+		SDL_EVDEV_SetKeymap(NULL, 0);
+	}
+
+	dev = (SDL_evdevice *) SDL_calloc(1, sizeof(*dev));
+	if(dev == NULL) {
+		SDL_OutOfMemory();
+		return (NULL);
+	}
+
+	dev->fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+	if(dev->fd < 0) {
+		SDL_SetError("Could not open device '%s'", path);
+		SDL_free(dev);
+		return (NULL);
+	}
+
+	dev->path = SDL_strdup(path);
+	if(dev->path == NULL) {
+		close(dev->fd);
+		SDL_free(dev);
+		SDL_OutOfMemory();
+		return (NULL);
+	}
+
+	/* Have the kernel stamp events on the clock ticks are based on */
+	clock_id = CLOCK_MONOTONIC;
+	dev->monotonic = ioctl(dev->fd, EVIOCSCLOCKID, &clock_id) == 0;
+
+	SDL_AddInputCounter(&dev->rate, dev->path);
+	return (dev);
+}
+
+void SDL_EVDEV_CloseDevice(SDL_evdevice *dev) {
+	SDL_DelInputCounter(&dev->rate);
+	close(dev->fd);
+	SDL_free(dev->path);
+	SDL_free(dev);
+}
+
+void SDL_EVDEV_PumpDevice(SDL_evdevice *dev, SDL_EVDEV_KeyHook hook, void *userdata) {
+	struct input_event events[MAX_READ_BATCH];
+	ssize_t bytes_read;
+	SDL_keysym keysym;
+	unsigned int i, count;
+	int code, pressed, reports;
+	Uint16 entry;
+	int dx = 0, dy = 0;
+
+	for (;;) {
+		bytes_read = read(dev->fd, events, read_batch * sizeof(*events));
+		if(bytes_read < 0) {
+			if(errno != EAGAIN) {
+				SDL_SetError("Unable to read from %s", dev->path);
+			}
+			break;
+		}
+
+		count = bytes_read / sizeof(*events);
+		reports = 0;
+
+		for (i = 0; i < count; i++) {
+			if(dev->monotonic) {
+				SDL_SetEventTimestamp(SDL_MonotonicToTicks(events[i].input_event_sec, events[i].input_event_usec));
+			}
+
+			code = events[i].code;
+			if(events[i].type == EV_KEY) {
+				/* SDL does its own key repeat */
+				if(events[i].value == 2) {
+					continue;
+				}
+				if(hook && hook(userdata, code, events[i].value)) {
+					continue;
+				}
+
+				entry = (code < KEY_CNT) ? evdev_keymap[code] : 0;
+				if(entry == 0) {
+					continue;
+				}
+
+				pressed = events[i].value ? SDL_PRESSED : SDL_RELEASED;
+				if(entry & EVDEV_MOUSE_BUTTON) {
+					/* Mouse button event, after the motion leading up to it */
+					if(dx || dy) {
+						SDL_PrivateMouseMotion(0, SDL_TRUE, dx, dy);
+						dx = dy = 0;
+					}
+					SDL_PrivateMouseButton(pressed, (Uint8) entry, 0, 0);
+				} else {
+					/* Keyboard event */
+					keysym.scancode = (Uint8) code;
+					keysym.sym = (SDLKey) entry;
+					keysym.mod = KMOD_NONE;
+					keysym.unicode = 0;
+					SDL_PrivateKeyboard(pressed, &keysym);
+				}
+			} else if(events[i].type == EV_REL) {
+				switch (code) {
+					case REL_X:
+						dx += events[i].value;
+						break;
+					case REL_Y:
+						dy += events[i].value;
+						break;
+					case REL_WHEEL:
+						if(events[i].value < 0) {
+							SDL_PrivateMouseButton(SDL_PRESSED, SDL_BUTTON_WHEELDOWN, 0, 0);
+							SDL_PrivateMouseButton(SDL_RELEASED, SDL_BUTTON_WHEELDOWN, 0, 0);
+						} else {
+							SDL_PrivateMouseButton(SDL_PRESSED, SDL_BUTTON_WHEELUP, 0, 0);
+							SDL_PrivateMouseButton(SDL_RELEASED, SDL_BUTTON_WHEELUP, 0, 0);
+						}
+						break;
+					default:
+						break;
+				}
+			} else if(events[i].type == EV_SYN && code == SYN_REPORT) {
+				/* One motion event per report, not one per axis */
+				if(dx || dy) {
+					SDL_PrivateMouseMotion(0, SDL_TRUE, dx, dy);
+					dx = dy = 0;
+				}
+				reports++;
+			}
+		}
+
+		SDL_CountInput(&dev->rate, count, reports);
+
+		/* A short read means the device has been drained */
+		if(count < (unsigned int) read_batch) {
+			break;
+		}
+	}
+
+	/* Don't hold on to the deltas of a report cut short */
+	if(dx || dy) {
+		SDL_PrivateMouseMotion(0, SDL_TRUE, dx, dy);
+	}
+
+	SDL_SetEventTimestamp(0);
+}
+
+static void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_type, int udev_class, const char *devpath) {
+	SDL_evdevice *dev, **prev;
+
+	if(devpath == NULL) {
+		return;
+	}
+
+	switch (udev_type) {
+		case SDL_UDEV_DEVICEADDED:
+			/* Gamepads have keys too, but they belong to the joystick API */
+			if(!(udev_class & evdev_classes) || (udev_class & SDL_UDEV_DEVICE_JOYSTICK)) {
+				return;
+			}
+			/* The same mouse shows up as /dev/input/mouseN as well */
+			if(SDL_strncmp(devpath, "/dev/input/event", 16) != 0) {
+				return;
+			}
+			for (dev = evdev_devices; dev; dev = dev->next) {
+				if(SDL_strcmp(dev->path, devpath) == 0) {
+					return;
+				}
+			}
+			dev = SDL_EVDEV_OpenDevice(devpath);
+			if(dev == NULL) {
+				return;
+			}
+			dev->udev_class = udev_class;
+			if(evdev_epoll >= 0) {
+				struct epoll_event ev;
+
+				SDL_memset(&ev, 0, sizeof(ev));
+				ev.events = EPOLLIN;
+				ev.data.ptr = dev;
+				if(epoll_ctl(evdev_epoll, EPOLL_CTL_ADD, dev->fd, &ev) < 0) {
+					SDL_EVDEV_CloseDevice(dev);
+					return;
+				}
+			}
+			dev->next = evdev_devices;
+			evdev_devices = dev;
+			break;
+
+		case SDL_UDEV_DEVICEREMOVED:
+			for (prev = &evdev_devices; *prev; prev = &(*prev)->next) {
+				dev = *prev;
+				if(SDL_strcmp(dev->path, devpath) == 0) {
+					*prev = dev->next;
+					if(evdev_epoll >= 0) {
+						epoll_ctl(evdev_epoll, EPOLL_CTL_DEL, dev->fd, NULL);
+					}
+					SDL_EVDEV_CloseDevice(dev);
+					break;
+				}
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+int SDL_EVDEV_Init(int udev_classes, SDL_EVDEV_KeyHook hook, void *userdata) {
+	const char *env;
+
+	if(evdev_ref_count++ > 0) {
+		return (0);
+	}
+
+	read_batch = DEFAULT_READ_BATCH;
+	env = SDL_getenv("SDL_EVDEV_READ_BATCH");
+	if(env) {
+		read_batch = SDL_atoi(env);
+		if(read_batch < 1) {
+			read_batch = 1;
+		} else if(read_batch > MAX_READ_BATCH) {
+			read_batch = MAX_READ_BATCH;
+		}
+	}
+
+	if(SDL_UDEV_Init() < 0) {
+		evdev_ref_count = 0;
+		return (-1);
+	}
+	if(SDL_UDEV_AddCallback(SDL_EVDEV_udev_callback) < 0) {
+		SDL_UDEV_Quit();
+		evdev_ref_count = 0;
+		return (-1);
+	}
+
+	evdev_classes = udev_classes & (SDL_UDEV_DEVICE_KEYBOARD | SDL_UDEV_DEVICE_MOUSE);
+	evdev_hook = hook;
+	evdev_userdata = userdata;
+
+	/* Without epoll every device is read on every pump, as before */
+	evdev_epoll = epoll_create1(EPOLL_CLOEXEC);
+	evdev_udev_fd = SDL_UDEV_GetMonitorFd();
+	if(evdev_epoll >= 0 && evdev_udev_fd >= 0) {
+		struct epoll_event ev;
+
+		SDL_memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.ptr = NULL;
+		if(epoll_ctl(evdev_epoll, EPOLL_CTL_ADD, evdev_udev_fd, &ev) < 0) {
+			evdev_udev_fd = -1;
+		}
+	}
+
+	SDL_UDEV_Scan();
+	return (0);
+}
+
+void SDL_EVDEV_Quit(void) {
+	SDL_evdevice *dev;
+
+	if(evdev_ref_count == 0 || --evdev_ref_count > 0) {
+		return;
+	}
+
+	SDL_UDEV_DelCallback(SDL_EVDEV_udev_callback);
+	SDL_UDEV_Quit();
+
+	while (evdev_devices) {
+		dev = evdev_devices;
+		evdev_devices = dev->next;
+		SDL_EVDEV_CloseDevice(dev);
+	}
+	if(evdev_epoll >= 0) {
+		close(evdev_epoll);
+		evdev_epoll = -1;
+	}
+	evdev_udev_fd = -1;
+	evdev_classes = 0;
+	evdev_hook = NULL;
+	evdev_userdata = NULL;
+}
+
+int SDL_EVDEV_NumDevices(int udev_class) {
+	SDL_evdevice *dev;
+	int count = 0;
+
+	for (dev = evdev_devices; dev; dev = dev->next) {
+		if(dev->udev_class & udev_class) {
+			++count;
+		}
+	}
+	return (count);
+}
+
+void SDL_EVDEV_Poll(void) {
+	struct epoll_event ready[EVDEV_MAX_READY];
+	SDL_evdevice *dev;
+	SDL_bool hotplug;
+	int i, count;
+
+	if(evdev_ref_count == 0) {
+		return;
+	}
+
+	if(evdev_epoll < 0) {
+		/* Pick up devices that came or went first */
+		SDL_UDEV_Poll();
+
+		for (dev = evdev_devices; dev; dev = dev->next) {
+			SDL_EVDEV_PumpDevice(dev, evdev_hook, evdev_userdata);
+		}
+		return;
+	}
+
+	/* Don't look at the udev monitor on every pump if epoll can watch it */
+	hotplug = (evdev_udev_fd < 0);
+	count = epoll_wait(evdev_epoll, ready, EVDEV_MAX_READY, 0);
+	for (i = 0; i < count; ++i) {
+		if(ready[i].data.ptr == NULL) {
+			hotplug = SDL_TRUE;
+		} else {
+			SDL_EVDEV_PumpDevice((SDL_evdevice *) ready[i].data.ptr, evdev_hook, evdev_userdata);
+		}
+	}
+
+	/* After the pumps, so nothing in 'ready' gets closed under us */
+	if(hotplug) {
+		SDL_UDEV_Poll();
+	}
+}
+
+void SDL_EVDEV_Flush(void) {
+	struct input_event events[MAX_READ_BATCH];
+	SDL_evdevice *dev;
+
+	if(evdev_ref_count == 0) {
+		return;
+	}
+
+	SDL_UDEV_Poll();
+	for (dev = evdev_devices; dev; dev = dev->next) {
+		while (read(dev->fd, events, sizeof(events)) > 0) {
+		}
+	}
+}
+
+#endif /* SDL_USE_EVDEV */
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+#ifndef SDL_evdev_h_
+#define SDL_evdev_h_
+
+/* Keyboard and mouse input from /dev/input/event*, shared by the video
+   backends that don't get input from a windowing system */
+
+#include "SDL_udev.h"
+#include "../../events/SDL_events_c.h"
+
+#if SDL_INPUT_LINUXEV && defined(SDL_USE_LIBUDEV)
+
+#define SDL_USE_EVDEV 1
+
+/* An open event device */
+typedef struct SDL_evdevice {
+	char *path;
+	int fd;
+	int udev_class;      /* SDL_UDEV_deviceclass bits, 0 if not known */
+	SDL_bool monotonic;  /* events are stamped with CLOCK_MONOTONIC */
+	SDL_InputCounter rate;
+	struct SDL_evdevice *next;
+} SDL_evdevice;
+
+/* Sees every key and button before it is posted, returns nonzero to eat it.
+   'value' is 1 when pressed and 0 when released. */
+typedef int (*SDL_EVDEV_KeyHook)(void *userdata, int code, int value);
+
+/* Replace the key translation, see SDL_SetKeyRemap() */
+extern int SDL_EVDEV_SetKeymap(const SDL_KeyRemap *table, int count);
+
+/* Single devices, for backends that find their devices themselves */
+extern SDL_evdevice *SDL_EVDEV_OpenDevice(const char *path);
+
+extern void SDL_EVDEV_CloseDevice(SDL_evdevice *dev);
+
+extern void SDL_EVDEV_PumpDevice(SDL_evdevice *dev, SDL_EVDEV_KeyHook hook, void *userdata);
+
+/* All keyboards and/or mice (SDL_UDEV_DEVICE_KEYBOARD and SDL_UDEV_DEVICE_MOUSE
+   in 'udev_classes'), enumerated and hotplugged through SDL_UDEV */
+extern int SDL_EVDEV_Init(int udev_classes, SDL_EVDEV_KeyHook hook, void *userdata);
+
+extern void SDL_EVDEV_Quit(void);
+
+extern int SDL_EVDEV_NumDevices(int udev_class);
+
+extern void SDL_EVDEV_Poll(void);
+
+/* Throw away queued input, for while another VT has the keyboard */
+extern void SDL_EVDEV_Flush(void);
+
+#endif /* SDL_INPUT_LINUXEV && SDL_USE_LIBUDEV */
+
+#endif /* SDL_evdev_h_ */
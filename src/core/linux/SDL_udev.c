@@ -40,10 +40,9 @@
 
 #include <linux/input.h>
 
-//#include "SDL_assert.h"
+#include "SDL_assert.h"
 #include "SDL_loadso.h"
 #include "SDL_timer.h"
-//#include "SDL_hints.h"
 #include "../unix/SDL_poll.h"
 
 static const char *SDL_UDEV_LIBS[] = {
@@ -156,9 +155,8 @@ int SDL_UDEV_Init(void) {
 		_this->syms.udev_monitor_filter_add_match_subsystem_devtype(_this->udev_mon, "sound", NULL);
 		_this->syms.udev_monitor_enable_receiving(_this->udev_mon);
 
-		/* Do an initial scan of existing devices */
-		SDL_UDEV_Scan();
-
+		/* No callbacks can be registered yet, so there is nobody to
+		   report existing devices to. Users scan once they are set up. */
 	}
 
 	_this->ref_count += 1;
@@ -380,6 +378,17 @@ static int guess_device_class(struct udev_device *dev) {
 	return devclass;
 }
 
+/* Accelerometers are reported as joysticks unless
+   SDL_ACCELEROMETER_AS_JOYSTICK is set to 0 */
+static SDL_bool SDL_UDEV_accelerometer_as_joystick(void) {
+	const char *env = SDL_getenv("SDL_ACCELEROMETER_AS_JOYSTICK");
+
+	if(env && SDL_atoi(env) == 0) {
+		return SDL_FALSE;
+	}
+	return SDL_TRUE;
+}
+
 static void device_event(SDL_UDEV_deviceevent type, struct udev_device *dev) {
 	const char *subsystem;
 	const char *val = NULL;
@@ -404,7 +413,7 @@ static void device_event(SDL_UDEV_deviceevent type, struct udev_device *dev) {
 		}
 
 		val = _this->syms.udev_device_get_property_value(dev, "ID_INPUT_ACCELEROMETER");
-		if(SDL_GetHintBoolean(SDL_HINT_ACCELEROMETER_AS_JOYSTICK, SDL_TRUE) && val != NULL && SDL_strcmp(val, "1") == 0) {
+		if(SDL_UDEV_accelerometer_as_joystick() && val != NULL && SDL_strcmp(val, "1") == 0) {
 			devclass |= SDL_UDEV_DEVICE_JOYSTICK;
 		}
 
@@ -485,6 +494,13 @@ void SDL_UDEV_Poll(void) {
 	}
 }
 
+int SDL_UDEV_GetMonitorFd(void) {
+	if(_this == NULL || _this->udev_mon == NULL) {
+		return -1;
+	}
+	return _this->syms.udev_monitor_get_fd(_this->udev_mon);
+}
+
 int SDL_UDEV_AddCallback(SDL_UDEV_Callback cb) {
 	SDL_UDEV_CallbackList *item;
 	item = (SDL_UDEV_CallbackList *) SDL_calloc(1, sizeof(SDL_UDEV_CallbackList));
@@ -147,6 +147,9 @@ extern int SDL_UDEV_LoadLibrary(void);
 
 extern void SDL_UDEV_Poll(void);
 
+/* The monitor's fd, readable when SDL_UDEV_Poll() has something to do, or -1 */
+extern int SDL_UDEV_GetMonitorFd(void);
+
 extern void SDL_UDEV_Scan(void);
 
 extern int SDL_UDEV_AddCallback(SDL_UDEV_Callback cb);
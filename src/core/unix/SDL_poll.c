@@ -30,7 +30,7 @@
  ******************************************************************************/
 #include "SDL_config.h"
 
-//#include "SDL_assert.h"
+#include "SDL_assert.h"
 #include "SDL_poll.h"
 
 #ifdef HAVE_POLL
@@ -57,14 +57,27 @@ static struct {
 	int head;
 	int tail;
 	SDL_Event event[MAXEVENTS];
+	Uint32 timestamp[MAXEVENTS];
 	int wmmsg_next;
 	struct SDL_SysWMmsg wmmsg[MAXEVENTS];
 } SDL_EventQ;
 
+/* Merge motion into the last queued event of the same kind */
+static int SDL_MergeMotion = 0;
+
+/* When the input being posted happened, 0 if the backend doesn't know,
+   and the thread posting it -- both guarded by the queue lock */
+static Uint32 SDL_EventTimestamp = 0;
+static Uint32 SDL_EventTimestampThread = 0;
+
+/* The timestamp of the last event handed to the application */
+static Uint32 SDL_LastEventTimestamp = 0;
+
 /* Private data -- event locking structure */
 static struct {
 	SDL_mutex *lock;
-	int safe;
+	SDL_atomic_t safe;
+	SDL_atomic_t waiting;
 } SDL_EventLock;
 
 /* Thread functions */
@@ -75,7 +88,8 @@ void SDL_Lock_EventThread(void) {
 	if(SDL_EventThread && (SDL_ThreadID() != event_thread)) {
 		/* Grab lock and spin until we're sure event thread stopped */
 		SDL_mutexP(SDL_EventLock.lock);
-		while (!SDL_EventLock.safe) {
+		SDL_AtomicIncRef(&SDL_EventLock.waiting);
+		while (!SDL_AtomicGet(&SDL_EventLock.safe)) {
 			SDL_Delay(1);
 		}
 	}
@@ -83,6 +97,7 @@ void SDL_Lock_EventThread(void) {
 
 void SDL_Unlock_EventThread(void) {
 	if(SDL_EventThread && (SDL_ThreadID() != event_thread)) {
+		SDL_AtomicAdd(&SDL_EventLock.waiting, -1);
 		SDL_mutexV(SDL_EventLock.lock);
 	}
 }
@@ -110,30 +125,39 @@ static int SDLCALL SDL_GobbleEvents(void *unused) {
 		SDL_CheckKeyRepeat();
 
 #if !SDL_JOYSTICK_DISABLED
-		/* Check for joystick state change */
-		if(SDL_numjoysticks && (SDL_eventstate & SDL_JOYEVENTMASK)) {
+		/* Check for joystick state change and hotplug */
+		if((SDL_eventstate & SDL_JOYEVENTMASK) || SDL_joystick_stateonly) {
 			SDL_JoystickUpdate();
 		}
 #endif
 
+		/* A backend that bailed out early can't stamp later events */
+		SDL_SetEventTimestamp(0);
+
 		/* Give up the CPU for the rest of our timeslice */
-		SDL_EventLock.safe = 1;
+		SDL_AtomicSet(&SDL_EventLock.safe, 1);
 		if(SDL_timer_running) {
 			SDL_ThreadedTimerCheck();
 		}
 		SDL_Delay(1);
 
 		/* Check for event locking.
-		   On the P of the lock mutex, if the lock is held, this thread
-		   will wait until the lock is released before continuing.  The
-		   safe flag will be set, meaning that the other thread can go
-		   about it's business.  The safe flag is reset before the V,
-		   so as soon as the mutex is free, other threads can see that
-		   it's not safe to interfere with the event thread.
+		   Clearing the safe flag and then looking for waiters is ordered
+		   against the waiter registering itself and then looking at the
+		   safe flag, so at least one side always sees the other. With no
+		   waiter we carry on without touching the mutex. Otherwise the
+		   flag is raised again and the P of the lock mutex blocks this
+		   thread until the lock is released. The safe flag is reset before
+		   the V, so as soon as the mutex is free, other threads can see
+		   that it's not safe to interfere with the event thread.
 		 */
-		SDL_mutexP(SDL_EventLock.lock);
-		SDL_EventLock.safe = 0;
-		SDL_mutexV(SDL_EventLock.lock);
+		SDL_AtomicSet(&SDL_EventLock.safe, 0);
+		if(SDL_AtomicGet(&SDL_EventLock.waiting)) {
+			SDL_AtomicSet(&SDL_EventLock.safe, 1);
+			SDL_mutexP(SDL_EventLock.lock);
+			SDL_AtomicSet(&SDL_EventLock.safe, 0);
+			SDL_mutexV(SDL_EventLock.lock);
+		}
 	}
 	SDL_SetTimerThreaded(0);
 	event_thread = 0;
@@ -163,7 +187,8 @@ static int SDL_StartEventThread(Uint32 flags) {
 		if(SDL_EventLock.lock == NULL) {
 			return (-1);
 		}
-		SDL_EventLock.safe = 0;
+		SDL_AtomicSet(&SDL_EventLock.safe, 0);
+		SDL_AtomicSet(&SDL_EventLock.waiting, 0);
 
 		/* The event thread will handle timers too */
 		SDL_SetTimerThreaded(2);
@@ -235,6 +260,12 @@ int SDL_StartEventLoop(Uint32 flags) {
 	SDL_eventstate &= ~(0x00000001 << SDL_SYSWMEVENT);
 	SDL_ProcessEvents[SDL_SYSWMEVENT] = SDL_IGNORE;
 
+	/* Fast mice and analog sticks can fill the queue with motion */
+	SDL_MergeMotion = 0;
+	if(SDL_getenv("SDL_EVENT_MERGE_MOTION")) {
+		SDL_MergeMotion = SDL_atoi(SDL_getenv("SDL_EVENT_MERGE_MOTION"));
+	}
+
 	/* Initialize event handlers */
 	retcode = 0;
 	retcode += SDL_AppActiveInit();
@@ -255,6 +286,16 @@ int SDL_StartEventLoop(Uint32 flags) {
 }
 
 
+/* The time to stamp a new event with -- called with the queue locked.
+   Events other threads post meanwhile get the current time.
+ */
+static Uint32 SDL_StampEvent(void) {
+	if(SDL_EventTimestamp && SDL_EventTimestampThread == SDL_ThreadID()) {
+		return (SDL_EventTimestamp);
+	}
+	return (SDL_GetTicks());
+}
+
 /* Add an event to the event queue -- called with the queue locked */
 static int SDL_AddEvent(SDL_Event *event) {
 	int tail, added;
@@ -265,6 +306,7 @@ static int SDL_AddEvent(SDL_Event *event) {
 		added = 0;
 	} else {
 		SDL_EventQ.event[SDL_EventQ.tail] = *event;
+		SDL_EventQ.timestamp[SDL_EventQ.tail] = SDL_StampEvent();
 		if(event->type == SDL_SYSWMEVENT) {
 			/* Note that it's possible to lose an event */
 			int next = SDL_EventQ.wmmsg_next;
@@ -278,6 +320,49 @@ static int SDL_AddEvent(SDL_Event *event) {
 	return (added);
 }
 
+/* Fold a motion event into the last queued one if they describe the
+   same pointer or axis, so the latest value wins -- called with the
+   queue locked. Only the most recent event is considered, which keeps
+   motion ordered against the button and key events around it.
+ */
+static int SDL_MergeEvent(SDL_Event *event) {
+	SDL_Event *last;
+	int spot;
+
+	if(SDL_EventQ.tail == SDL_EventQ.head) {
+		return (0);
+	}
+	spot = (SDL_EventQ.tail + MAXEVENTS - 1) % MAXEVENTS;
+	last = &SDL_EventQ.event[spot];
+	if(last->type != event->type) {
+		return (0);
+	}
+	switch (event->type) {
+		case SDL_MOUSEMOTION:
+			if(last->motion.which != event->motion.which ||
+			   last->motion.state != event->motion.state) {
+				return (0);
+			}
+			last->motion.x = event->motion.x;
+			last->motion.y = event->motion.y;
+			last->motion.xrel += event->motion.xrel;
+			last->motion.yrel += event->motion.yrel;
+			SDL_EventQ.timestamp[spot] = SDL_StampEvent();
+			return (1);
+		case SDL_JOYAXISMOTION:
+			if(last->jaxis.which != event->jaxis.which ||
+			   last->jaxis.axis != event->jaxis.axis) {
+				return (0);
+			}
+			last->jaxis.value = event->jaxis.value;
+			SDL_EventQ.timestamp[spot] = SDL_StampEvent();
+			return (1);
+		default:
+			break;
+	}
+	return (0);
+}
+
 /* Cut an event, and return the next valid spot, or the tail */
 /*                           -- called with the queue locked */
 static int SDL_CutEvent(int spot) {
@@ -299,6 +384,7 @@ static int SDL_CutEvent(int spot) {
 		for (here = spot; here != SDL_EventQ.tail; here = next) {
 			next = (here + 1) % MAXEVENTS;
 			SDL_EventQ.event[here] = SDL_EventQ.event[next];
+			SDL_EventQ.timestamp[here] = SDL_EventQ.timestamp[next];
 		}
 		return (spot);
 	}
@@ -334,6 +420,7 @@ int SDL_PeepEvents(SDL_Event *events, int numevents, SDL_eventaction action, Uin
 			while ((used < numevents) && (spot != SDL_EventQ.tail)) {
 				if(mask & SDL_EVENTMASK(SDL_EventQ.event[spot].type)) {
 					events[used++] = SDL_EventQ.event[spot];
+					SDL_LastEventTimestamp = SDL_EventQ.timestamp[spot];
 					if(action == SDL_GETEVENT) {
 						spot = SDL_CutEvent(spot);
 					} else {
@@ -367,11 +454,14 @@ void SDL_PumpEvents(void) {
 		SDL_CheckKeyRepeat();
 
 #if !SDL_JOYSTICK_DISABLED
-		/* Check for joystick state change */
-		if(SDL_numjoysticks && (SDL_eventstate & SDL_JOYEVENTMASK)) {
+		/* Check for joystick state change and hotplug */
+		if((SDL_eventstate & SDL_JOYEVENTMASK) || SDL_joystick_stateonly) {
 			SDL_JoystickUpdate();
 		}
 #endif
+
+		/* A backend that bailed out early can't stamp later events */
+		SDL_SetEventTimestamp(0);
 	}
 }
 
@@ -408,6 +498,42 @@ int SDL_PushEvent(SDL_Event *event) {
 	return 0;
 }
 
+void SDL_SetEventTimestamp(Uint32 ticks) {
+	if(SDL_EventQ.lock == NULL) {
+		SDL_EventTimestamp = ticks;
+		SDL_EventTimestampThread = SDL_ThreadID();
+		return;
+	}
+	SDL_mutexP(SDL_EventQ.lock);
+	SDL_EventTimestamp = ticks;
+	SDL_EventTimestampThread = SDL_ThreadID();
+	SDL_mutexV(SDL_EventQ.lock);
+}
+
+Uint32 SDL_GetEventTimestamp(void) {
+	return (SDL_LastEventTimestamp);
+}
+
+int SDL_PushMotionEvent(SDL_Event *event) {
+	int used;
+
+	if(!SDL_MergeMotion) {
+		return SDL_PushEvent(event);
+	}
+	if(!SDL_EventQ.active) {
+		return -1;
+	}
+	used = 0;
+	if(SDL_mutexP(SDL_EventQ.lock) == 0) {
+		used = SDL_MergeEvent(event);
+		if(!used) {
+			used = SDL_AddEvent(event);
+		}
+		SDL_mutexV(SDL_EventQ.lock);
+	}
+	return (used ? 0 : -1);
+}
+
 void SDL_SetEventFilter(SDL_EventFilter filter) {
 	SDL_Event bitbucket;
 
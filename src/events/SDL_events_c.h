@@ -30,6 +30,9 @@
  ******************************************************************************/
 #include "SDL_config.h"
 
+#ifndef SDL_events_c_h_
+#define SDL_events_c_h_
+
 /* Useful functions and variables from SDL_events.c */
 #include "SDL_events.h"
 
@@ -89,6 +92,40 @@ extern int SDL_PrivateQuit(void);
 
 extern int SDL_PrivateSysWMEvent(SDL_SysWMmsg *message);
 
+/* Queue a mouse or joystick axis motion event. When SDL_EVENT_MERGE_MOTION
+   is set, it replaces the last queued event if that one is motion of the
+   same pointer or axis, rather than taking a new slot.
+ */
+extern int SDL_PushMotionEvent(SDL_Event *event);
+
+/* Input backends that know when the input happened set the timestamp,
+   in ticks, before posting events for it and reset it with 0 afterwards.
+   It only applies to events posted by the same thread, and is reset after
+   every pump anyway.  Events posted without one are stamped with the
+   current time, the stamps are kept beside the queue as SDL_Event has no
+   room for them.
+ */
+extern void SDL_SetEventTimestamp(Uint32 ticks);
+
+/* Report rate accounting for an input device, see SDL_GetInputRates() */
+typedef struct SDL_InputCounter {
+	const char *device;
+	Uint32 window_start;
+	Uint32 window_reports;
+	Uint32 window_events;
+	Uint32 reports;
+	Uint32 events;
+	struct SDL_InputCounter *next;
+} SDL_InputCounter;
+
+/* Register a counter for a device, the name must outlive the registration */
+extern void SDL_AddInputCounter(SDL_InputCounter *counter, const char *device);
+
+extern void SDL_DelInputCounter(SDL_InputCounter *counter);
+
+/* Account for the raw events and complete reports read from a device */
+extern void SDL_CountInput(SDL_InputCounter *counter, int events, int reports);
+
 /* Used to clamp the mouse coordinates separately from the video surface */
 extern void SDL_SetMouseRange(int maxX, int maxY);
 
@@ -106,3 +143,5 @@ extern void SDL_CheckKeyRepeat(void);
 #define DEFAULT_UNICODE_TRANSLATION 0    /* Default off because of overhead */
 #endif
 extern int SDL_TranslateUNICODE;
+
+#endif /* SDL_events_c_h_ */
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* Report rates of the input devices read by the event backends */
+
+#include "SDL_events.h"
+#include "SDL_timer.h"
+#include "SDL_atomic.h"
+#include "SDL_events_c.h"
+
+/* Rates are measured over windows of this many milliseconds */
+#define RATE_WINDOW    1000
+
+static SDL_InputCounter *SDL_counters = NULL;
+static SDL_SpinLock SDL_counters_lock = 0;
+
+void SDL_AddInputCounter(SDL_InputCounter *counter, const char *device) {
+	SDL_memset(counter, 0, sizeof(*counter));
+	counter->device = device;
+	counter->window_start = SDL_GetTicks();
+
+	SDL_AtomicLock(&SDL_counters_lock);
+	counter->next = SDL_counters;
+	SDL_counters = counter;
+	SDL_AtomicUnlock(&SDL_counters_lock);
+}
+
+void SDL_DelInputCounter(SDL_InputCounter *counter) {
+	SDL_InputCounter **prev;
+
+	SDL_AtomicLock(&SDL_counters_lock);
+	for (prev = &SDL_counters; *prev; prev = &(*prev)->next) {
+		if(*prev == counter) {
+			*prev = counter->next;
+			break;
+		}
+	}
+	SDL_AtomicUnlock(&SDL_counters_lock);
+}
+
+void SDL_CountInput(SDL_InputCounter *counter, int events, int reports) {
+	Uint32 now, elapsed;
+
+	counter->window_events += events;
+	counter->window_reports += reports;
+
+	now = SDL_GetTicks();
+	elapsed = now - counter->window_start;
+	if(elapsed >= RATE_WINDOW) {
+		counter->events = (counter->window_events * 1000) / elapsed;
+		counter->reports = (counter->window_reports * 1000) / elapsed;
+		counter->window_events = 0;
+		counter->window_reports = 0;
+		counter->window_start = now;
+	}
+}
+
+int SDL_GetInputRates(SDL_InputRate *rates, int maxrates) {
+	SDL_InputCounter *counter;
+	Uint32 now;
+	int count;
+
+	count = 0;
+	now = SDL_GetTicks();
+	SDL_AtomicLock(&SDL_counters_lock);
+	for (counter = SDL_counters; counter && (count < maxrates); counter = counter->next) {
+		SDL_strlcpy(rates[count].device, counter->device, sizeof(rates[count].device));
+		/* A device that went quiet hasn't closed its window */
+		if((now - counter->window_start) >= 2 * RATE_WINDOW) {
+			rates[count].events = 0;
+			rates[count].reports = 0;
+		} else {
+			rates[count].events = counter->events;
+			rates[count].reports = counter->reports;
+		}
+		++count;
+	}
+	SDL_AtomicUnlock(&SDL_counters_lock);
+	return (count);
+}
@@ -401,6 +401,23 @@ char *SDL_GetKeyName(SDLKey key) {
 	return (char *) (keyname);
 }
 
+int SDL_SetKeyRemap(const SDL_KeyRemap *table, int count) {
+	SDL_VideoDevice *video = current_video;
+	SDL_VideoDevice *this = current_video;
+	int retval;
+
+	if(!video || !video->RemapKeys) {
+		SDL_Unsupported();
+		return (-1);
+	}
+
+	/* Don't let the event thread translate keys while the table changes */
+	SDL_Lock_EventThread();
+	retval = video->RemapKeys(this, table, count);
+	SDL_Unlock_EventThread();
+	return (retval);
+}
+
 /* These are global for SDL_eventloop.c */
 int SDL_PrivateKeyboard(Uint8 state, SDL_keysym *keysym) {
 	SDL_Event event;
@@ -191,7 +191,7 @@ int SDL_PrivateMouseMotion(Uint8 buttonstate, int relative, Sint16 x, Sint16 y)
 		event.motion.yrel = Yrel;
 		if((SDL_EventOK == NULL) || (*SDL_EventOK)(&event)) {
 			posted = 1;
-			SDL_PushEvent(&event);
+			SDL_PushMotionEvent(&event);
 		}
 	}
 	return (posted);
@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/*
+   Read-only archives of many small files, opened and mapped once.
+
+   All numbers are little endian:
+
+     header   "SDLPAK\0\1", Uint32 count, Uint32 names_size
+     toc      count entries sorted by name (strcmp order):
+              Uint32 name, Uint32 flags, Uint32 offset, Uint32 stored, Uint32 size
+     names    names_size bytes of NUL terminated names, 'name' indexes here
+     data     each entry starts on a 4 KiB boundary of the file
+
+   An entry with SDL_ARCHIVE_LZ4 set holds 'stored' bytes of one LZ4 block
+   that decodes to 'size' bytes, otherwise 'stored' equals 'size'.
+   test/packassets.c writes these.
+*/
+
+#include "SDL_endian.h"
+#include "SDL_rwops.h"
+
+#define SDL_ARCHIVE_MAGIC       "SDLPAK\0\1"
+#define SDL_ARCHIVE_HEADER      16
+#define SDL_ARCHIVE_ENTRY       20
+#define SDL_ARCHIVE_LZ4         0x01
+
+struct SDL_Archive {
+	SDL_RWops *file;        /* What keeps 'base' around */
+	Uint8 *copy;            /* The file read into memory, without mmap() */
+	const Uint8 *base;
+	Uint32 size;
+	const Uint8 *toc;
+	const char *names;
+	Uint32 count;
+	Uint32 names_size;
+};
+
+static Uint32 archive_read32(const Uint8 *p) {
+	return ((Uint32) p[0] | ((Uint32) p[1] << 8) | ((Uint32) p[2] << 16) | ((Uint32) p[3] << 24));
+}
+
+/* Decodes one LZ4 block, returns -1 unless it fills 'dst' exactly */
+static int archive_lz4(const Uint8 *src, Uint32 srclen, Uint8 *dst, Uint32 dstlen) {
+	const Uint8 *ip = src, *iend = src + srclen;
+	Uint8 *op = dst, *oend = dst + dstlen;
+	const Uint8 *ref;
+	Uint32 len, offset;
+	Uint8 token, b;
+
+	while (ip < iend) {
+		token = *ip++;
+
+		/* Literals */
+		len = token >> 4;
+		if(len == 15) {
+			do {
+				if(ip >= iend) {
+					return (-1);
+				}
+				b = *ip++;
+				len += b;
+			} while (b == 255);
+		}
+		if(len > (Uint32) (iend - ip) || len > (Uint32) (oend - op)) {
+			return (-1);
+		}
+		SDL_memcpy(op, ip, len);
+		ip += len;
+		op += len;
+
+		/* The last sequence has no match */
+		if(ip >= iend) {
+			break;
+		}
+
+		/* Match, which may overlap what it copies */
+		if(iend - ip < 2) {
+			return (-1);
+		}
+		offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if(offset == 0 || offset > (Uint32) (op - dst)) {
+			return (-1);
+		}
+		len = token & 15;
+		if(len == 15) {
+			do {
+				if(ip >= iend) {
+					return (-1);
+				}
+				b = *ip++;
+				len += b;
+			} while (b == 255);
+		}
+		len += 4;
+		if(len > (Uint32) (oend - op)) {
+			return (-1);
+		}
+		ref = op - offset;
+		while (len--) {
+			*op++ = *ref++;
+		}
+	}
+
+	return (op == oend ? 0 : -1);
+}
+
+SDL_Archive *SDL_OpenArchive(const char *file) {
+	SDL_Archive *archive;
+	SDL_RWops *src;
+	const void *base;
+	int size, end;
+	Uint32 i, name;
+
+	archive = (SDL_Archive *) SDL_calloc(1, sizeof(*archive));
+	if(archive == NULL) {
+		SDL_OutOfMemory();
+		return NULL;
+	}
+
+	/* Mapped if possible, otherwise read in whole */
+	archive->file = SDL_RWFromMappedFile(file, SDL_RWMAP_WILLNEED);
+	if(archive->file) {
+		base = SDL_RWGetMemory(archive->file, &size);
+	} else {
+		src = SDL_RWFromFile(file, "rb");
+		if(src == NULL) {
+			SDL_free(archive);
+			return NULL;
+		}
+		end = SDL_RWseek(src, 0, RW_SEEK_END);
+		SDL_RWseek(src, 0, RW_SEEK_SET);
+		if(end < SDL_ARCHIVE_HEADER) {
+			SDL_SetError("%s is not an SDL archive", file);
+			SDL_RWclose(src);
+			SDL_free(archive);
+			return NULL;
+		}
+		archive->copy = (Uint8 *) SDL_malloc(end);
+		if(archive->copy == NULL || SDL_RWread(src, archive->copy, end, 1) != 1) {
+			if(archive->copy == NULL) {
+				SDL_OutOfMemory();
+			} else {
+				SDL_Error(SDL_EFREAD);
+			}
+			SDL_RWclose(src);
+			SDL_free(archive->copy);
+			SDL_free(archive);
+			return NULL;
+		}
+		SDL_RWclose(src);
+		base = archive->copy;
+		size = end;
+	}
+	archive->base = (const Uint8 *) base;
+	archive->size = size;
+
+	/* Check everything up front so lookups don't have to */
+	if(archive->size < SDL_ARCHIVE_HEADER || SDL_memcmp(archive->base, SDL_ARCHIVE_MAGIC, 8) != 0) {
+		SDL_SetError("%s is not an SDL archive", file);
+		goto fail;
+	}
+	archive->count = archive_read32(archive->base + 8);
+	archive->names_size = archive_read32(archive->base + 12);
+	if((Uint64) SDL_ARCHIVE_HEADER + (Uint64) archive->count * SDL_ARCHIVE_ENTRY + archive->names_size > archive->size ||
+	   (archive->names_size && archive->base[SDL_ARCHIVE_HEADER + archive->count * SDL_ARCHIVE_ENTRY + archive->names_size - 1] != '\0')) {
+		SDL_SetError("%s has a damaged table of contents", file);
+		goto fail;
+	}
+	archive->toc = archive->base + SDL_ARCHIVE_HEADER;
+	archive->names = (const char *) archive->toc + archive->count * SDL_ARCHIVE_ENTRY;
+
+	for (i = 0; i < archive->count; ++i) {
+		const Uint8 *entry = archive->toc + i * SDL_ARCHIVE_ENTRY;
+
+		name = archive_read32(entry);
+		if(name >= archive->names_size ||
+		   (Uint64) archive_read32(entry + 8) + archive_read32(entry + 12) > archive->size ||
+		   (!(archive_read32(entry + 4) & SDL_ARCHIVE_LZ4) && archive_read32(entry + 12) != archive_read32(entry + 16)) ||
+		   (i > 0 && SDL_strcmp(archive->names + archive_read32(entry - SDL_ARCHIVE_ENTRY), archive->names + name) >= 0)) {
+			SDL_SetError("%s has a damaged table of contents", file);
+			goto fail;
+		}
+	}
+
+	return archive;
+
+fail:
+	SDL_CloseArchive(archive);
+	return NULL;
+}
+
+void SDL_CloseArchive(SDL_Archive *archive) {
+	if(archive) {
+		if(archive->file) {
+			SDL_RWclose(archive->file);
+		}
+		SDL_free(archive->copy);
+		SDL_free(archive);
+	}
+}
+
+static int SDLCALL archive_close(SDL_RWops *context) {
+	if(context) {
+		SDL_free(context->hidden.mem.base);
+		SDL_FreeRW(context);
+	}
+	return (0);
+}
+
+SDL_RWops *SDL_RWFromArchive(SDL_Archive *archive, const char *name) {
+	const Uint8 *entry;
+	SDL_RWops *rwops;
+	Uint32 flags, offset, stored, size;
+	Uint8 *data;
+	int lo, hi, mid, cmp;
+
+	if(archive == NULL || name == NULL) {
+		SDL_SetError("SDL_RWFromArchive(): No archive or no name specified");
+		return NULL;
+	}
+
+	/* The table is sorted */
+	entry = NULL;
+	lo = 0;
+	hi = (int) archive->count - 1;
+	while (lo <= hi) {
+		mid = lo + (hi - lo) / 2;
+		cmp = SDL_strcmp(name, archive->names + archive_read32(archive->toc + mid * SDL_ARCHIVE_ENTRY));
+		if(cmp == 0) {
+			entry = archive->toc + mid * SDL_ARCHIVE_ENTRY;
+			break;
+		}
+		if(cmp < 0) {
+			hi = mid - 1;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	if(entry == NULL) {
+		SDL_SetError("Couldn't find %s in archive", name);
+		return NULL;
+	}
+
+	flags = archive_read32(entry + 4);
+	offset = archive_read32(entry + 8);
+	stored = archive_read32(entry + 12);
+	size = archive_read32(entry + 16);
+
+	/* Stored entries are read right out of the archive */
+	if(!(flags & SDL_ARCHIVE_LZ4)) {
+		return SDL_RWFromConstMem(archive->base + offset, size);
+	}
+
+	data = (Uint8 *) SDL_malloc(size ? size : 1);
+	if(data == NULL) {
+		SDL_OutOfMemory();
+		return NULL;
+	}
+	if(archive_lz4(archive->base + offset, stored, data, size) < 0) {
+		SDL_SetError("%s is damaged in the archive", name);
+		SDL_free(data);
+		return NULL;
+	}
+	rwops = SDL_RWFromConstMem(data, size);
+	if(rwops == NULL) {
+		SDL_free(data);
+		return NULL;
+	}
+	rwops->close = archive_close;
+	return (rwops);
+}
@@ -0,0 +1,384 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* Background file reads served by a single I/O thread */
+
+#include "SDL_atomic.h"
+#include "SDL_asyncio.h"
+#include "SDL_events.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
+#include "../events/SDL_events_c.h"
+
+/* Requests waiting for the I/O thread, a power of two */
+#define ASYNCIO_QUEUE_SIZE    32
+
+struct SDL_AsyncIO {
+	char *file;
+	SDL_AsyncIOFunction load;
+	void *data;
+	int flags;
+	int status;
+	int freed;          /* SDL_AsyncIOFree() was called while it was read */
+	char *error;        /* The I/O thread's error message on failure */
+	void *contents;
+	int size;
+	void *result;
+};
+
+static SDL_SpinLock asyncio_initlock;
+static SDL_mutex *asyncio_lock;
+static SDL_cond *asyncio_queued;    /* Signalled when a request is queued */
+static SDL_cond *asyncio_space;     /* Signalled when the queue has room */
+static SDL_cond *asyncio_done;      /* Broadcast when a request finishes */
+static SDL_Thread *asyncio_thread;
+static int asyncio_quit;
+static int asyncio_waiting;         /* Callers blocked on asyncio_space or asyncio_done */
+static int asyncio_inline;          /* No I/O thread, reads happen in SDL_AsyncReadFile() */
+
+/* Freed requests leave a NULL behind so the queue can't shift under the reader */
+static SDL_AsyncIO *asyncio_queue[ASYNCIO_QUEUE_SIZE];
+static unsigned int asyncio_head;
+static unsigned int asyncio_tail;
+
+/* Without an I/O thread there is nothing to lock */
+static void asyncio_enter(void) {
+	if(asyncio_lock) {
+		SDL_LockMutex(asyncio_lock);
+	}
+}
+
+static void asyncio_leave(void) {
+	if(asyncio_lock) {
+		SDL_UnlockMutex(asyncio_lock);
+	}
+}
+
+static void asyncio_release(SDL_AsyncIO *io) {
+	SDL_free(io->file);
+	SDL_free(io->error);
+	SDL_free(io->contents);
+	SDL_free(io);
+}
+
+/* Read the file and run the loader, on the I/O thread */
+static int asyncio_run(SDL_AsyncIO *io) {
+	SDL_RWops *src;
+	Sint64 size;
+
+	src = SDL_RWFromFile(io->file, "rb");
+	if(src == NULL) {
+		return (-1);
+	}
+	size = SDL_RWsize(src);
+	if(size < 0 || size > SDL_MAX_SINT32) {
+		SDL_SetError("Couldn't read %s", io->file);
+		SDL_RWclose(src);
+		return (-1);
+	}
+	io->contents = SDL_malloc(size ? (size_t) size : 1);
+	if(io->contents == NULL) {
+		SDL_OutOfMemory();
+		SDL_RWclose(src);
+		return (-1);
+	}
+	/* Reads this large skip the RWops buffer and land straight in contents */
+	if(size > 0 && SDL_RWread(src, io->contents, (int) size, 1) != 1) {
+		SDL_SetError("Couldn't read %s", io->file);
+		SDL_RWclose(src);
+		return (-1);
+	}
+	io->size = (int) size;
+	SDL_RWclose(src);
+
+	if(io->load) {
+		src = SDL_RWFromConstMem(io->contents, io->size);
+		if(src == NULL) {
+			return (-1);
+		}
+		io->result = io->load(src, io->data);
+		if(io->result == NULL) {
+			return (-1);
+		}
+	}
+	return (0);
+}
+
+static void asyncio_post(SDL_AsyncIO *io) {
+	SDL_Event event;
+
+	if(SDL_ProcessEvents[SDL_ASYNCIODONE] == SDL_ENABLE) {
+		event.type = SDL_ASYNCIODONE;
+		event.asyncio.status = io->status;
+		event.asyncio.io = io;
+		event.asyncio.data = io->data;
+		if((SDL_EventOK == NULL) || (*SDL_EventOK)(&event)) {
+			SDL_PushEvent(&event);
+		}
+	}
+}
+
+/* Called with the lock held */
+static void asyncio_finish(SDL_AsyncIO *io, int failed) {
+	if(failed) {
+		io->error = SDL_strdup(SDL_GetError());
+		io->status = SDL_ASYNCIO_FAILED;
+	} else {
+		io->status = SDL_ASYNCIO_DONE;
+	}
+	if(io->freed) {
+		asyncio_release(io);
+		return;
+	}
+	if(asyncio_done) {
+		SDL_CondBroadcast(asyncio_done);
+	}
+	if(io->flags & SDL_ASYNCIO_EVENT) {
+		asyncio_post(io);
+	}
+}
+
+static int SDLCALL asyncio_worker(void *unused) {
+	SDL_AsyncIO *io;
+	int failed;
+
+	SDL_LockMutex(asyncio_lock);
+	while (!asyncio_quit) {
+		if(asyncio_head == asyncio_tail) {
+			SDL_CondWait(asyncio_queued, asyncio_lock);
+			continue;
+		}
+		io = asyncio_queue[asyncio_head++ & (ASYNCIO_QUEUE_SIZE - 1)];
+		SDL_CondSignal(asyncio_space);
+		if(io == NULL) {
+			continue;
+		}
+
+		/* Marked pending but out of the queue, SDL_AsyncIOFree() leaves it to us */
+		io->freed = -1;
+		SDL_UnlockMutex(asyncio_lock);
+		failed = asyncio_run(io);
+		SDL_LockMutex(asyncio_lock);
+		io->freed = (io->freed > 0);
+		asyncio_finish(io, failed);
+	}
+	SDL_UnlockMutex(asyncio_lock);
+	return (0);
+}
+
+static void asyncio_init(void) {
+	SDL_AtomicLock(&asyncio_initlock);
+	if(asyncio_lock == NULL && !asyncio_inline) {
+		asyncio_lock = SDL_CreateMutex();
+		asyncio_queued = SDL_CreateCond();
+		asyncio_space = SDL_CreateCond();
+		asyncio_done = SDL_CreateCond();
+		asyncio_quit = 0;
+		if(asyncio_lock && asyncio_queued && asyncio_space && asyncio_done) {
+			asyncio_thread = SDL_CreateThread(asyncio_worker, NULL);
+		}
+		if(asyncio_thread == NULL) {
+			SDL_DestroyCond(asyncio_done);
+			SDL_DestroyCond(asyncio_space);
+			SDL_DestroyCond(asyncio_queued);
+			SDL_DestroyMutex(asyncio_lock);
+			asyncio_done = asyncio_space = asyncio_queued = NULL;
+			asyncio_lock = NULL;
+			asyncio_inline = 1;
+		}
+	}
+	SDL_AtomicUnlock(&asyncio_initlock);
+}
+
+SDL_AsyncIO *SDL_AsyncReadFile(const char *file, SDL_AsyncIOFunction load, void *data, int flags) {
+	SDL_AsyncIO *io;
+
+	if(!file || !*file) {
+		SDL_SetError("SDL_AsyncReadFile(): No file specified");
+		return NULL;
+	}
+
+	io = (SDL_AsyncIO *) SDL_malloc(sizeof(*io));
+	if(io == NULL) {
+		SDL_OutOfMemory();
+		return NULL;
+	}
+	SDL_memset(io, 0, sizeof(*io));
+	io->file = SDL_strdup(file);
+	if(io->file == NULL) {
+		SDL_free(io);
+		SDL_OutOfMemory();
+		return NULL;
+	}
+	io->load = load;
+	io->data = data;
+	io->flags = flags;
+	io->status = SDL_ASYNCIO_PENDING;
+
+	asyncio_init();
+	if(asyncio_inline) {
+		asyncio_finish(io, asyncio_run(io));
+		return (io);
+	}
+
+	SDL_LockMutex(asyncio_lock);
+	while (!asyncio_quit && asyncio_tail - asyncio_head == ASYNCIO_QUEUE_SIZE) {
+		if(flags & SDL_ASYNCIO_NOWAIT) {
+			SDL_UnlockMutex(asyncio_lock);
+			asyncio_release(io);
+			SDL_SetError("Asynchronous I/O queue is full");
+			return NULL;
+		}
+		++asyncio_waiting;
+		SDL_CondWait(asyncio_space, asyncio_lock);
+		--asyncio_waiting;
+	}
+	if(asyncio_quit) {
+		SDL_UnlockMutex(asyncio_lock);
+		asyncio_release(io);
+		SDL_SetError("Asynchronous I/O was shut down");
+		return NULL;
+	}
+	asyncio_queue[asyncio_tail++ & (ASYNCIO_QUEUE_SIZE - 1)] = io;
+	SDL_CondSignal(asyncio_queued);
+	SDL_UnlockMutex(asyncio_lock);
+	return (io);
+}
+
+int SDL_AsyncIOStatus(SDL_AsyncIO *io) {
+	int status;
+
+	asyncio_enter();
+	status = io->status;
+	asyncio_leave();
+	if(status == SDL_ASYNCIO_FAILED) {
+		SDL_SetError("%s", io->error ? io->error : "Asynchronous read failed");
+	}
+	return (status);
+}
+
+int SDL_AsyncIOWait(SDL_AsyncIO *io) {
+	asyncio_enter();
+	while (io->status == SDL_ASYNCIO_PENDING && asyncio_done) {
+		++asyncio_waiting;
+		SDL_CondWait(asyncio_done, asyncio_lock);
+		--asyncio_waiting;
+	}
+	asyncio_leave();
+	return (SDL_AsyncIOStatus(io));
+}
+
+const void *SDL_AsyncIOData(SDL_AsyncIO *io, int *size) {
+	if(SDL_AsyncIOStatus(io) != SDL_ASYNCIO_DONE) {
+		return NULL;
+	}
+	if(size) {
+		*size = io->size;
+	}
+	return (io->contents);
+}
+
+void *SDL_AsyncIOResult(SDL_AsyncIO *io) {
+	if(SDL_AsyncIOStatus(io) != SDL_ASYNCIO_DONE) {
+		return NULL;
+	}
+	return (io->result);
+}
+
+void SDL_AsyncIOFree(SDL_AsyncIO *io) {
+	unsigned int i;
+
+	if(io == NULL) {
+		return;
+	}
+
+	asyncio_enter();
+	if(io->status == SDL_ASYNCIO_PENDING) {
+		if(io->freed < 0) {
+			/* Being read, the I/O thread frees it when done */
+			io->freed = 1;
+			asyncio_leave();
+			return;
+		}
+		for (i = asyncio_head; i != asyncio_tail; ++i) {
+			if(asyncio_queue[i & (ASYNCIO_QUEUE_SIZE - 1)] == io) {
+				asyncio_queue[i & (ASYNCIO_QUEUE_SIZE - 1)] = NULL;
+			}
+		}
+	}
+	asyncio_leave();
+	asyncio_release(io);
+}
+
+/* Stop the I/O thread, requests still queued fail */
+void SDL_AsyncIOQuit(void) {
+	SDL_AsyncIO *io;
+
+	SDL_AtomicLock(&asyncio_initlock);
+	if(asyncio_thread) {
+		SDL_LockMutex(asyncio_lock);
+		asyncio_quit = 1;
+		SDL_CondSignal(asyncio_queued);
+		SDL_UnlockMutex(asyncio_lock);
+		SDL_WaitThread(asyncio_thread, NULL);
+		asyncio_thread = NULL;
+
+		SDL_LockMutex(asyncio_lock);
+		SDL_SetError("Asynchronous I/O was shut down");
+		while (asyncio_head != asyncio_tail) {
+			io = asyncio_queue[asyncio_head++ & (ASYNCIO_QUEUE_SIZE - 1)];
+			if(io) {
+				asyncio_finish(io, 1);
+			}
+		}
+
+		/* Nobody may be left inside a wait when the primitives go away */
+		while (asyncio_waiting > 0) {
+			SDL_CondBroadcast(asyncio_space);
+			SDL_CondBroadcast(asyncio_done);
+			SDL_UnlockMutex(asyncio_lock);
+			SDL_Delay(1);
+			SDL_LockMutex(asyncio_lock);
+		}
+		SDL_UnlockMutex(asyncio_lock);
+
+		SDL_DestroyCond(asyncio_done);
+		SDL_DestroyCond(asyncio_space);
+		SDL_DestroyCond(asyncio_queued);
+		SDL_DestroyMutex(asyncio_lock);
+		asyncio_done = asyncio_space = asyncio_queued = NULL;
+		asyncio_lock = NULL;
+	}
+	asyncio_inline = 0;
+	SDL_AtomicUnlock(&asyncio_initlock);
+}
@@ -34,16 +34,74 @@
 #include "SDL_endian.h"
 #include "SDL_rwops.h"
 
+#if defined(HAVE_UNISTD_H) && defined(HAVE_FCNTL_H)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SDL_RWOPS_FD 1
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+#ifndef O_LARGEFILE
+#define O_LARGEFILE 0
+#endif
+#ifdef HAVE_LSEEK64
+#define rw_lseek lseek64
+#else
+#define rw_lseek lseek
+#endif
+#endif
+
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H) && defined(SDL_RWOPS_FD)
+#include <sys/mman.h>
+#define SDL_RWOPS_MMAP 1
+#endif
+
+#if defined(HAVE_FSEEKO64)
+#define rw_fseek fseeko64
+#define rw_ftell ftello64
+#elif defined(HAVE_FSEEKO)
+#define rw_fseek fseeko
+#define rw_ftell ftello
+#else
+#define rw_fseek fseek
+#define rw_ftell ftell
+#endif
+
+#ifdef HAVE_FOPEN64
+#define rw_fopen fopen64
+#else
+#define rw_fopen fopen
+#endif
+
+/* The int seek in SDL_RWops can't report offsets past 2 GiB */
+static int rw_seek32(Sint64 pos) {
+	if(pos > SDL_MAX_SINT32) {
+		SDL_SetError("File offset too large, use SDL_RWseek64()");
+		return (-1);
+	}
+	return ((int) pos);
+}
+
 #ifdef HAVE_STDIO_H
 
 /* Functions to read/write stdio file pointers */
-static int SDLCALL stdio_seek(SDL_RWops *context, int offset, int whence) {
-	if(fseek(context->hidden.stdio.fp, offset, whence) == 0) {
-		return (ftell(context->hidden.stdio.fp));
-	} else {
-		SDL_Error(SDL_EFSEEK);
-		return (-1);
+static Sint64 stdio_seek64(SDL_RWops *context, Sint64 offset, int whence) {
+	Sint64 pos;
+
+	if(rw_fseek(context->hidden.stdio.fp, offset, whence) == 0) {
+		pos = rw_ftell(context->hidden.stdio.fp);
+		if(pos >= 0) {
+			return (pos);
+		}
 	}
+	SDL_Error(SDL_EFSEEK);
+	return (-1);
+}
+
+static int SDLCALL stdio_seek(SDL_RWops *context, int offset, int whence) {
+	return (rw_seek32(stdio_seek64(context, offset, whence)));
 }
 
 static int SDLCALL stdio_read(SDL_RWops *context, void *ptr, int size, int maxnum) {
@@ -79,33 +137,231 @@ static int SDLCALL stdio_close(SDL_RWops *context) {
 
 #endif /* !HAVE_STDIO_H */
 
+#ifdef SDL_RWOPS_FD
+
+/* Read-only files read through their own buffer, so small reads are a
+   memcpy and reads of a buffer or more go straight to the caller.
+   hidden.fdio.here and hidden.fdio.stop bracket what's left in it. */
+
+#define SDL_RWBUF_SIZE 8192
+
+typedef struct {
+	int fd;
+	Sint64 end;         /* File offset of hidden.fdio.stop */
+	Uint8 data[SDL_RWBUF_SIZE];
+} SDL_RWfdfile;
+
+static int fd_fill(SDL_RWops *context) {
+	SDL_RWfdfile *file = (SDL_RWfdfile *) context->hidden.fdio.file;
+	ssize_t got;
+
+	do {
+		got = read(file->fd, file->data, SDL_RWBUF_SIZE);
+	} while (got < 0 && errno == EINTR);
+
+	if(got < 0) {
+		SDL_Error(SDL_EFREAD);
+		got = 0;
+	}
+	file->end += got;
+	context->hidden.fdio.here = file->data;
+	context->hidden.fdio.stop = file->data + got;
+	return ((int) got);
+}
+
+static Sint64 fd_seek64(SDL_RWops *context, Sint64 offset, int whence) {
+	SDL_RWfdfile *file = (SDL_RWfdfile *) context->hidden.fdio.file;
+	Sint64 pos;
+
+	switch (whence) {
+		case RW_SEEK_SET:
+			pos = offset;
+			break;
+		case RW_SEEK_CUR:
+			pos = file->end - (context->hidden.fdio.stop - context->hidden.fdio.here) + offset;
+			break;
+		case RW_SEEK_END:
+			pos = rw_lseek(file->fd, offset, SEEK_END);
+			if(pos < 0) {
+				SDL_Error(SDL_EFSEEK);
+				return (-1);
+			}
+			file->end = pos;
+			context->hidden.fdio.here = context->hidden.fdio.stop = file->data;
+			return (pos);
+		default:
+			SDL_SetError("Unknown value for 'whence'");
+			return (-1);
+	}
+
+	/* Seeking around inside the buffer doesn't touch the file */
+	if(pos >= file->end - (context->hidden.fdio.stop - file->data) && pos <= file->end) {
+		context->hidden.fdio.here = context->hidden.fdio.stop - (file->end - pos);
+		return (pos);
+	}
+	if(pos < 0 || rw_lseek(file->fd, pos, SEEK_SET) < 0) {
+		SDL_Error(SDL_EFSEEK);
+		return (-1);
+	}
+	file->end = pos;
+	context->hidden.fdio.here = context->hidden.fdio.stop = file->data;
+	return (pos);
+}
+
+static int SDLCALL fd_seek(SDL_RWops *context, int offset, int whence) {
+	return (rw_seek32(fd_seek64(context, offset, whence)));
+}
+
+static int SDLCALL fd_read(SDL_RWops *context, void *ptr, int size, int maxnum) {
+	SDL_RWfdfile *file = (SDL_RWfdfile *) context->hidden.fdio.file;
+	Uint8 *dst = (Uint8 *) ptr;
+	size_t total_bytes, left, n;
+	ssize_t got;
+
+	total_bytes = (maxnum * size);
+	if((maxnum <= 0) || (size <= 0) || ((total_bytes / maxnum) != (size_t) size)) {
+		return 0;
+	}
+
+	n = context->hidden.fdio.stop - context->hidden.fdio.here;
+	if(n > total_bytes) {
+		n = total_bytes;
+	}
+	SDL_memcpy(dst, context->hidden.fdio.here, n);
+	context->hidden.fdio.here += n;
+	dst += n;
+	left = total_bytes - n;
+
+	while (left > 0) {
+		if(left >= SDL_RWBUF_SIZE) {
+			context->hidden.fdio.here = context->hidden.fdio.stop = file->data;
+			got = read(file->fd, dst, left);
+			if(got < 0 && errno == EINTR) {
+				continue;
+			}
+			if(got <= 0) {
+				if(got < 0) {
+					SDL_Error(SDL_EFREAD);
+				}
+				break;
+			}
+			file->end += got;
+			n = got;
+		} else {
+			if(fd_fill(context) == 0) {
+				break;
+			}
+			n = context->hidden.fdio.stop - context->hidden.fdio.here;
+			if(n > left) {
+				n = left;
+			}
+			SDL_memcpy(dst, context->hidden.fdio.here, n);
+			context->hidden.fdio.here += n;
+		}
+		dst += n;
+		left -= n;
+	}
+	return ((total_bytes - left) / size);
+}
+
+static int SDLCALL fd_write(SDL_RWops *context, const void *ptr, int size, int num) {
+	/* Same as fwrite() on a stream opened for reading */
+	SDL_Error(SDL_EFWRITE);
+	return (0);
+}
+
+static int SDLCALL fd_close(SDL_RWops *context) {
+	if(context) {
+		SDL_RWfdfile *file = (SDL_RWfdfile *) context->hidden.fdio.file;
+
+		close(file->fd);
+		SDL_free(file);
+		SDL_FreeRW(context);
+	}
+	return (0);
+}
+
+static Sint64 fd_size(SDL_RWops *context) {
+	SDL_RWfdfile *file = (SDL_RWfdfile *) context->hidden.fdio.file;
+	Sint64 size;
+
+	/* The descriptor sits at file->end, put it back there */
+	size = rw_lseek(file->fd, 0, SEEK_END);
+	if(size < 0 || rw_lseek(file->fd, file->end, SEEK_SET) < 0) {
+		SDL_Error(SDL_EFSEEK);
+		return (-1);
+	}
+	return (size);
+}
+
+static SDL_RWops *fd_open(const char *file) {
+	SDL_RWops *rwops;
+	SDL_RWfdfile *fdfile;
+	int fd;
+
+	fd = open(file, O_RDONLY | O_CLOEXEC | O_LARGEFILE);
+	if(fd < 0) {
+		SDL_SetError("Couldn't open %s", file);
+		return NULL;
+	}
+
+	fdfile = (SDL_RWfdfile *) SDL_malloc(sizeof(*fdfile));
+	rwops = fdfile ? SDL_AllocRW() : NULL;
+	if(rwops == NULL) {
+		if(fdfile == NULL) {
+			SDL_OutOfMemory();
+		}
+		SDL_free(fdfile);
+		close(fd);
+		return NULL;
+	}
+	fdfile->fd = fd;
+	fdfile->end = 0;
+	rwops->seek = fd_seek;
+	rwops->read = fd_read;
+	rwops->write = fd_write;
+	rwops->close = fd_close;
+	rwops->hidden.fdio.file = fdfile;
+	rwops->hidden.fdio.here = fdfile->data;
+	rwops->hidden.fdio.stop = fdfile->data;
+	rwops->type = SDL_RWOPS_FDFILE;
+	return (rwops);
+}
+
+#endif /* SDL_RWOPS_FD */
+
 /* Functions to read/write memory pointers */
 
-static int SDLCALL mem_seek(SDL_RWops *context, int offset, int whence) {
-	Uint8 *newpos;
+static Sint64 mem_seek64(SDL_RWops *context, Sint64 offset, int whence) {
+	Sint64 size = context->hidden.mem.stop - context->hidden.mem.base;
+	Sint64 pos;
 
 	switch (whence) {
 		case RW_SEEK_SET:
-			newpos = context->hidden.mem.base + offset;
+			pos = offset;
 			break;
 		case RW_SEEK_CUR:
-			newpos = context->hidden.mem.here + offset;
+			pos = (context->hidden.mem.here - context->hidden.mem.base) + offset;
 			break;
 		case RW_SEEK_END:
-			newpos = context->hidden.mem.stop + offset;
+			pos = size + offset;
 			break;
 		default:
 			SDL_SetError("Unknown value for 'whence'");
 			return (-1);
 	}
-	if(newpos < context->hidden.mem.base) {
-		newpos = context->hidden.mem.base;
+	if(pos < 0) {
+		pos = 0;
 	}
-	if(newpos > context->hidden.mem.stop) {
-		newpos = context->hidden.mem.stop;
+	if(pos > size) {
+		pos = size;
 	}
-	context->hidden.mem.here = newpos;
-	return (context->hidden.mem.here - context->hidden.mem.base);
+	context->hidden.mem.here = context->hidden.mem.base + pos;
+	return (pos);
+}
+
+static int SDLCALL mem_seek(SDL_RWops *context, int offset, int whence) {
+	return ((int) mem_seek64(context, offset, whence));
 }
 
 static int SDLCALL mem_read(SDL_RWops *context, void *ptr, int size, int maxnum) {
@@ -149,6 +405,22 @@ static int SDLCALL mem_close(SDL_RWops *context) {
 	return (0);
 }
 
+#ifdef SDL_RWOPS_MMAP
+
+/* Mapped files are read with the memory functions above */
+
+static int SDLCALL mapped_close(SDL_RWops *context) {
+	if(context) {
+		if(context->hidden.mem.stop > context->hidden.mem.base) {
+			munmap(context->hidden.mem.base, context->hidden.mem.stop - context->hidden.mem.base);
+		}
+		SDL_FreeRW(context);
+	}
+	return (0);
+}
+
+#endif /* SDL_RWOPS_MMAP */
+
 
 /* Functions to create SDL_RWops structures from various data sources */
 SDL_RWops *SDL_RWFromFile(const char *file, const char *mode) {
@@ -162,8 +434,20 @@ SDL_RWops *SDL_RWFromFile(const char *file, const char *mode) {
 		return NULL;
 	}
 
+#ifdef SDL_RWOPS_FD
+	/* Files opened for reading only can get the read-ahead buffer instead
+	   of stdio, but applications may still expect hidden.stdio.fp, so
+	   that's only done when asked for */
+	if(mode[0] == 'r' && SDL_strchr(mode, '+') == NULL) {
+		const char *fdio = SDL_getenv("SDL_RWOPS_FD");
+		if(fdio && SDL_atoi(fdio)) {
+			return (fd_open(file));
+		}
+	}
+#endif
+
 #if HAVE_STDIO_H
-	fp = fopen(file, mode);
+	fp = rw_fopen(file, mode);
 	if(fp == NULL) {
 		SDL_SetError("Couldn't open %s", file);
 	} else {
@@ -189,6 +473,7 @@ SDL_RWops *SDL_RWFromFP(FILE *fp, int autoclose) {
 		rwops->close = stdio_close;
 		rwops->hidden.stdio.fp = fp;
 		rwops->hidden.stdio.autoclose = autoclose;
+		rwops->type = SDL_RWOPS_STDFILE;
 	}
 	return (rwops);
 }
@@ -207,6 +492,7 @@ SDL_RWops *SDL_RWFromMem(void *mem, int size) {
 		rwops->hidden.mem.base = (Uint8 *) mem;
 		rwops->hidden.mem.here = rwops->hidden.mem.base;
 		rwops->hidden.mem.stop = rwops->hidden.mem.base + size;
+		rwops->type = SDL_RWOPS_MEMORY;
 	}
 	return (rwops);
 }
@@ -223,16 +509,101 @@ SDL_RWops *SDL_RWFromConstMem(const void *mem, int size) {
 		rwops->hidden.mem.base = (Uint8 *) mem;
 		rwops->hidden.mem.here = rwops->hidden.mem.base;
 		rwops->hidden.mem.stop = rwops->hidden.mem.base + size;
+		rwops->type = SDL_RWOPS_MEMORY_RO;
 	}
 	return (rwops);
 }
 
+SDL_RWops *SDL_RWFromMappedFile(const char *file, int flags) {
+#ifdef SDL_RWOPS_MMAP
+	SDL_RWops *rwops;
+	struct stat st;
+	void *base = NULL;
+	int fd;
+
+	if(!file || !*file) {
+		SDL_SetError("SDL_RWFromMappedFile(): No file specified");
+		return NULL;
+	}
+
+	fd = open(file, O_RDONLY | O_CLOEXEC);
+	if(fd < 0) {
+		SDL_SetError("Couldn't open %s", file);
+		return NULL;
+	}
+	if(fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size > 0x7FFFFFFF) {
+		SDL_SetError("Couldn't map %s", file);
+		close(fd);
+		return NULL;
+	}
+
+	/* mmap() refuses empty files, those just read as empty */
+	if(st.st_size > 0) {
+		base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(base == MAP_FAILED) {
+			SDL_SetError("Couldn't map %s", file);
+			close(fd);
+			return NULL;
+		}
+	}
+	/* The mapping keeps the file alive */
+	close(fd);
+
+#ifdef HAVE_MADVISE
+	if(base && (flags & SDL_RWMAP_SEQUENTIAL)) {
+		madvise(base, st.st_size, MADV_SEQUENTIAL);
+	}
+	if(base && (flags & SDL_RWMAP_WILLNEED)) {
+		madvise(base, st.st_size, MADV_WILLNEED);
+	}
+#endif
+
+	rwops = SDL_AllocRW();
+	if(rwops == NULL) {
+		if(base) {
+			munmap(base, st.st_size);
+		}
+		return NULL;
+	}
+	rwops->seek = mem_seek;
+	rwops->read = mem_read;
+	rwops->write = mem_writeconst;
+	rwops->close = mapped_close;
+	rwops->hidden.mem.base = (Uint8 *) base;
+	rwops->hidden.mem.here = rwops->hidden.mem.base;
+	rwops->hidden.mem.stop = rwops->hidden.mem.base + st.st_size;
+	rwops->type = SDL_RWOPS_MAPPED;
+	return (rwops);
+#else
+	SDL_SetError("SDL not compiled with mmap support");
+	return NULL;
+#endif /* SDL_RWOPS_MMAP */
+}
+
+const void *SDL_RWGetMemory(SDL_RWops *context, int *size) {
+	if(context == NULL) {
+		return NULL;
+	}
+
+	/* Applications set 'type' on their own RWops as they like, so only
+	   trust our memory and mapped streams, which all seek with mem_seek */
+	if(context->seek != mem_seek) {
+		return NULL;
+	}
+	if(size) {
+		*size = context->hidden.mem.stop - context->hidden.mem.base;
+	}
+	return (context->hidden.mem.base);
+}
+
 SDL_RWops *SDL_AllocRW(void) {
 	SDL_RWops *area;
 
 	area = (SDL_RWops *) SDL_malloc(sizeof *area);
 	if(area == NULL) {
 		SDL_OutOfMemory();
+	} else {
+		area->type = SDL_RWOPS_UNKNOWN;
 	}
 	return (area);
 }
@@ -241,47 +612,115 @@ void SDL_FreeRW(SDL_RWops *area) {
 	SDL_free(area);
 }
 
+/* SDL's own RWops are told apart by their functions rather than by type,
+   which applications are free to set on RWops of their own */
+
+Sint64 SDL_RWseek64(SDL_RWops *context, Sint64 offset, int whence) {
+#ifdef SDL_RWOPS_FD
+	if(context->seek == fd_seek) {
+		return (fd_seek64(context, offset, whence));
+	}
+#endif
+#ifdef HAVE_STDIO_H
+	if(context->seek == stdio_seek) {
+		return (stdio_seek64(context, offset, whence));
+	}
+#endif
+	if(context->seek == mem_seek) {
+		return (mem_seek64(context, offset, whence));
+	}
+	if(offset < SDL_MIN_SINT32 || offset > SDL_MAX_SINT32) {
+		SDL_SetError("File offset too large for this RWops");
+		return (-1);
+	}
+	return (context->seek(context, (int) offset, whence));
+}
+
+Sint64 SDL_RWsize(SDL_RWops *context) {
+	Sint64 pos, size;
+
+#ifdef SDL_RWOPS_FD
+	if(context->seek == fd_seek) {
+		return (fd_size(context));
+	}
+#endif
+	if(context->seek == mem_seek) {
+		return (context->hidden.mem.stop - context->hidden.mem.base);
+	}
+
+	pos = SDL_RWseek64(context, 0, RW_SEEK_CUR);
+	if(pos < 0) {
+		return (-1);
+	}
+	size = SDL_RWseek64(context, 0, RW_SEEK_END);
+	SDL_RWseek64(context, pos, RW_SEEK_SET);
+	return (size);
+}
+
+/* Scalars come straight out of memory and read-ahead buffers when they can */
+static __inline__ int rw_readscalar(SDL_RWops *src, void *value, int size) {
+	Uint8 **here = NULL;
+	Uint8 *stop = NULL;
+
+	if(src->read == mem_read) {
+		here = &src->hidden.mem.here;
+		stop = src->hidden.mem.stop;
+	}
+#ifdef SDL_RWOPS_FD
+	else if(src->read == fd_read) {
+		here = &src->hidden.fdio.here;
+		stop = src->hidden.fdio.stop;
+	}
+#endif
+	if(here && stop - *here >= size) {
+		SDL_memcpy(value, *here, size);
+		*here += size;
+		return (1);
+	}
+	return (SDL_RWread(src, value, size, 1));
+}
+
 /* Functions for dynamically reading and writing endian-specific values */
 
 Uint16 SDL_ReadLE16(SDL_RWops *src) {
 	Uint16 value;
 
-	SDL_RWread(src, &value, (sizeof value), 1);
+	rw_readscalar(src, &value, (sizeof value));
 	return (SDL_SwapLE16(value));
 }
 
 Uint16 SDL_ReadBE16(SDL_RWops *src) {
 	Uint16 value;
 
-	SDL_RWread(src, &value, (sizeof value), 1);
+	rw_readscalar(src, &value, (sizeof value));
 	return (SDL_SwapBE16(value));
 }
 
 Uint32 SDL_ReadLE32(SDL_RWops *src) {
 	Uint32 value;
 
-	SDL_RWread(src, &value, (sizeof value), 1);
+	rw_readscalar(src, &value, (sizeof value));
 	return (SDL_SwapLE32(value));
 }
 
 Uint32 SDL_ReadBE32(SDL_RWops *src) {
 	Uint32 value;
 
-	SDL_RWread(src, &value, (sizeof value), 1);
+	rw_readscalar(src, &value, (sizeof value));
 	return (SDL_SwapBE32(value));
 }
 
 Uint64 SDL_ReadLE64(SDL_RWops *src) {
 	Uint64 value;
 
-	SDL_RWread(src, &value, (sizeof value), 1);
+	rw_readscalar(src, &value, (sizeof value));
 	return (SDL_SwapLE64(value));
 }
 
 Uint64 SDL_ReadBE64(SDL_RWops *src) {
 	Uint64 value;
 
-	SDL_RWread(src, &value, (sizeof value), 1);
+	rw_readscalar(src, &value, (sizeof value));
 	return (SDL_SwapBE64(value));
 }
 
@@ -134,6 +134,7 @@ SDL_Haptic *SDL_HapticOpen(int device_index) {
 	/* Initialize the haptic device */
 	SDL_memset(haptic, 0, (sizeof *haptic));
 	haptic->index = device_index;
+	haptic->rumble_id = -1;
 	if(SDL_SYS_HapticOpen(haptic) < 0) {
 		SDL_free(haptic);
 		return NULL;
@@ -398,6 +399,22 @@ int SDL_HapticUpdateEffect(SDL_Haptic *haptic, int effect, SDL_HapticEffect *dat
 	}
 
 	SDL_memcpy(&haptic->effects[effect].effect, data, sizeof(SDL_HapticEffect));
+	haptic->effects[effect].dirty = SDL_FALSE;
+	return 0;
+}
+
+/*
+ * Uploads parameters queued with SDL_HapticQueueUpdate().
+ */
+static int UploadEffect(SDL_Haptic *haptic, struct haptic_effect *effect) {
+	if(!effect->dirty) {
+		return 0;
+	}
+	/* Stays dirty until the device took it, so the next flush retries */
+	if(SDL_SYS_HapticUpdateEffect(haptic, effect, &effect->effect) < 0) {
+		return -1;
+	}
+	effect->dirty = SDL_FALSE;
 	return 0;
 }
 
@@ -409,6 +426,11 @@ int SDL_HapticRunEffect(SDL_Haptic *haptic, int effect, Uint32 iterations) {
 		return -1;
 	}
 
+	/* Don't start it with stale parameters */
+	if(UploadEffect(haptic, &haptic->effects[effect]) < 0) {
+		return -1;
+	}
+
 	/* Run the effect */
 	if(SDL_SYS_HapticRunEffect(haptic, &haptic->effects[effect], iterations) < 0) {
 		return -1;
@@ -447,6 +469,11 @@ void SDL_HapticDestroyEffect(SDL_Haptic *haptic, int effect) {
 	}
 
 	SDL_SYS_HapticDestroyEffect(haptic, &haptic->effects[effect]);
+	haptic->effects[effect].dirty = SDL_FALSE;
+	haptic->effects[effect].queued = SDL_FALSE;
+	if(effect == haptic->rumble_id) {
+		haptic->rumble_id = -1;
+	}
 }
 
 /*
@@ -578,6 +605,241 @@ int SDL_HapticStopAll(SDL_Haptic *haptic) {
 	return SDL_SYS_HapticStopAll(haptic);
 }
 
+/*
+ * Queues new parameters for an effect.
+ */
+int SDL_HapticQueueUpdate(SDL_Haptic *haptic, int effect, SDL_HapticEffect *data) {
+	if(!ValidHaptic(haptic) || !ValidEffect(haptic, effect)) {
+		return -1;
+	}
+
+	if(haptic->effects[effect].hweffect == NULL) {
+		SDL_SetError("Haptic: Effect not created.");
+		return -1;
+	}
+
+	/* Can't change type dynamically. */
+	if(data->type != haptic->effects[effect].effect.type) {
+		SDL_SetError("Haptic: Updating effect type is illegal.");
+		return -1;
+	}
+
+	/* Only the last one before the flush matters */
+	SDL_memcpy(&haptic->effects[effect].effect, data, sizeof(SDL_HapticEffect));
+	haptic->effects[effect].dirty = SDL_TRUE;
+	return 0;
+}
+
+/*
+ * Queues a run, replacing any run or stop already queued.
+ */
+int SDL_HapticQueueRun(SDL_Haptic *haptic, int effect, Uint32 iterations) {
+	if(!ValidHaptic(haptic) || !ValidEffect(haptic, effect)) {
+		return -1;
+	}
+
+	if(haptic->effects[effect].hweffect == NULL) {
+		SDL_SetError("Haptic: Effect not created.");
+		return -1;
+	}
+
+	if(iterations == 0) {
+		SDL_SetError("Haptic: Effect must run at least once.");
+		return -1;
+	}
+
+	haptic->effects[effect].queued = SDL_TRUE;
+	haptic->effects[effect].iterations = iterations;
+	return 0;
+}
+
+/*
+ * Queues a stop, replacing any run or stop already queued.
+ */
+int SDL_HapticQueueStop(SDL_Haptic *haptic, int effect) {
+	if(!ValidHaptic(haptic) || !ValidEffect(haptic, effect)) {
+		return -1;
+	}
+
+	if(haptic->effects[effect].hweffect == NULL) {
+		SDL_SetError("Haptic: Effect not created.");
+		return -1;
+	}
+
+	haptic->effects[effect].queued = SDL_TRUE;
+	haptic->effects[effect].iterations = 0;
+	return 0;
+}
+
+/*
+ * Uploads changed effects, then sends all queued runs and stops at once.
+ */
+int SDL_HapticFlush(SDL_Haptic *haptic) {
+	struct haptic_effect **batch;
+	Uint32 *iterations;
+	int i, n, ret;
+
+	if(!ValidHaptic(haptic)) {
+		return -1;
+	}
+
+	ret = 0;
+	n = 0;
+	for (i = 0; i < haptic->neffects; i++) {
+		if(haptic->effects[i].hweffect == NULL) {
+			continue;
+		}
+		if(UploadEffect(haptic, &haptic->effects[i]) < 0) {
+			ret = -1;
+		}
+		if(haptic->effects[i].queued) {
+			++n;
+		}
+	}
+	if(n == 0) {
+		return ret;
+	}
+
+	batch = SDL_stack_alloc(struct haptic_effect *, n);
+	iterations = SDL_stack_alloc(Uint32, n);
+	if(batch == NULL || iterations == NULL) {
+		SDL_OutOfMemory();
+		return -1;
+	}
+	n = 0;
+	for (i = 0; i < haptic->neffects; i++) {
+		if(haptic->effects[i].hweffect != NULL && haptic->effects[i].queued) {
+			haptic->effects[i].queued = SDL_FALSE;
+			batch[n] = &haptic->effects[i];
+			iterations[n] = haptic->effects[i].iterations;
+			n++;
+		}
+	}
+	if(SDL_SYS_HapticRunEffects(haptic, batch, iterations, n) < 0) {
+		ret = -1;
+	}
+	SDL_stack_free(iterations);
+	SDL_stack_free(batch);
+
+	return ret;
+}
+
+/*
+ * Checks to see if rumble is supported.
+ */
+int SDL_HapticRumbleSupported(SDL_Haptic *haptic) {
+	if(!ValidHaptic(haptic)) {
+		return -1;
+	}
+
+	/* Most things can use SINE, but XInput only has LEFTRIGHT. */
+	return ((haptic->supported & (SDL_HAPTIC_SINE | SDL_HAPTIC_LEFTRIGHT)) != 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*
+ * Initializes the haptic device for simple rumble playback.
+ */
+int SDL_HapticRumbleInit(SDL_Haptic *haptic) {
+	SDL_HapticEffect *efx;
+
+	if(!ValidHaptic(haptic)) {
+		return -1;
+	}
+
+	/* Already allocated. */
+	if(haptic->rumble_id >= 0) {
+		return 0;
+	}
+
+	efx = &haptic->rumble_effect;
+	SDL_memset(efx, 0, sizeof(*efx));
+	if(haptic->supported & SDL_HAPTIC_SINE) {
+		efx->type = SDL_HAPTIC_SINE;
+		efx->periodic.direction.type = SDL_HAPTIC_CARTESIAN;
+		efx->periodic.period = 1000;
+		efx->periodic.magnitude = 0x4000;
+		efx->periodic.length = 5000;
+		efx->periodic.attack_length = 0;
+		efx->periodic.fade_length = 0;
+	} else if(haptic->supported & SDL_HAPTIC_LEFTRIGHT) {
+		efx->type = SDL_HAPTIC_LEFTRIGHT;
+		efx->leftright.length = 5000;
+		efx->leftright.large_magnitude = 0x4000;
+		efx->leftright.small_magnitude = 0x4000;
+	} else {
+		SDL_SetError("Haptic: Device doesn't support rumble");
+		return -1;
+	}
+
+	haptic->rumble_id = SDL_HapticNewEffect(haptic, &haptic->rumble_effect);
+	if(haptic->rumble_id >= 0) {
+		return 0;
+	}
+	haptic->rumble_id = -1;
+	return -1;
+}
+
+/*
+ * Runs simple rumble on a haptic device
+ */
+int SDL_HapticRumblePlay(SDL_Haptic *haptic, float strength, Uint32 length) {
+	SDL_HapticEffect *efx;
+	Sint16 magnitude;
+
+	if(!ValidHaptic(haptic)) {
+		return -1;
+	}
+
+	if(haptic->rumble_id < 0) {
+		SDL_SetError("Haptic: Rumble effect not initialized on haptic device");
+		return -1;
+	}
+
+	/* Clamp strength. */
+	if(strength > 1.0f) {
+		strength = 1.0f;
+	} else if(strength < 0.0f) {
+		strength = 0.0f;
+	}
+	magnitude = (Sint16) (32767.0f * strength);
+
+	efx = &haptic->rumble_effect;
+	if(efx->type == SDL_HAPTIC_SINE) {
+		efx->periodic.magnitude = magnitude;
+		efx->periodic.length = length;
+	} else {
+		efx->leftright.small_magnitude = efx->leftright.large_magnitude = magnitude;
+		efx->leftright.length = length;
+	}
+
+	/* The backend skips the upload when nothing changed since the last call */
+	if(SDL_HapticQueueUpdate(haptic, haptic->rumble_id, &haptic->rumble_effect) < 0) {
+		return -1;
+	}
+
+	/* Only the rumble goes out now, whatever else is queued waits for the
+	   application's own SDL_HapticFlush() */
+	haptic->effects[haptic->rumble_id].queued = SDL_FALSE;
+	return SDL_HapticRunEffect(haptic, haptic->rumble_id, 1);
+}
+
+/*
+ * Stops simple rumble on a haptic device.
+ */
+int SDL_HapticRumbleStop(SDL_Haptic *haptic) {
+	if(!ValidHaptic(haptic)) {
+		return -1;
+	}
+
+	if(haptic->rumble_id < 0) {
+		SDL_SetError("Haptic: Rumble effect not initialized on haptic device");
+		return -1;
+	}
+
+	haptic->effects[haptic->rumble_id].queued = SDL_FALSE;
+	return SDL_HapticStopEffect(haptic, haptic->rumble_id);
+}
+
 /*
  * Palm Edit: Returns minimum duration of vibration - which is 0ms;
  */
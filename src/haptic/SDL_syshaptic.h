@@ -41,6 +41,9 @@ extern Uint8 SDL_numhaptics;
 struct haptic_effect {
 	SDL_HapticEffect effect;    /* The current event */
 	struct haptic_hweffect *hweffect;   /* The hardware behind the event */
+	SDL_bool dirty;             /* effect has parameters the device doesn't */
+	SDL_bool queued;            /* A run or stop is waiting for SDL_HapticFlush() */
+	Uint32 iterations;          /* What was queued, 0 to stop */
 };
 
 /*
@@ -57,6 +60,9 @@ struct _SDL_Haptic {
 	int min_duration;
 	int max_duration;           /* Maximum supported duration for any given effect. */
 
+	int rumble_id;              /* Effect used by SDL_HapticRumblePlay(), -1 if none */
+	SDL_HapticEffect rumble_effect;
+
 	struct haptic_hwdata *hwdata;       /* Driver dependent */
 	int ref_count;              /* Count for multiple opens */
 };
@@ -143,6 +149,14 @@ extern int SDL_SYS_HapticUpdateEffect(SDL_Haptic *haptic, struct haptic_effect *
  */
 extern int SDL_SYS_HapticRunEffect(SDL_Haptic *haptic, struct haptic_effect *effect, Uint32 iterations);
 
+/*
+ * Runs and stops several effects at once, an iteration count of 0 stops
+ * the effect.
+ *
+ * Returns 0 on success, -1 on error.
+ */
+extern int SDL_SYS_HapticRunEffects(SDL_Haptic *haptic, struct haptic_effect **effects, const Uint32 *iterations, int count);
+
 /*
  * Stops the effect on the haptic device.
  *
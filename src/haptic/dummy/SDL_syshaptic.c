@@ -98,6 +98,11 @@ int SDL_SYS_HapticRunEffect(SDL_Haptic *haptic, struct haptic_effect *effect, Ui
 	return -1;
 }
 
+int SDL_SYS_HapticRunEffects(SDL_Haptic *haptic, struct haptic_effect **effects, const Uint32 *iterations, int count) {
+	SDL_SYS_LogicError();
+	return -1;
+}
+
 int SDL_SYS_HapticStopEffect(SDL_Haptic *haptic, struct haptic_effect *effect) {
 	SDL_SYS_LogicError();
 	return -1;
@@ -57,6 +57,7 @@
 #endif
 
 #define MAX_HAPTICS  32         /* It's doubtful someone has more then 32 evdev */
+#define SDL_HAPTIC_BATCH  16    /* Run/stop events sent per write() */
 
 static int MaybeAddDevice(const char *path);
 
@@ -951,6 +952,11 @@ int SDL_SYS_HapticUpdateEffect(SDL_Haptic *haptic, struct haptic_effect *effect,
 	}
 	linux_effect.id = effect->hweffect->effect.id;
 
+	/* Streamed effects often get the same parameters every frame, skip the ioctl then. */
+	if(SDL_memcmp(&linux_effect, &effect->hweffect->effect, sizeof(struct ff_effect)) == 0) {
+		return effect->hweffect->effect.id;
+	}
+
 	/* See if it can be uploaded. */
 	if(ioctl(haptic->hwdata->fd, EVIOCSFF, &linux_effect) < 0) {
 		SDL_SetError("Haptic: Error updating the effect: %s", strerror(errno));
@@ -983,6 +989,36 @@ int SDL_SYS_HapticRunEffect(SDL_Haptic *haptic, struct haptic_effect *effect, Ui
 	return 0;
 }
 
+/*
+ * Runs and stops several effects with as few writes as possible.
+ */
+int SDL_SYS_HapticRunEffects(SDL_Haptic *haptic, struct haptic_effect **effects, const Uint32 *iterations, int count) {
+	struct input_event batch[SDL_HAPTIC_BATCH];
+	int i, n;
+
+	while(count > 0) {
+		n = (count > SDL_HAPTIC_BATCH) ? SDL_HAPTIC_BATCH : count;
+		SDL_memset(batch, 0, sizeof(batch[0]) * n);
+		for (i = 0; i < n; i++) {
+			batch[i].type = EV_FF;
+			batch[i].code = effects[i]->hweffect->effect.id;
+			batch[i].value = (iterations[i] > INT_MAX) ? INT_MAX : iterations[i];
+		}
+
+		/* The evdev write handler takes any number of whole events at once. */
+		if(write(haptic->hwdata->fd, (const void *) batch, sizeof(batch[0]) * n) < 0) {
+			SDL_SetError("Haptic: Unable to run the effects: %s", strerror(errno));
+			return -1;
+		}
+
+		effects += n;
+		iterations += n;
+		count -= n;
+	}
+
+	return 0;
+}
+
 /*
  * Stops an effect.
  */
@@ -1087,18 +1123,29 @@ int SDL_SYS_HapticUnpause(SDL_Haptic *haptic) {
  * Stops all the currently playing effects.
  */
 int SDL_SYS_HapticStopAll(SDL_Haptic *haptic) {
-	int i, ret;
+	struct haptic_effect *batch[SDL_HAPTIC_BATCH];
+	Uint32 stop[SDL_HAPTIC_BATCH];
+	int i, n;
 
-	/* Linux does not support this natively so we have to loop. */
+	/* Linux does not support this natively, so stop them in batches. */
+	n = 0;
 	for (i = 0; i < haptic->neffects; i++) {
 		if(haptic->effects[i].hweffect != NULL) {
-			ret = SDL_SYS_HapticStopEffect(haptic, &haptic->effects[i]);
-			if(ret < 0) {
-				SDL_SetError("Haptic: Error while trying to stop all playing effects.");
-				return -1;
+			batch[n] = &haptic->effects[i];
+			stop[n] = 0;
+			if(++n == SDL_HAPTIC_BATCH) {
+				if(SDL_SYS_HapticRunEffects(haptic, batch, stop, n) < 0) {
+					SDL_SetError("Haptic: Error while trying to stop all playing effects.");
+					return -1;
+				}
+				n = 0;
 			}
 		}
 	}
+	if(n > 0 && SDL_SYS_HapticRunEffects(haptic, batch, stop, n) < 0) {
+		SDL_SetError("Haptic: Error while trying to stop all playing effects.");
+		return -1;
+	}
 	return 0;
 }
 
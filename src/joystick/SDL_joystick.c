@@ -62,6 +62,9 @@ SDL_Joystick **SDL_joysticks = NULL;
 
 static SDL_mutex *SDL_joystick_lock = NULL; /* This needs to support recursive locks */
 
+/* Keep SDL_JoystickUpdate() running from the event loop with no events */
+int SDL_joystick_stateonly = 0;
+
 int SDL_JoystickInit(void) {
 	int arraylen;
 	int status;
@@ -391,6 +394,47 @@ Uint8 SDL_JoystickGetButton(SDL_Joystick *joystick, int button) {
 	return (state);
 }
 
+/*
+ * Copy all controls of a joystick in one call
+ */
+int SDL_JoystickGetState(SDL_Joystick *joystick, SDL_JoystickState *state) {
+	int i;
+
+	if(!ValidJoystick(&joystick)) {
+		return (-1);
+	}
+	if(state == NULL) {
+		SDL_SetError("Parameter 'state' is invalid");
+		return (-1);
+	}
+
+	state->which = joystick->index;
+	state->naxes = SDL_min(joystick->naxes, SDL_JOYSTATE_MAX_AXES);
+	state->nhats = SDL_min(joystick->nhats, SDL_JOYSTATE_MAX_HATS);
+	state->nballs = SDL_min(joystick->nballs, SDL_JOYSTATE_MAX_BALLS);
+	state->nbuttons = SDL_min(joystick->nbuttons, SDL_JOYSTATE_MAX_BUTTONS);
+
+	/* Don't let the event thread update the joystick halfway through */
+	SDL_Lock_EventThread();
+	if(state->naxes > 0) {
+		SDL_memcpy(state->axes, joystick->axes, state->naxes * sizeof(*state->axes));
+	}
+	if(state->nhats > 0) {
+		SDL_memcpy(state->hats, joystick->hats, state->nhats * sizeof(*state->hats));
+	}
+	if(state->nbuttons > 0) {
+		SDL_memcpy(state->buttons, joystick->buttons, state->nbuttons * sizeof(*state->buttons));
+	}
+	for (i = 0; i < state->nballs; ++i) {
+		state->balls[i].dx = joystick->balls[i].dx;
+		state->balls[i].dy = joystick->balls[i].dy;
+		joystick->balls[i].dx = 0;
+		joystick->balls[i].dy = 0;
+	}
+	SDL_Unlock_EventThread();
+	return (0);
+}
+
 /*
  * Close a joystick previously opened with SDL_JoystickOpen()
  */
@@ -440,6 +484,7 @@ void SDL_JoystickClose(SDL_Joystick *joystick) {
 
 void SDL_JoystickQuit(void) {
 	const int numsticks = SDL_numjoysticks;
+	SDL_Joystick **joysticks;
 	int i;
 
 	/* Stop the event polling */
@@ -457,12 +502,17 @@ void SDL_JoystickQuit(void) {
 		}
 	}
 
+	/* Stop hotplug detection before the system part goes away */
+	SDL_Lock_EventThread();
+	joysticks = SDL_joysticks;
+	SDL_joysticks = NULL;
+	SDL_allocatedjoysticks = 0;
+	SDL_Unlock_EventThread();
+
 	/* Quit the joystick setup */
 	SDL_SYS_JoystickQuit();
-	if(SDL_joysticks) {
-		SDL_free(SDL_joysticks);
-		SDL_joysticks = NULL;
-		SDL_allocatedjoysticks = 0;
+	if(joysticks) {
+		SDL_free(joysticks);
 	}
 }
 
@@ -495,7 +545,7 @@ int SDL_PrivateJoystickAxis(SDL_Joystick *joystick, Uint8 axis, Sint16 value) {
 		event.jaxis.value = value;
 		if((SDL_EventOK == NULL) || (*SDL_EventOK)(&event)) {
 			posted = 1;
-			SDL_PushEvent(&event);
+			SDL_PushMotionEvent(&event);
 		}
 	}
 #endif /* !SDL_EVENTS_DISABLED */
@@ -604,9 +654,80 @@ int SDL_PrivateJoystickButton(SDL_Joystick *joystick, Uint8 button, Uint8 state)
 	return (posted);
 }
 
+/*
+ * Make room for a joystick that was plugged in and tell the application
+ */
+int SDL_PrivateJoystickAdded(int device_index) {
+	SDL_Joystick **joysticks;
+	int posted;
+
+	if(device_index >= SDL_allocatedjoysticks) {
+		SDL_Lock_EventThread();
+		joysticks = (SDL_Joystick **) SDL_realloc(SDL_joysticks, (device_index + 2) * sizeof(*SDL_joysticks));
+		if(joysticks) {
+			SDL_memset(&joysticks[SDL_allocatedjoysticks + 1], 0, (device_index + 1 - SDL_allocatedjoysticks) * sizeof(*SDL_joysticks));
+			SDL_joysticks = joysticks;
+			SDL_allocatedjoysticks = device_index + 1;
+		}
+		SDL_Unlock_EventThread();
+		if(!joysticks) {
+			SDL_OutOfMemory();
+			return (0);
+		}
+	}
+	if(device_index >= SDL_numjoysticks) {
+		SDL_numjoysticks = device_index + 1;
+	}
+
+	/* Post the event, if desired */
+	posted = 0;
+#if !SDL_EVENTS_DISABLED
+	if(SDL_ProcessEvents[SDL_JOYDEVICEADDED] == SDL_ENABLE) {
+		SDL_Event event;
+		event.type = SDL_JOYDEVICEADDED;
+		event.jdevice.which = device_index;
+		if((SDL_EventOK == NULL) || (*SDL_EventOK)(&event)) {
+			posted = 1;
+			SDL_PushEvent(&event);
+		}
+	}
+#endif /* !SDL_EVENTS_DISABLED */
+	return (posted);
+}
+
+/*
+ * Tell the application a joystick was unplugged. The index stays reserved
+ * for it, and an open handle just stops reporting until it is closed.
+ */
+int SDL_PrivateJoystickRemoved(int device_index) {
+	int posted;
+
+	/* Post the event, if desired */
+	posted = 0;
+#if !SDL_EVENTS_DISABLED
+	if(SDL_ProcessEvents[SDL_JOYDEVICEREMOVED] == SDL_ENABLE) {
+		SDL_Event event;
+		event.type = SDL_JOYDEVICEREMOVED;
+		event.jdevice.which = device_index;
+		if((SDL_EventOK == NULL) || (*SDL_EventOK)(&event)) {
+			posted = 1;
+			SDL_PushEvent(&event);
+		}
+	}
+#endif /* !SDL_EVENTS_DISABLED */
+	return (posted);
+}
+
 void SDL_JoystickUpdate(void) {
 	int i;
 
+	if(SDL_joysticks == NULL) {
+		return;
+	}
+
+	/* Pick up joysticks that came or went first */
+	SDL_SYS_JoystickDetect();
+
 	for (i = 0; SDL_joysticks[i]; ++i) {
 		SDL_SYS_JoystickUpdate(SDL_joysticks[i]);
 	}
@@ -622,23 +743,32 @@ int SDL_JoystickEventState(int state) {
 		SDL_JOYHATMOTION,
 		SDL_JOYBUTTONDOWN,
 		SDL_JOYBUTTONUP,
+		SDL_JOYDEVICEADDED,
+		SDL_JOYDEVICEREMOVED,
 	};
 	unsigned int i;
 
 	switch (state) {
 		case SDL_QUERY:
-			state = SDL_IGNORE;
+			state = SDL_joystick_stateonly ? SDL_JOYSTICK_STATEONLY : SDL_IGNORE;
 			for (i = 0; i < SDL_arraysize(event_list); ++i) {
-				state = SDL_EventState(event_list[i], SDL_QUERY);
-				if(state == SDL_ENABLE) {
+				if(SDL_EventState(event_list[i], SDL_QUERY) == SDL_ENABLE) {
+					state = SDL_ENABLE;
 					break;
 				}
 			}
 			break;
+		case SDL_JOYSTICK_STATEONLY:
+			for (i = 0; i < SDL_arraysize(event_list); ++i) {
+				SDL_EventState(event_list[i], SDL_IGNORE);
+			}
+			SDL_joystick_stateonly = 1;
+			break;
 		default:
 			for (i = 0; i < SDL_arraysize(event_list); ++i) {
 				SDL_EventState(event_list[i], state);
 			}
+			SDL_joystick_stateonly = 0;
 			break;
 	}
 	return (state);
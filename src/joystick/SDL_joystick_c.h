@@ -39,6 +39,9 @@
 /* The number of available joysticks on the system */
 extern Uint8 SDL_numjoysticks;
 
+/* Nonzero when joystick state is updated without posting any events */
+extern int SDL_joystick_stateonly;
+
 /* Internal event queueing functions */
 extern int SDL_PrivateJoystickAxis(SDL_Joystick *joystick, Uint8 axis, Sint16 value);
 
@@ -48,6 +51,11 @@ extern int SDL_PrivateJoystickHat(SDL_Joystick *joystick, Uint8 hat, Uint8 value
 
 extern int SDL_PrivateJoystickButton(SDL_Joystick *joystick, Uint8 button, Uint8 state);
 
+/* Hotplug notifications from the system joystick code */
+extern int SDL_PrivateJoystickAdded(int device_index);
+
+extern int SDL_PrivateJoystickRemoved(int device_index);
+
 /* Internal sanity checking functions */
 extern SDL_bool SDL_PrivateJoystickValid(SDL_Joystick *joystick);
 
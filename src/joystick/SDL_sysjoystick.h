@@ -107,6 +107,12 @@ extern int SDL_SYS_JoystickOpen(SDL_Joystick *joystick);
  */
 extern void SDL_SYS_JoystickUpdate(SDL_Joystick *joystick);
 
+/* Function to process joysticks that were plugged in or removed since the
+ * last call, reporting them with SDL_PrivateJoystickAdded() and
+ * SDL_PrivateJoystickRemoved(). Called before the joysticks are updated.
+ */
+extern void SDL_SYS_JoystickDetect(void);
+
 /* Function to close a joystick after use */
 extern void SDL_SYS_JoystickClose(SDL_Joystick *joystick);
 
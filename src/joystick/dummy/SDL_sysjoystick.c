@@ -77,6 +77,12 @@ void SDL_SYS_JoystickUpdate(SDL_Joystick *joystick)
 	return;
 }
 
+/* Function to process joysticks that were plugged in or removed */
+void SDL_SYS_JoystickDetect(void)
+{
+	return;
+}
+
 /* Function to close a joystick after use */
 void SDL_SYS_JoystickClose(SDL_Joystick *joystick)
 {
@@ -48,12 +48,29 @@
 #if SDL_INPUT_LINUXEV
 
 #include <linux/input.h>
+#include <time.h>
+
+#include "../../timer/SDL_timer_c.h"
+
+/* Older headers only have the timeval member */
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
+/* How many input events are read at once, can be changed with
+   SDL_EVDEV_READ_BATCH */
+#define DEFAULT_READ_BATCH    64
+#define MAX_READ_BATCH        256
+
+static int read_batch = DEFAULT_READ_BATCH;
 
 #endif
 
 #include "SDL_joystick.h"
 #include "../SDL_sysjoystick.h"
 #include "../SDL_joystick_c.h"
+#include "../../core/linux/SDL_udev.h"
 
 /* Special joystick configurations */
 static struct {
@@ -271,9 +288,15 @@ static struct joystick_logicalmap joystick_logicalmap[] = {
 /* The maximum number of joysticks we'll detect */
 #define MAX_JOYSTICKS    32
 
-/* A list of available joysticks */
+/* A list of available joysticks.
+   Entries are never removed while the subsystem is up, so device indices
+   stay valid. An unplugged joystick is marked gone, and a device showing
+   up on the same node later takes its index again.
+ */
 static struct {
 	char *fname;
+	dev_t devnum;        /* major/minor device number */
+	SDL_bool gone;
 #ifndef NO_LOGICAL_JOYSTICKS
 	SDL_Joystick* joy;
 	struct joystick_logicalmap* map;
@@ -283,6 +306,12 @@ static struct {
 #endif /* USE_LOGICAL_JOYSTICKS */
 } SDL_joylist[MAX_JOYSTICKS];
 
+static int numjoysticks = 0;
+
+#if SDL_USE_LIBUDEV
+static SDL_bool udev_active = SDL_FALSE;
+#endif
+
 ///* The private structure used to keep track of a joystick */
 //struct joystick_hwdata {
 //	int fd;
@@ -408,8 +437,74 @@ static int EV_IsJoystick(int fd) {
 
 #endif /* SDL_INPUT_LINUXEV */
 
-/* Function to scan the system for joysticks */
-int SDL_SYS_JoystickInit(void) {
+/* Add the device at path to the list, unless it is already there.
+   With probe set, event devices are checked for joystick capabilities.
+   Returns the device index, or -1 if it wasn't added.
+ */
+static int JoystickAddDevice(const char *path, SDL_bool probe) {
+	struct stat sb;
+	char *fname;
+	int i, fd;
+
+	if(stat(path, &sb) < 0) {
+		return (-1);
+	}
+
+	/* Check to make sure it's not already in list.
+	 * This happens when we see a stick via symlink.
+	 */
+	for (i = 0; i < numjoysticks; ++i) {
+		if(SDL_joylist[i].fname && sb.st_rdev == SDL_joylist[i].devnum) {
+			if(!SDL_joylist[i].gone) {
+				return (-1);
+			}
+			SDL_joylist[i].gone = SDL_FALSE;
+			return (i);
+		}
+	}
+	if(numjoysticks >= MAX_JOYSTICKS) {
+		return (-1);
+	}
+#ifndef NO_LOGICAL_JOYSTICKS
+#if SDL_USE_LIBUDEV
+	/* The logical joysticks were numbered after the physical ones at init,
+	   a device plugged in later would take one of their indexes.  Only
+	   devices already in the list can come back. */
+	if(udev_active) {
+		return (-1);
+	}
+#endif
+#endif
+
+	fd = open(path, O_RDONLY, 0);
+	if(fd < 0) {
+		return (-1);
+	}
+#if SDL_INPUT_LINUXEV
+#ifdef DEBUG_INPUT_EVENTS
+	printf("Checking %s\n", path);
+#endif
+	if(probe && (SDL_strncmp(path, "/dev/input/event", 16) == 0) && !EV_IsJoystick(fd)) {
+		close(fd);
+		return (-1);
+	}
+#endif
+	close(fd);
+
+	/* We're fine, add this joystick */
+	fname = SDL_strdup(path);
+	if(fname == NULL) {
+		return (-1);
+	}
+	SDL_joylist[numjoysticks].fname = fname;
+	SDL_joylist[numjoysticks].devnum = sb.st_rdev;
+	SDL_joylist[numjoysticks].gone = SDL_FALSE;
+	return (numjoysticks++);
+}
+
+/* Look for joysticks by trying every possible device node, for when
+   udev can't tell us which ones exist */
+static void JoystickProbe(void) {
 	/* The base path of the joystick devices */
 	const char *joydev_pattern[] = {
 #if SDL_INPUT_LINUXEV
@@ -418,16 +513,92 @@ int SDL_SYS_JoystickInit(void) {
 		"/dev/input/js%d",
 		"/dev/js%d"
 	};
-	int numjoysticks;
-	int i, j;
-	int fd;
 	char path[PATH_MAX];
-	dev_t dev_nums[MAX_JOYSTICKS];  /* major/minor device numbers */
-	struct stat sb;
-	int n, duplicate;
+	int i, j;
+
+	for (i = 0; i < SDL_arraysize(joydev_pattern); ++i) {
+		for (j = 0; j < MAX_JOYSTICKS; ++j) {
+			SDL_snprintf(path, SDL_arraysize(path), joydev_pattern[i], j);
+			JoystickAddDevice(path, SDL_TRUE);
+		}
+
+#if SDL_INPUT_LINUXEV
+		/* This is a special case...
+		   If the event devices are valid then the joystick devices
+		   will be duplicates but without extra information about their
+		   hats or balls. Unfortunately, the event devices can't
+		   currently be calibrated, so it's a win-lose situation.
+		   So : /dev/input/eventX = /dev/input/jsY = /dev/jsY
+		*/
+		if((i == 0) && (numjoysticks > 0)) {
+			break;
+		}
+#endif
+	}
+}
+
+#if SDL_USE_LIBUDEV
+
+static void joystick_udev_callback(SDL_UDEV_deviceevent udev_type, int udev_class, const char *devpath) {
+	int i;
+
+	if(devpath == NULL || !(udev_class & SDL_UDEV_DEVICE_JOYSTICK)) {
+		return;
+	}
+
+	/* udev reports both nodes of a joystick, only keep the richer one */
+#if SDL_INPUT_LINUXEV
+	if(SDL_strncmp(devpath, "/dev/input/event", 16) != 0) {
+		return;
+	}
+#else
+	if(SDL_strncmp(devpath, "/dev/input/js", 13) != 0) {
+		return;
+	}
+#endif
 
+	switch (udev_type) {
+		case SDL_UDEV_DEVICEADDED:
+			i = JoystickAddDevice(devpath, SDL_TRUE);
+			if(i >= 0 && udev_active) {
+				SDL_PrivateJoystickAdded(i);
+			}
+			break;
+
+		case SDL_UDEV_DEVICEREMOVED:
+			for (i = 0; i < numjoysticks; ++i) {
+				if(SDL_joylist[i].fname && !SDL_joylist[i].gone && SDL_strcmp(SDL_joylist[i].fname, devpath) == 0) {
+					SDL_joylist[i].gone = SDL_TRUE;
+					if(udev_active) {
+						SDL_PrivateJoystickRemoved(i);
+					}
+					break;
+				}
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+#endif /* SDL_USE_LIBUDEV */
+
+/* Function to scan the system for joysticks */
+int SDL_SYS_JoystickInit(void) {
 	numjoysticks = 0;
 
+#if SDL_INPUT_LINUXEV
+	if(SDL_getenv("SDL_EVDEV_READ_BATCH")) {
+		read_batch = SDL_atoi(SDL_getenv("SDL_EVDEV_READ_BATCH"));
+		if(read_batch < 1) {
+			read_batch = 1;
+		} else if(read_batch > MAX_READ_BATCH) {
+			read_batch = MAX_READ_BATCH;
+		}
+	}
+#endif
+
 	/* First see if the user specified one or more joysticks to use */
 	if(SDL_getenv("SDL_JOYSTICK_DEVICE") != NULL) {
 		char *envcopy, *envpath, *delim;
@@ -438,81 +609,29 @@ int SDL_SYS_JoystickInit(void) {
 			if(delim != NULL) {
 				*delim++ = '\0';
 			}
-			if(stat(envpath, &sb) == 0) {
-				fd = open(envpath, O_RDONLY, 0);
-				if(fd >= 0) {
-					/* Assume the user knows what they're doing. */
-					SDL_joylist[numjoysticks].fname = SDL_strdup(envpath);
-					if(SDL_joylist[numjoysticks].fname) {
-						dev_nums[numjoysticks] = sb.st_rdev;
-						++numjoysticks;
-					}
-					close(fd);
-				}
-			}
+			/* Assume the user knows what they're doing. */
+			JoystickAddDevice(envpath, SDL_FALSE);
 			envpath = delim;
 		}
 		SDL_free(envcopy);
 	}
 
-	for (i = 0; i < SDL_arraysize(joydev_pattern); ++i) {
-		for (j = 0; j < MAX_JOYSTICKS; ++j) {
-			SDL_snprintf(path, SDL_arraysize(path), joydev_pattern[i], j);
-
-			/* rcg06302000 replaced access(F_OK) call with stat().
-			 * stat() will fail if the file doesn't exist, so it's
-			 * equivalent behaviour.
-			 */
-			if(stat(path, &sb) == 0) {
-				/* Check to make sure it's not already in list.
-				 * This happens when we see a stick via symlink.
-				 */
-				duplicate = 0;
-				for (n = 0; (n < numjoysticks) && !duplicate; ++n) {
-					if(sb.st_rdev == dev_nums[n]) {
-						duplicate = 1;
-					}
-				}
-				if(duplicate) {
-					continue;
-				}
-
-				fd = open(path, O_RDONLY, 0);
-				if(fd < 0) {
-					continue;
-				}
-#if SDL_INPUT_LINUXEV
-#ifdef DEBUG_INPUT_EVENTS
-				printf("Checking %s\n", path);
-#endif
-				if((i == 0) && !EV_IsJoystick(fd)) {
-					close(fd);
-					continue;
-				}
-#endif
-				close(fd);
-
-				/* We're fine, add this joystick */
-				SDL_joylist[numjoysticks].fname = SDL_strdup(path);
-				if(SDL_joylist[numjoysticks].fname) {
-					dev_nums[numjoysticks] = sb.st_rdev;
-					++numjoysticks;
-				}
-			}
-		}
-
-#if SDL_INPUT_LINUXEV
-		/* This is a special case...
-		   If the event devices are valid then the joystick devices
-		   will be duplicates but without extra information about their
-		   hats or balls. Unfortunately, the event devices can't
-		   currently be calibrated, so it's a win-lose situation.
-		   So : /dev/input/eventX = /dev/input/jsY = /dev/jsY
-		*/
-		if((i == 0) && (numjoysticks > 0)) {
-			break;
+#if SDL_USE_LIBUDEV
+	/* Let udev tell us about the joysticks, now and when they come and go */
+	if(SDL_UDEV_Init() == 0) {
+		if(SDL_UDEV_AddCallback(joystick_udev_callback) < 0) {
+			SDL_UDEV_Quit();
+		} else {
+			/* The core doesn't know about any joysticks yet, so the ones
+			   found now are only counted in what we return */
+			SDL_UDEV_Scan();
+			udev_active = SDL_TRUE;
 		}
+	}
+	if(!udev_active)
 #endif
+	{
+		JoystickProbe();
 	}
 #ifndef NO_LOGICAL_JOYSTICKS
 	numjoysticks += CountLogicalJoysticks(numjoysticks);
@@ -521,6 +640,15 @@ int SDL_SYS_JoystickInit(void) {
 	return (numjoysticks);
 }
 
+/* Function to process joysticks that were plugged in or removed */
+void SDL_SYS_JoystickDetect(void) {
+#if SDL_USE_LIBUDEV
+	if(udev_active) {
+		SDL_UDEV_Poll();
+	}
+#endif
+}
+
 /* Function to get the device-dependent name of a joystick */
 const char *SDL_SYS_JoystickName(int index) {
 	int fd;
@@ -844,7 +972,13 @@ int SDL_SYS_JoystickOpen(SDL_Joystick *joystick) {
 	} else
 #endif
 #if SDL_INPUT_LINUXEV
-	if(!EV_ConfigJoystick(joystick, fd))
+	if(EV_ConfigJoystick(joystick, fd)) {
+		int clock_id = CLOCK_MONOTONIC;
+
+		/* Have the kernel stamp events on the clock ticks are based on */
+		joystick->hwdata->monotonic = (ioctl(fd, EVIOCSCLOCKID, &clock_id) == 0);
+		SDL_AddInputCounter(&joystick->hwdata->rate, SDL_joylist[joystick->index].fname);
+	} else
 #endif
 	{
 		JS_ConfigJoystick(joystick, fd);
@@ -1074,10 +1208,38 @@ static __inline__ int EV_AxisCorrect(SDL_Joystick *joystick, int which, int valu
 	return value;
 }
 
+/* An analog stick reports every axis sample as it comes, so only the
+   last value of each axis in a report is kept and posted at SYN_REPORT */
+static __inline__ void EV_QueueAxis(SDL_Joystick *joystick, int code, int value) {
+	struct joystick_hwdata *hwdata = joystick->hwdata;
+
+	hwdata->abs_pending[code] = value;
+	if(!hwdata->abs_is_pending[code]) {
+		hwdata->abs_is_pending[code] = SDL_TRUE;
+		hwdata->abs_pending_codes[hwdata->abs_npending++] = code;
+	}
+}
+
+static void EV_FlushAxes(SDL_Joystick *joystick) {
+	struct joystick_hwdata *hwdata = joystick->hwdata;
+	int i, code, value;
+
+	for (i = 0; i < hwdata->abs_npending; ++i) {
+		code = hwdata->abs_pending_codes[i];
+		hwdata->abs_is_pending[code] = SDL_FALSE;
+		value = EV_AxisCorrect(joystick, code, hwdata->abs_pending[code]);
+#ifndef NO_LOGICAL_JOYSTICKS
+		if (!LogicalJoystickAxis(joystick, hwdata->abs_map[code], value))
+#endif
+		SDL_PrivateJoystickAxis(joystick, hwdata->abs_map[code], value);
+	}
+	hwdata->abs_npending = 0;
+}
+
 static __inline__ void EV_HandleEvents(SDL_Joystick *joystick) {
-	struct input_event events[32];
+	struct input_event events[MAX_READ_BATCH];
 	int i, len;
-	int code;
+	int code, reports;
 
 #ifndef NO_LOGICAL_JOYSTICKS
 	if (SDL_joylist[joystick->index].fname == NULL) {
@@ -1086,10 +1248,14 @@ static __inline__ void EV_HandleEvents(SDL_Joystick *joystick) {
 	}
 #endif
 
-	while ((len = read(joystick->hwdata->fd, events, (sizeof events))) > 0) {
+	while ((len = read(joystick->hwdata->fd, events, read_batch * sizeof(events[0]))) > 0) {
 		len /= sizeof(events[0]);
+		reports = 0;
 		for (i = 0; i < len; ++i) {
 			code = events[i].code;
+			if(joystick->hwdata->monotonic) {
+				SDL_SetEventTimestamp(SDL_MonotonicToTicks(events[i].input_event_sec, events[i].input_event_usec));
+			}
 			switch (events[i].type) {
 				case EV_KEY:
 					if(code >= BTN_MISC) {
@@ -1120,13 +1286,7 @@ static __inline__ void EV_HandleEvents(SDL_Joystick *joystick) {
 							break;
 						default:
 							if(joystick->hwdata->abs_map[code] != ABS_MAX) {
-								events[i].value = EV_AxisCorrect(joystick, code, events[i].value);
-#ifndef NO_LOGICAL_JOYSTICKS
-								if (!LogicalJoystickAxis(joystick,
-									 joystick->hwdata->abs_map[code],
-								 events[i].value))
-#endif
-								SDL_PrivateJoystickAxis(joystick, joystick->hwdata->abs_map[code], events[i].value);
+								EV_QueueAxis(joystick, code, events[i].value);
 							}
 							break;
 					}
@@ -1142,11 +1302,25 @@ static __inline__ void EV_HandleEvents(SDL_Joystick *joystick) {
 							break;
 					}
 					break;
+				case EV_SYN:
+					if(code == SYN_REPORT) {
+						EV_FlushAxes(joystick);
+						++reports;
+					}
+					break;
 				default:
 					break;
 			}
 		}
+		SDL_CountInput(&joystick->hwdata->rate, len, reports);
+
+		/* A short read means the device has been drained */
+		if(len < read_batch) {
+			break;
+		}
 	}
+	EV_FlushAxes(joystick);
+	SDL_SetEventTimestamp(0);
 }
 
 #endif /* SDL_INPUT_LINUXEV */
@@ -1194,6 +1368,11 @@ void SDL_SYS_JoystickClose(SDL_Joystick *joystick) {
 		{
 			close(joystick->hwdata->fd);
 		}
+#if SDL_INPUT_LINUXEV
+		if(joystick->hwdata->is_hid) {
+			SDL_DelInputCounter(&joystick->hwdata->rate);
+		}
+#endif
 		if(joystick->hwdata->hats) {
 			SDL_free(joystick->hwdata->hats);
 		}
@@ -1209,15 +1388,26 @@ void SDL_SYS_JoystickClose(SDL_Joystick *joystick) {
 void SDL_SYS_JoystickQuit(void) {
 	int i;
 
-	for (i = 0; SDL_joylist[i].fname; ++i) {
-		SDL_free(SDL_joylist[i].fname);
-		SDL_joylist[i].fname = NULL;
+#if SDL_USE_LIBUDEV
+	if(udev_active) {
+		SDL_UDEV_DelCallback(joystick_udev_callback);
+		SDL_UDEV_Quit();
+		udev_active = SDL_FALSE;
 	}
+#endif
+
+	for (i = 0; i < MAX_JOYSTICKS; ++i) {
+		if(SDL_joylist[i].fname) {
+			SDL_free(SDL_joylist[i].fname);
+			SDL_joylist[i].fname = NULL;
+		}
+	}
+	numjoysticks = 0;
 }
 
 
 static void LINUX_JoystickDetect(void) {
-
+	SDL_SYS_JoystickDetect();
 }
 
 static int LINUX_JoystickInit(void) {
@@ -1225,7 +1415,7 @@ static int LINUX_JoystickInit(void) {
 }
 
 static int LINUX_JoystickGetCount(void) {
-	return 1;
+	return numjoysticks;
 }
 
 SDL_JoystickDriver SDL_LINUX_JoystickDriver = {
@@ -34,6 +34,8 @@
 #include <linux/input.h>
 #include <SDL_joystick.h>
 
+#include "../../events/SDL_events_c.h"
+
 struct SDL_joylist_item;
 
 /* The private structure used to keep track of a joystick */
@@ -69,6 +71,16 @@ struct joystick_hwdata {
 		int coef[3];
 	} abs_correct[ABS_MAX];
 
+	/* Event timestamps and report rate of event devices */
+	SDL_bool monotonic;
+	SDL_InputCounter rate;
+
+	/* Axis values read since the last SYN_REPORT, posted together */
+	int abs_pending[ABS_MAX];
+	SDL_bool abs_is_pending[ABS_MAX];
+	Uint8 abs_pending_codes[ABS_MAX];
+	int abs_npending;
+
 	SDL_bool fresh;
 	SDL_bool recovering_from_dropped;
 
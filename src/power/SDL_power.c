@@ -36,6 +36,10 @@
 #include "SDL_config.h"
 
 #include "SDL_power.h"
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
 #include "SDL_syspower.h"
 
 /*
@@ -70,11 +74,115 @@ static SDL_GetPowerInfo_Impl implementations[] = {
 };
 #endif
 
-SDL_PowerState SDL_GetPowerInfo(int *seconds, int *percent) {
 #ifndef SDL_POWER_DISABLED
+/* Asks the platform code, in order of preference. */
+static SDL_PowerState SDL_SamplePowerInfo(int *seconds, int *percent) {
 	const int total = sizeof(implementations) / sizeof(implementations[0]);
 	SDL_PowerState retval = SDL_POWERSTATE_UNKNOWN;
 	int i;
+
+	for (i = 0; i < total; i++) {
+		if(implementations[i](&retval, seconds, percent)) {
+			return retval;
+		}
+	}
+
+	/* nothing was definitive. */
+	*seconds = -1;
+	*percent = -1;
+	return SDL_POWERSTATE_UNKNOWN;
+}
+
+/*
+ * The last sample, published as a seqlock: the sequence is odd while a
+ * writer is in the middle of an update and readers retry until they see
+ * the same even value before and after copying.
+ */
+#define SDL_POWER_DEFAULT_MAXAGE  5000   /* ms, override with SDL_POWER_MAXAGE */
+
+static struct {
+	SDL_atomic_t seq;
+	SDL_SpinLock writer;
+	volatile int state;
+	volatile int seconds;
+	volatile int percent;
+	volatile Uint32 stamp;
+} power_cache;
+
+static int power_maxage = -1;
+
+#if !SDL_THREADS_DISABLED
+static SDL_atomic_t power_started;
+static SDL_Thread *power_thread = NULL;
+static SDL_sem *power_quit = NULL;
+#endif
+
+static void SDL_PublishPowerInfo(SDL_PowerState state, int seconds, int percent) {
+	SDL_AtomicLock(&power_cache.writer);
+	SDL_AtomicAdd(&power_cache.seq, 1);
+	power_cache.state = state;
+	power_cache.seconds = seconds;
+	power_cache.percent = percent;
+	power_cache.stamp = SDL_GetTicks();
+	SDL_AtomicAdd(&power_cache.seq, 1);
+	SDL_AtomicUnlock(&power_cache.writer);
+}
+
+/* Returns SDL_FALSE if nothing was published yet. */
+static SDL_bool SDL_ReadPowerInfo(SDL_PowerState *state, int *seconds, int *percent, Uint32 *stamp) {
+	int seq;
+
+	do {
+		seq = SDL_AtomicGet(&power_cache.seq);
+		if(seq == 0) {
+			return SDL_FALSE;
+		}
+		SDL_MemoryBarrierAcquire();
+		*state = (SDL_PowerState) power_cache.state;
+		*seconds = power_cache.seconds;
+		*percent = power_cache.percent;
+		*stamp = power_cache.stamp;
+		SDL_MemoryBarrierAcquire();
+	} while ((seq & 1) || seq != SDL_AtomicGet(&power_cache.seq));
+
+	return SDL_TRUE;
+}
+
+#if !SDL_THREADS_DISABLED
+/* Keeps the cache at most half a max-age old so readers never wait. */
+static int SDLCALL SDL_PowerThread(void *data) {
+	Uint32 interval = (Uint32) power_maxage / 2;
+	SDL_PowerState state;
+	int seconds, percent;
+
+	while (SDL_SemWaitTimeout(power_quit, interval ? interval : 1) == SDL_MUTEX_TIMEDOUT) {
+		state = SDL_SamplePowerInfo(&seconds, &percent);
+		SDL_PublishPowerInfo(state, seconds, percent);
+	}
+	return 0;
+}
+
+static void SDL_StartPowerThread(void) {
+	if(!SDL_AtomicCAS(&power_started, 0, 1)) {
+		return;
+	}
+	power_quit = SDL_CreateSemaphore(0);
+	if(power_quit != NULL) {
+		power_thread = SDL_CreateThread(SDL_PowerThread, NULL);
+		if(power_thread == NULL) {
+			SDL_DestroySemaphore(power_quit);
+			power_quit = NULL;
+		}
+	}
+}
+#endif /* !SDL_THREADS_DISABLED */
+#endif /* !SDL_POWER_DISABLED */
+
+SDL_PowerState SDL_GetPowerInfo(int *seconds, int *percent) {
+#ifndef SDL_POWER_DISABLED
+	SDL_PowerState retval;
+	Uint32 stamp;
+	const char *env;
 #endif
 
 	int _seconds, _percent;
@@ -87,15 +195,64 @@ SDL_PowerState SDL_GetPowerInfo(int *seconds, int *percent) {
 	}
 
 #ifndef SDL_POWER_DISABLED
-	for (i = 0; i < total; i++) {
-		if(implementations[i](&retval, seconds, percent)) {
+	if(power_maxage < 0) {
+		env = SDL_getenv("SDL_POWER_MAXAGE");
+		power_maxage = env ? SDL_atoi(env) : SDL_POWER_DEFAULT_MAXAGE;
+		if(power_maxage < 0) {
+			power_maxage = 0;
+		}
+	}
+
+	/* SDL_POWER_MAXAGE=0 asks the platform on every call, as before */
+	if(power_maxage == 0) {
+		return SDL_SamplePowerInfo(seconds, percent);
+	}
+
+	if(SDL_ReadPowerInfo(&retval, seconds, percent, &stamp)) {
+#if !SDL_THREADS_DISABLED
+		/* The refresh thread owns the cache once it runs */
+		if(power_thread != NULL) {
+			return retval;
+		}
+#endif
+		if((Uint32) (SDL_GetTicks() - stamp) <= (Uint32) power_maxage) {
 			return retval;
 		}
 	}
+
+	/* First call, or no thread to keep the cache warm */
+	retval = SDL_SamplePowerInfo(seconds, percent);
+	SDL_PublishPowerInfo(retval, *seconds, *percent);
+#if !SDL_THREADS_DISABLED
+	SDL_StartPowerThread();
 #endif
+	return retval;
+#else
 	/* nothing was definitive. */
 	*seconds = -1;
 	*percent = -1;
 	return SDL_POWERSTATE_UNKNOWN;
+#endif
 }
 
+/*
+ * Stops the refresh thread and forgets the cached state.
+ */
+void SDL_PowerQuit(void) {
+#ifndef SDL_POWER_DISABLED
+#if !SDL_THREADS_DISABLED
+	if(power_thread != NULL) {
+		SDL_SemPost(power_quit);
+		SDL_WaitThread(power_thread, NULL);
+		power_thread = NULL;
+	}
+	if(power_quit != NULL) {
+		SDL_DestroySemaphore(power_quit);
+		power_quit = NULL;
+	}
+	SDL_AtomicSet(&power_started, 0);
+#endif
+	SDL_AtomicSet(&power_cache.seq, 0);
+	power_maxage = -1;
+#endif
+}
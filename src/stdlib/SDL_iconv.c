@@ -35,38 +35,6 @@
 #include "SDL_stdinc.h"
 #include "SDL_endian.h"
 
-#ifdef HAVE_ICONV
-
-/* Depending on which standard the iconv() was implemented with,
-   iconv() may or may not use const char ** for the inbuf param.
-   If we get this wrong, it's just a warning, so no big deal.
-*/
-#include <errno.h>
-
-size_t SDL_iconv(SDL_iconv_t cd, const char **inbuf, size_t *inbytesleft, char **outbuf, size_t *outbytesleft) {
-	size_t retCode;
-#ifdef ICONV_INBUF_NONCONST
-	retCode = iconv(cd, (char **) inbuf, inbytesleft, outbuf, outbytesleft);
-#else
-	retCode = iconv(cd, inbuf, inbytesleft, outbuf, outbytesleft);
-#endif
-	if(retCode == (size_t) - 1) {
-		switch (errno) {
-			case E2BIG:
-				return SDL_ICONV_E2BIG;
-			case EILSEQ:
-				return SDL_ICONV_EILSEQ;
-			case EINVAL:
-				return SDL_ICONV_EINVAL;
-			default:
-				return SDL_ICONV_ERROR;
-		}
-	}
-	return retCode;
-}
-
-#else
-
 /* Lots of useful information on Unicode at:
 	http://www.cl.cam.ac.uk/~mgk25/unicode.html
 */
@@ -163,6 +131,474 @@ static const char *getlocale(char *buffer, size_t bufsize) {
 	return buffer;
 }
 
+/* Look up an encoding by name, an empty name meaning the locale's */
+static int getencoding(const char *code) {
+	char buffer[64];
+	int i;
+
+	if(!code || !*code) {
+		code = getlocale(buffer, sizeof(buffer));
+	}
+	for (i = 0; i < SDL_arraysize(encodings); ++i) {
+		if(SDL_strcasecmp(code, encodings[i].name) == 0) {
+			return encodings[i].format;
+		}
+	}
+	return ENCODING_UNKNOWN;
+}
+
+/* Bulk converters between UTF-8 and the native Unicode forms.  Text is
+   mostly ASCII, so runs of it are checked and converted 16 bytes at a
+   time with SSE2 or a word at a time otherwise, and only the rest goes
+   through the decoder.
+*/
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define SDL_ICONV_SSE2 1
+#endif
+
+#define ASCII_MASK32    0x80808080U
+
+/* Length of the run of ASCII bytes at the start of src */
+static size_t ascii_length(const Uint8 *src, size_t len) {
+	size_t i = 0;
+
+#ifdef SDL_ICONV_SSE2
+	for (; i + 16 <= len; i += 16) {
+		int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) (src + i)));
+		if(mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+#else
+	for (; i + 8 <= len; i += 8) {
+		Uint32 a, b;
+		SDL_memcpy(&a, src + i, 4);
+		SDL_memcpy(&b, src + i + 4, 4);
+		if((a | b) & ASCII_MASK32) {
+			break;
+		}
+	}
+#endif
+	while (i < len && src[i] < 0x80) {
+		++i;
+	}
+	return i;
+}
+
+/* Widen the leading ASCII bytes of src, returns how many there were */
+static size_t ascii_to16(Uint16 *dst, const Uint8 *src, size_t len) {
+	size_t i = 0;
+
+#ifdef SDL_ICONV_SSE2
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+		if(_mm_movemask_epi8(v)) {
+			break;
+		}
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_unpacklo_epi8(v, zero));
+		_mm_storeu_si128((__m128i *) (dst + i + 8), _mm_unpackhi_epi8(v, zero));
+	}
+#else
+	size_t run = ascii_length(src, len);
+
+	for (; i < run; ++i) {
+		dst[i] = src[i];
+	}
+#endif
+	while (i < len && src[i] < 0x80) {
+		dst[i] = src[i];
+		++i;
+	}
+	return i;
+}
+
+static size_t ascii_to32(Uint32 *dst, const Uint8 *src, size_t len) {
+	size_t i = 0;
+
+#ifdef SDL_ICONV_SSE2
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i lo, hi;
+		if(_mm_movemask_epi8(v)) {
+			break;
+		}
+		lo = _mm_unpacklo_epi8(v, zero);
+		hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *) (dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *) (dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i *) (dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+#else
+	size_t run = ascii_length(src, len);
+
+	for (; i < run; ++i) {
+		dst[i] = src[i];
+	}
+#endif
+	while (i < len && src[i] < 0x80) {
+		dst[i] = src[i];
+		++i;
+	}
+	return i;
+}
+
+/* Narrow the leading ASCII units of src, dst may be NULL to just count */
+static size_t ascii_from16(Uint8 *dst, const Uint16 *src, size_t len) {
+	size_t i = 0;
+
+#ifdef SDL_ICONV_SSE2
+	const __m128i high = _mm_set1_epi16((short) 0xFF80);
+
+	for (; i + 16 <= len; i += 16) {
+		__m128i a = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i b = _mm_loadu_si128((const __m128i *) (src + i + 8));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), high), _mm_setzero_si128())) != 0xFFFF) {
+			break;
+		}
+		if(dst) {
+			_mm_storeu_si128((__m128i *) (dst + i), _mm_packus_epi16(a, b));
+		}
+	}
+#else
+	for (; i + 4 <= len; i += 4) {
+		if((src[i] | src[i + 1] | src[i + 2] | src[i + 3]) >= 0x80) {
+			break;
+		}
+		if(dst) {
+			dst[i] = (Uint8) src[i];
+			dst[i + 1] = (Uint8) src[i + 1];
+			dst[i + 2] = (Uint8) src[i + 2];
+			dst[i + 3] = (Uint8) src[i + 3];
+		}
+	}
+#endif
+	while (i < len && src[i] < 0x80) {
+		if(dst) {
+			dst[i] = (Uint8) src[i];
+		}
+		++i;
+	}
+	return i;
+}
+
+static size_t ascii_from32(Uint8 *dst, const Uint32 *src, size_t len) {
+	size_t i = 0;
+
+#ifdef SDL_ICONV_SSE2
+	const __m128i high = _mm_set1_epi32((int) 0xFFFFFF80);
+
+	for (; i + 8 <= len; i += 8) {
+		__m128i a = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i b = _mm_loadu_si128((const __m128i *) (src + i + 4));
+		__m128i w;
+		if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(a, b), high), _mm_setzero_si128())) != 0xFFFF) {
+			break;
+		}
+		if(dst) {
+			w = _mm_packs_epi32(a, b);
+			_mm_storel_epi64((__m128i *) (dst + i), _mm_packus_epi16(w, w));
+		}
+	}
+#else
+	for (; i + 4 <= len; i += 4) {
+		if((src[i] | src[i + 1] | src[i + 2] | src[i + 3]) >= 0x80) {
+			break;
+		}
+		if(dst) {
+			dst[i] = (Uint8) src[i];
+			dst[i + 1] = (Uint8) src[i + 1];
+			dst[i + 2] = (Uint8) src[i + 2];
+			dst[i + 3] = (Uint8) src[i + 3];
+		}
+	}
+#endif
+	while (i < len && src[i] < 0x80) {
+		if(dst) {
+			dst[i] = (Uint8) src[i];
+		}
+		++i;
+	}
+	return i;
+}
+
+/* Decode the non-ASCII sequence at src into ch, returns the bytes used.
+   Like SDL_iconv(), bad sequences become UNKNOWN_UNICODE. */
+static size_t utf8_decode(const Uint8 *src, size_t len, Uint32 *ch) {
+	size_t need, i;
+	Uint32 c = src[0], min;
+
+	if(c >= 0xC2 && c <= 0xDF) {
+		need = 1;
+		c &= 0x1F;
+		min = 0x80;
+	} else if(c >= 0xE0 && c <= 0xEF) {
+		need = 2;
+		c &= 0x0F;
+		min = 0x800;
+	} else if(c >= 0xF0 && c <= 0xF4) {
+		need = 3;
+		c &= 0x07;
+		min = 0x10000;
+	} else {
+		*ch = UNKNOWN_UNICODE;
+		return 1;
+	}
+	for (i = 1; i <= need; ++i) {
+		if(i >= len || (src[i] & 0xC0) != 0x80) {
+			*ch = UNKNOWN_UNICODE;
+			return i;
+		}
+		c = (c << 6) | (src[i] & 0x3F);
+	}
+	if(c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF) || c == 0xFFFE || c == 0xFFFF) {
+		c = UNKNOWN_UNICODE;
+	}
+	*ch = c;
+	return i;
+}
+
+/* Append ch as UTF-8 if it fits, returns its length either way */
+static size_t utf8_encode(Uint32 ch, Uint8 *dst, size_t room) {
+	if(ch > 0x10FFFF || (ch >= 0xD800 && ch <= 0xDFFF)) {
+		ch = UNKNOWN_UNICODE;
+	}
+	if(ch <= 0x7F) {
+		if(dst && room >= 1) {
+			dst[0] = (Uint8) ch;
+		}
+		return 1;
+	} else if(ch <= 0x7FF) {
+		if(dst && room >= 2) {
+			dst[0] = 0xC0 | (Uint8) (ch >> 6);
+			dst[1] = 0x80 | (Uint8) (ch & 0x3F);
+		}
+		return 2;
+	} else if(ch <= 0xFFFF) {
+		if(dst && room >= 3) {
+			dst[0] = 0xE0 | (Uint8) (ch >> 12);
+			dst[1] = 0x80 | (Uint8) ((ch >> 6) & 0x3F);
+			dst[2] = 0x80 | (Uint8) (ch & 0x3F);
+		}
+		return 3;
+	}
+	if(dst && room >= 4) {
+		dst[0] = 0xF0 | (Uint8) (ch >> 18);
+		dst[1] = 0x80 | (Uint8) ((ch >> 12) & 0x3F);
+		dst[2] = 0x80 | (Uint8) ((ch >> 6) & 0x3F);
+		dst[3] = 0x80 | (Uint8) (ch & 0x3F);
+	}
+	return 4;
+}
+
+/* UCS-2 has no surrogates, characters past it become UNKNOWN_UNICODE */
+static size_t utf8_to_utf16(const char *src, size_t srclen, Uint16 *dst, size_t dstlen, SDL_bool ucs2) {
+	const Uint8 *s = (const Uint8 *) src, *end = s + srclen;
+	size_t n = 0, run;
+	Uint32 ch;
+
+	if(!dst) {
+		dstlen = 0;
+	}
+	while (s < end) {
+		if(*s < 0x80) {
+			if(n < dstlen) {
+				run = ascii_to16(dst + n, s, SDL_min((size_t) (end - s), dstlen - n));
+			} else {
+				run = ascii_length(s, end - s);
+			}
+			s += run;
+			n += run;
+			continue;
+		}
+		s += utf8_decode(s, end - s, &ch);
+		if(ch < 0x10000 || ucs2) {
+			if(n < dstlen) {
+				dst[n] = (ch < 0x10000) ? (Uint16) ch : UNKNOWN_UNICODE;
+			}
+			++n;
+		} else {
+			if(n + 2 <= dstlen) {
+				ch -= 0x10000;
+				dst[n] = 0xD800 | (Uint16) (ch >> 10);
+				dst[n + 1] = 0xDC00 | (Uint16) (ch & 0x3FF);
+			}
+			n += 2;
+		}
+	}
+	return n;
+}
+
+size_t SDL_UTF8ToUTF16(const char *src, size_t srclen, Uint16 *dst, size_t dstlen) {
+	return utf8_to_utf16(src, srclen, dst, dstlen, SDL_FALSE);
+}
+
+size_t SDL_UTF16ToUTF8(const Uint16 *src, size_t srclen, char *dst, size_t dstlen) {
+	const Uint16 *s = src, *end = src + srclen;
+	Uint8 *d = (Uint8 *) dst;
+	size_t n = 0, run;
+	Uint32 ch;
+
+	if(!dst) {
+		dstlen = 0;
+	}
+	while (s < end) {
+		if(*s < 0x80) {
+			run = ascii_from16(NULL, s, end - s);
+			if(n < dstlen) {
+				ascii_from16(d + n, s, SDL_min(run, dstlen - n));
+			}
+			s += run;
+			n += run;
+			continue;
+		}
+		ch = *s++;
+		if(ch >= 0xD800 && ch <= 0xDBFF && s < end && *s >= 0xDC00 && *s <= 0xDFFF) {
+			ch = (((ch & 0x3FF) << 10) | (*s++ & 0x3FF)) + 0x10000;
+		}
+		n += utf8_encode(ch, (n < dstlen) ? d + n : NULL, dstlen - n);
+	}
+	return n;
+}
+
+size_t SDL_UTF8ToUCS4(const char *src, size_t srclen, Uint32 *dst, size_t dstlen) {
+	const Uint8 *s = (const Uint8 *) src, *end = s + srclen;
+	size_t n = 0, run;
+	Uint32 ch;
+
+	if(!dst) {
+		dstlen = 0;
+	}
+	while (s < end) {
+		if(*s < 0x80) {
+			if(n < dstlen) {
+				run = ascii_to32(dst + n, s, SDL_min((size_t) (end - s), dstlen - n));
+			} else {
+				run = ascii_length(s, end - s);
+			}
+			s += run;
+			n += run;
+			continue;
+		}
+		s += utf8_decode(s, end - s, &ch);
+		if(n < dstlen) {
+			dst[n] = ch;
+		}
+		++n;
+	}
+	return n;
+}
+
+size_t SDL_UCS4ToUTF8(const Uint32 *src, size_t srclen, char *dst, size_t dstlen) {
+	const Uint32 *s = src, *end = src + srclen;
+	Uint8 *d = (Uint8 *) dst;
+	size_t n = 0, run;
+
+	if(!dst) {
+		dstlen = 0;
+	}
+	while (s < end) {
+		if(*s < 0x80) {
+			run = ascii_from32(NULL, s, end - s);
+			if(n < dstlen) {
+				ascii_from32(d + n, s, SDL_min(run, dstlen - n));
+			}
+			s += run;
+			n += run;
+			continue;
+		}
+		n += utf8_encode(*s++, (n < dstlen) ? d + n : NULL, dstlen - n);
+	}
+	return n;
+}
+
+size_t SDL_UTF8ToLatin1(const char *src, size_t srclen, char *dst, size_t dstlen) {
+	const Uint8 *s = (const Uint8 *) src, *end = s + srclen;
+	size_t n = 0, run;
+	Uint32 ch;
+
+	if(!dst) {
+		dstlen = 0;
+	}
+	while (s < end) {
+		if(*s < 0x80) {
+			run = ascii_length(s, end - s);
+			if(n < dstlen) {
+				SDL_memcpy(dst + n, s, SDL_min(run, dstlen - n));
+			}
+			s += run;
+			n += run;
+			continue;
+		}
+		s += utf8_decode(s, end - s, &ch);
+		if(n < dstlen) {
+			dst[n] = (ch <= 0xFF) ? (char) ch : UNKNOWN_ASCII;
+		}
+		++n;
+	}
+	return n;
+}
+
+size_t SDL_Latin1ToUTF8(const char *src, size_t srclen, char *dst, size_t dstlen) {
+	const Uint8 *s = (const Uint8 *) src, *end = s + srclen;
+	Uint8 *d = (Uint8 *) dst;
+	size_t n = 0, run;
+
+	if(!dst) {
+		dstlen = 0;
+	}
+	while (s < end) {
+		if(*s < 0x80) {
+			run = ascii_length(s, end - s);
+			if(n < dstlen) {
+				SDL_memcpy(d + n, s, SDL_min(run, dstlen - n));
+			}
+			s += run;
+			n += run;
+			continue;
+		}
+		n += utf8_encode(*s++, (n < dstlen) ? d + n : NULL, dstlen - n);
+	}
+	return n;
+}
+
+#ifdef HAVE_ICONV
+
+/* Depending on which standard the iconv() was implemented with,
+   iconv() may or may not use const char ** for the inbuf param.
+   If we get this wrong, it's just a warning, so no big deal.
+*/
+#include <errno.h>
+
+size_t SDL_iconv(SDL_iconv_t cd, const char **inbuf, size_t *inbytesleft, char **outbuf, size_t *outbytesleft) {
+	size_t retCode;
+#ifdef ICONV_INBUF_NONCONST
+	retCode = iconv(cd, (char **) inbuf, inbytesleft, outbuf, outbytesleft);
+#else
+	retCode = iconv(cd, inbuf, inbytesleft, outbuf, outbytesleft);
+#endif
+	if(retCode == (size_t) - 1) {
+		switch (errno) {
+			case E2BIG:
+				return SDL_ICONV_E2BIG;
+			case EILSEQ:
+				return SDL_ICONV_EILSEQ;
+			case EINVAL:
+				return SDL_ICONV_EINVAL;
+			default:
+				return SDL_ICONV_ERROR;
+		}
+	}
+	return retCode;
+}
+
+#else
+
 SDL_iconv_t SDL_iconv_open(const char *tocode, const char *fromcode) {
 	int src_fmt = ENCODING_UNKNOWN;
 	int dst_fmt = ENCODING_UNKNOWN;
@@ -777,6 +1213,95 @@ int SDL_iconv_close(SDL_iconv_t cd) {
 
 #endif /* !HAVE_ICONV */
 
+/* Converts straight between UTF-8 and the native forms, measuring the
+   output first so it's allocated once.  UCS-2 and UCS-4 only mean native
+   byte order with our own converter, a system iconv is left to decide.
+   Wide input that isn't aligned for its type goes the generic way too,
+   strict alignment targets would fault reading it.
+*/
+static char *iconv_string_bulk(const char *tocode, const char *fromcode, const char *inbuf, size_t inbytesleft, SDL_bool *handled) {
+	int src_fmt = getencoding(fromcode);
+	int dst_fmt = getencoding(tocode);
+	int unit = 1;
+	size_t len;
+	char *string;
+
+	*handled = SDL_FALSE;
+	if(src_fmt == ENCODING_UTF8) {
+		switch (dst_fmt) {
+#ifndef HAVE_ICONV
+			case ENCODING_UCS2:
+#endif
+			case ENCODING_UTF16NATIVE:
+				len = utf8_to_utf16(inbuf, inbytesleft, NULL, 0, dst_fmt != ENCODING_UTF16NATIVE);
+				unit = 2;
+				break;
+#ifndef HAVE_ICONV
+			case ENCODING_UCS4:
+#endif
+			case ENCODING_UTF32NATIVE:
+				len = SDL_UTF8ToUCS4(inbuf, inbytesleft, NULL, 0);
+				unit = 4;
+				break;
+			case ENCODING_LATIN1:
+				len = SDL_UTF8ToLatin1(inbuf, inbytesleft, NULL, 0);
+				break;
+			default:
+				return NULL;
+		}
+	} else if(dst_fmt == ENCODING_UTF8) {
+		switch (src_fmt) {
+			case ENCODING_UTF16NATIVE:
+				if((size_t) inbuf & 1) {
+					return NULL;
+				}
+				len = SDL_UTF16ToUTF8((const Uint16 *) inbuf, inbytesleft / 2, NULL, 0);
+				break;
+#ifndef HAVE_ICONV
+			case ENCODING_UCS4:
+#endif
+			case ENCODING_UTF32NATIVE:
+				if((size_t) inbuf & 3) {
+					return NULL;
+				}
+				len = SDL_UCS4ToUTF8((const Uint32 *) inbuf, inbytesleft / 4, NULL, 0);
+				break;
+			case ENCODING_LATIN1:
+				len = SDL_Latin1ToUTF8(inbuf, inbytesleft, NULL, 0);
+				break;
+			default:
+				return NULL;
+		}
+	} else {
+		return NULL;
+	}
+	*handled = SDL_TRUE;
+
+	/* Room for a terminator of any width, like the iconv path leaves */
+	string = (char *) SDL_malloc(len * unit + 4);
+	if(!string) {
+		return NULL;
+	}
+	SDL_memset(string + len * unit, 0, 4);
+
+	if(src_fmt == ENCODING_UTF8) {
+		if(unit == 2) {
+			utf8_to_utf16(inbuf, inbytesleft, (Uint16 *) string, len, dst_fmt != ENCODING_UTF16NATIVE);
+		} else if(unit == 4) {
+			SDL_UTF8ToUCS4(inbuf, inbytesleft, (Uint32 *) string, len);
+		} else {
+			SDL_UTF8ToLatin1(inbuf, inbytesleft, string, len);
+		}
+	} else if(src_fmt == ENCODING_UTF16NATIVE) {
+		SDL_UTF16ToUTF8((const Uint16 *) inbuf, inbytesleft / 2, string, len);
+	} else if(src_fmt == ENCODING_LATIN1) {
+		SDL_Latin1ToUTF8(inbuf, inbytesleft, string, len);
+	} else {
+		SDL_UCS4ToUTF8((const Uint32 *) inbuf, inbytesleft / 4, string, len);
+	}
+	return string;
+}
+
 char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inbuf, size_t inbytesleft) {
 	SDL_iconv_t cd;
 	char *string;
@@ -784,6 +1309,12 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
 	char *outbuf;
 	size_t outbytesleft;
 	size_t retCode = 0;
+	SDL_bool handled;
+
+	string = iconv_string_bulk(tocode, fromcode, inbuf, inbytesleft, &handled);
+	if(handled) {
+		return string;
+	}
 
 	cd = SDL_iconv_open(tocode, fromcode);
 	if(cd == (SDL_iconv_t) - 1) {
@@ -814,14 +1345,17 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
 		retCode = SDL_iconv(cd, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
 		switch (retCode) {
 			case SDL_ICONV_E2BIG: {
-				char *oldstring = string;
+				size_t written = outbuf - string;
+				char *newstring;
 				stringsize *= 2;
-				string = SDL_realloc(string, stringsize);
-				if(!string) {
+				newstring = SDL_realloc(string, stringsize);
+				if(!newstring) {
+					SDL_free(string);
 					SDL_iconv_close(cd);
 					return NULL;
 				}
-				outbuf = string + (outbuf - oldstring);
+				string = newstring;
+				outbuf = string + written;
 				outbytesleft = stringsize - (outbuf - string);
 				SDL_memset(outbuf, 0, 4);
 			}
@@ -43,6 +43,31 @@
 #define LACKS_STDLIB_H
 #define ABORT
 
+/* The audio, event and I/O threads allocate too, so the allocator is
+   locked unless threads are compiled out.  Each thread is handed one of
+   SDL_MALLOC_ARENAS mspaces the first time it allocates, which keeps
+   threads off each other's locks, and footers record the owning arena
+   of every chunk so blocks can be freed from any thread.  Arenas need
+   compiler thread local storage; SDL_TLSSet() allocates and can't be
+   used from inside the allocator.
+*/
+#ifndef SDL_THREADS_DISABLED
+#define USE_LOCKS 1
+#define SDL_MALLOC_SPINLOCKS
+#endif
+#ifndef SDL_MALLOC_ARENAS
+#if defined(__GNUC__) && !defined(SDL_THREADS_DISABLED)
+#define SDL_MALLOC_ARENAS 4
+#else
+#define SDL_MALLOC_ARENAS 1
+#endif
+#endif
+#if SDL_MALLOC_ARENAS > 1
+#define MSPACES 1
+#define FOOTERS 1
+#endif
+#define USE_DL_PREFIX
+
 /*
   This is a version (aka dlmalloc) of malloc/free/realloc written by
   Doug Lea and released to the public domain, as explained at
@@ -1495,7 +1520,26 @@ static int win32munmap(void* ptr, size_t size) {
 	unique mparams values are initialized only once.
 */
 
-#if !defined(WIN32) && !defined(__OS2__)
+#if defined(SDL_MALLOC_SPINLOCKS)
+/* Lock-protected regions are short and never nest, and SDL spinlocks
+   work with every thread backend without allocating */
+#include "SDL_atomic.h"
+#define MLOCK_T SDL_SpinLock
+static __inline__ int sdl_acquire_lock (MLOCK_T *sl) {
+  SDL_AtomicLock(sl);
+  return 0;
+}
+
+#define INITIAL_LOCK(l)      (*(l) = 0)
+#define ACQUIRE_LOCK(l)      sdl_acquire_lock(l)
+#define RELEASE_LOCK(l)      SDL_AtomicUnlock(l)
+
+#if HAVE_MORECORE
+static MLOCK_T morecore_mutex;
+#endif /* HAVE_MORECORE */
+static MLOCK_T magic_init_mutex;
+
+#elif !defined(WIN32) && !defined(__OS2__)
 /* By default use posix locks */
 #include <pthread.h>
 #define MLOCK_T pthread_mutex_t
@@ -3229,7 +3273,7 @@ static void internal_malloc_stats(mstate m) {
 #else /* ONLY_MSPACES */
 #if MSPACES
 #define internal_malloc(m, b)\
-   (m == gm)? dlmalloc(b) : mspace_malloc(m, b)
+   ((m == gm)? dlmalloc(b) : mspace_malloc(m, b))
 #define internal_free(m, mem)\
    if (m == gm) dlfree(mem); else mspace_free(m,mem);
 #else /* MSPACES */
@@ -4864,23 +4908,27 @@ void mspace_malloc_stats(mspace msp) {
 }
 
 size_t mspace_footprint(mspace msp) {
-  size_t result;
+  size_t result = 0;
   mstate ms = (mstate)msp;
   if (ok_magic(ms)) {
 	result = ms->footprint;
   }
-  USAGE_ERROR_ACTION(ms,ms);
+  else {
+	USAGE_ERROR_ACTION(ms,ms);
+  }
   return result;
 }
 
 
 size_t mspace_max_footprint(mspace msp) {
-  size_t result;
+  size_t result = 0;
   mstate ms = (mstate)msp;
   if (ok_magic(ms)) {
 	result = ms->max_footprint;
   }
-  USAGE_ERROR_ACTION(ms,ms);
+  else {
+	USAGE_ERROR_ACTION(ms,ms);
+  }
   return result;
 }
 
@@ -4901,6 +4949,138 @@ int mspace_mallopt(int param_number, int value) {
 
 #endif /* MSPACES */
 
+/* -------------------------- SDL entry points --------------------------- */
+
+#include "SDL_atomic.h"
+#include "SDL_error.h"
+
+/* An arena with no mspace is the global malloc state.  Counters are
+   bumped by the arena of the calling thread, so a block freed on another
+   thread only balances out in the sum. */
+typedef struct SDL_MallocArena {
+	void *space;
+	SDL_atomic_t count;
+	char pad[64 - sizeof(void *) - sizeof(SDL_atomic_t)];
+} SDL_MallocArena;
+
+static SDL_MallocArena SDL_malloc_arenas[SDL_MALLOC_ARENAS];
+
+#if SDL_MALLOC_ARENAS > 1
+static SDL_SpinLock SDL_malloc_arena_lock;
+static SDL_atomic_t SDL_malloc_next_arena;
+static __thread SDL_MallocArena *SDL_malloc_arena;
+
+/* Hand out arenas round robin, the first one being the global state */
+static SDL_MallocArena *SDL_GetMallocArena(void) {
+	SDL_MallocArena *arena = SDL_malloc_arena;
+
+	if(arena == NULL) {
+		int i = (unsigned) SDL_AtomicAdd(&SDL_malloc_next_arena, 1) % SDL_MALLOC_ARENAS;
+
+		arena = &SDL_malloc_arenas[i];
+		if(i > 0) {
+			SDL_AtomicLock(&SDL_malloc_arena_lock);
+			if(arena->space == NULL) {
+				arena->space = create_mspace(0, 1);
+			}
+			if(arena->space == NULL) {
+				arena = &SDL_malloc_arenas[0];
+			}
+			SDL_AtomicUnlock(&SDL_malloc_arena_lock);
+		}
+		SDL_malloc_arena = arena;
+	}
+	return (arena);
+}
+
+#define arena_malloc(A, n)       ((A)->space ? mspace_malloc((A)->space, n) : dlmalloc(n))
+#define arena_calloc(A, n, s)    ((A)->space ? mspace_calloc((A)->space, n, s) : dlcalloc(n, s))
+#else
+#define SDL_GetMallocArena()     (&SDL_malloc_arenas[0])
+#define arena_malloc(A, n)       dlmalloc(n)
+#define arena_calloc(A, n, s)    dlcalloc(n, s)
+#endif /* SDL_MALLOC_ARENAS > 1 */
+
+void *SDL_malloc(size_t size) {
+	SDL_MallocArena *arena = SDL_GetMallocArena();
+	void *mem = arena_malloc(arena, size);
+
+	if(mem) {
+		SDL_AtomicAdd(&arena->count, 1);
+	}
+	return (mem);
+}
+
+void *SDL_calloc(size_t nmemb, size_t size) {
+	SDL_MallocArena *arena = SDL_GetMallocArena();
+	void *mem = arena_calloc(arena, nmemb, size);
+
+	if(mem) {
+		SDL_AtomicAdd(&arena->count, 1);
+	}
+	return (mem);
+}
+
+/* Footers send a block back to the arena it came from */
+void *SDL_realloc(void *ptr, size_t size) {
+	if(ptr == NULL) {
+		return (SDL_malloc(size));
+	}
+#ifdef REALLOC_ZERO_BYTES_FREES
+	if(size == 0) {
+		SDL_free(ptr);
+		return (NULL);
+	}
+#endif
+	return (dlrealloc(ptr, size));
+}
+
+void SDL_free(void *ptr) {
+	SDL_MallocArena *arena;
+
+	if(ptr) {
+		arena = SDL_GetMallocArena();
+		dlfree(ptr);
+		SDL_AtomicAdd(&arena->count, -1);
+	}
+}
+
+int SDL_GetMemoryStats(SDL_MemoryStats *stats) {
+	int i;
+
+	if(stats == NULL) {
+		SDL_InvalidParamError("stats");
+		return (-1);
+	}
+	stats->footprint = 0;
+	stats->peak_footprint = 0;
+	stats->in_use = 0;
+	stats->allocations = 0;
+	stats->arenas = 0;
+	for (i = 0; i < SDL_MALLOC_ARENAS; ++i) {
+		SDL_MallocArena *arena = &SDL_malloc_arenas[i];
+
+		if(i == 0) {
+			struct mallinfo info = dlmallinfo();
+			stats->footprint += dlmalloc_footprint();
+			stats->peak_footprint += dlmalloc_max_footprint();
+			stats->in_use += info.uordblks;
+#if MSPACES
+		} else if(arena->space) {
+			struct mallinfo info = mspace_mallinfo(arena->space);
+			stats->footprint += mspace_footprint(arena->space);
+			stats->peak_footprint += mspace_max_footprint(arena->space);
+			stats->in_use += info.uordblks;
+#endif
+		} else {
+			continue;
+		}
+		stats->allocations += SDL_AtomicGet(&arena->count);
+		++stats->arenas;
+	}
+	return (0);
+}
+
 /* -------------------- Alternative MORECORE functions ------------------- */
 
 /*
@@ -5175,3 +5355,41 @@ History:
 */
 
 #endif /* !HAVE_MALLOC */
+
+#ifdef HAVE_MALLOC
+
+#include "SDL_error.h"
+
+#if defined(__GLIBC__) && defined(HAVE_MALLOC_H)
+#include <malloc.h>
+#endif
+
+/* glibc adds up its arenas for us, other C libraries don't report usage */
+int SDL_GetMemoryStats(SDL_MemoryStats *stats) {
+	if(stats == NULL) {
+		SDL_InvalidParamError("stats");
+		return (-1);
+	}
+	stats->footprint = 0;
+	stats->peak_footprint = 0;
+	stats->in_use = 0;
+	stats->allocations = 0;
+	stats->arenas = 0;
+#if defined(__GLIBC__) && defined(HAVE_MALLOC_H)
+	{
+#if __GLIBC__ > 2 || __GLIBC_MINOR__ >= 33
+		struct mallinfo2 info = mallinfo2();
+#else
+		struct mallinfo info = mallinfo();
+#endif
+		stats->footprint = (size_t) info.arena + (size_t) info.hblkhd;
+		stats->in_use = (size_t) info.uordblks + (size_t) info.hblkhd;
+	}
+	return (0);
+#else
+	SDL_Unsupported();
+	return (-1);
+#endif
+}
+
+#endif /* HAVE_MALLOC */
@@ -0,0 +1,403 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* Block copies and fills: the ones a minimal libc lacks, plus SDL_revcpy()
+   and SDL_memset4() which no libc has. Large blocks use SSE2 or NEON when
+   the CPU has it, the rest go a machine word at a time. */
+
+#include "SDL_stdinc.h"
+#include "SDL_endian.h"
+#include "SDL_cpuinfo.h"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#include <emmintrin.h>
+#define SDL_MEM_SSE2 1
+/* i386 builds may not enable SSE2 themselves, it's checked at run time */
+#define SSE2_FUNCTION __attribute__((target("sse2")))
+#elif defined(__GNUC__) && defined(__ARM_NEON__)
+#define SDL_MEM_NEON 1
+#endif
+
+/* Below this the SIMD setup costs more than it saves */
+#define SIMD_THRESHOLD    64
+
+#define WORD_SIZE    sizeof(size_t)
+#define WORD_MASK    (WORD_SIZE - 1)
+
+/* Join the tail of one aligned source word with the head of the next */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define MERGE_WORDS(first, second, shift) (((first) >> (shift)) | ((second) << (WORD_SIZE * 8 - (shift))))
+#else
+#define MERGE_WORDS(first, second, shift) (((first) << (shift)) | ((second) >> (WORD_SIZE * 8 - (shift))))
+#endif
+
+#if defined(SDL_MEM_SSE2) || defined(SDL_MEM_NEON)
+static int mem_simd = -1;
+
+static int SDL_MemHasSIMD(void) {
+	if(mem_simd < 0) {
+		/* The CPU detection may copy memory itself, so go without until it's done */
+		mem_simd = 0;
+#ifdef SDL_MEM_SSE2
+		mem_simd = SDL_HasSSE2();
+#else
+		mem_simd = SDL_HasARMNEON();
+#endif
+	}
+	return (mem_simd);
+}
+#endif
+
+#ifdef SDL_MEM_SSE2
+
+#ifndef SDL_memcpy
+SSE2_FUNCTION static void copy_sse2(Uint8 *dst, const Uint8 *src, size_t blocks) {
+	__m128i a, b, c, d;
+
+	while (blocks--) {
+		a = _mm_loadu_si128((const __m128i *) src);
+		b = _mm_loadu_si128((const __m128i *) (src + 16));
+		c = _mm_loadu_si128((const __m128i *) (src + 32));
+		d = _mm_loadu_si128((const __m128i *) (src + 48));
+		_mm_storeu_si128((__m128i *) dst, a);
+		_mm_storeu_si128((__m128i *) (dst + 16), b);
+		_mm_storeu_si128((__m128i *) (dst + 32), c);
+		_mm_storeu_si128((__m128i *) (dst + 48), d);
+		src += 64;
+		dst += 64;
+	}
+}
+
+#define copy_simd       copy_sse2
+#endif
+
+/* dst and src point past the end of the blocks */
+SSE2_FUNCTION static void revcopy_sse2(Uint8 *dst, const Uint8 *src, size_t blocks) {
+	__m128i a, b, c, d;
+
+	while (blocks--) {
+		src -= 64;
+		dst -= 64;
+		a = _mm_loadu_si128((const __m128i *) (src + 48));
+		b = _mm_loadu_si128((const __m128i *) (src + 32));
+		c = _mm_loadu_si128((const __m128i *) (src + 16));
+		d = _mm_loadu_si128((const __m128i *) src);
+		_mm_storeu_si128((__m128i *) (dst + 48), a);
+		_mm_storeu_si128((__m128i *) (dst + 32), b);
+		_mm_storeu_si128((__m128i *) (dst + 16), c);
+		_mm_storeu_si128((__m128i *) dst, d);
+	}
+}
+
+SSE2_FUNCTION static void fill_sse2(Uint8 *dst, Uint32 val, size_t blocks) {
+	__m128i v = _mm_set1_epi32((int) val);
+
+	while (blocks--) {
+		_mm_storeu_si128((__m128i *) dst, v);
+		_mm_storeu_si128((__m128i *) (dst + 16), v);
+		_mm_storeu_si128((__m128i *) (dst + 32), v);
+		_mm_storeu_si128((__m128i *) (dst + 48), v);
+		dst += 64;
+	}
+}
+
+#define revcopy_simd    revcopy_sse2
+#define fill_simd       fill_sse2
+
+#elif defined(SDL_MEM_NEON)
+
+#ifndef SDL_memcpy
+static void copy_neon(Uint8 *dst, const Uint8 *src, size_t blocks) {
+	asm volatile (
+	"L_%=:                                      \n\t"
+	"vld1.8     { d0, d1, d2, d3 }, [%[SrcP]]!  \n\t"
+	"vld1.8     { d4, d5, d6, d7 }, [%[SrcP]]!  \n\t"
+	"pld        [%[SrcP], #64]                  \n\t"
+	"subs       %[len], #1                      \n\t"
+	"vst1.8     { d0, d1, d2, d3 }, [%[DstP]]!  \n\t"
+	"vst1.8     { d4, d5, d6, d7 }, [%[DstP]]!  \n\t"
+	"bne        L_%=                            \n\t"
+	: [DstP] "+r"(dst), [SrcP] "+r"(src), [len] "+r"(blocks)
+	:
+	: "d0", "d1", "d2", "d3", "d4", "d5", "d6", "d7", "cc", "memory"
+	);
+}
+
+#define copy_simd       copy_neon
+#endif
+
+/* dst and src point past the end of the blocks */
+static void revcopy_neon(Uint8 *dst, const Uint8 *src, size_t blocks) {
+	int step = -32;
+
+	src -= 32;
+	dst -= 32;
+	asm volatile (
+	"L_%=:                                      \n\t"
+	"vld1.8     { d0, d1, d2, d3 }, [%[SrcP]], %[step] \n\t"
+	"vld1.8     { d4, d5, d6, d7 }, [%[SrcP]], %[step] \n\t"
+	"subs       %[len], #1                      \n\t"
+	"vst1.8     { d0, d1, d2, d3 }, [%[DstP]], %[step] \n\t"
+	"vst1.8     { d4, d5, d6, d7 }, [%[DstP]], %[step] \n\t"
+	"bne        L_%=                            \n\t"
+	: [DstP] "+r"(dst), [SrcP] "+r"(src), [len] "+r"(blocks)
+	: [step] "r"(step)
+	: "d0", "d1", "d2", "d3", "d4", "d5", "d6", "d7", "cc", "memory"
+	);
+}
+
+static void fill_neon(Uint8 *dst, Uint32 val, size_t blocks) {
+	asm volatile (
+	"vdup.32    q0, %[Val]                      \n\t"
+	"vmov       q1, q0                          \n\t"
+	"L_%=:                                      \n\t"
+	"subs       %[len], #1                      \n\t"
+	"vst1.32    { d0, d1, d2, d3 }, [%[DstP]]!  \n\t"
+	"vst1.32    { d0, d1, d2, d3 }, [%[DstP]]!  \n\t"
+	"bne        L_%=                            \n\t"
+	: [DstP] "+r"(dst), [len] "+r"(blocks)
+	: [Val] "r"(val)
+	: "d0", "d1", "d2", "d3", "cc", "memory"
+	);
+}
+
+#define revcopy_simd    revcopy_neon
+#define fill_simd       fill_neon
+
+#endif /* SDL_MEM_SSE2 */
+
+#ifndef SDL_memcpy
+
+/* Forward copy, also safe for overlapping blocks with dst below src */
+static void copy_words(Uint8 *dst, const Uint8 *src, size_t len) {
+	if(len >= 2 * WORD_SIZE) {
+		size_t *dstw, *srcw, a, b, shift;
+
+		while ((size_t) dst & WORD_MASK) {
+			*dst++ = *src++;
+			--len;
+		}
+		dstw = (size_t *) dst;
+		shift = ((size_t) src & WORD_MASK) * 8;
+		if(shift == 0) {
+			srcw = (size_t *) src;
+			for (; len >= 4 * WORD_SIZE; len -= 4 * WORD_SIZE) {
+				a = srcw[0];
+				b = srcw[1];
+				dstw[0] = a;
+				dstw[1] = b;
+				a = srcw[2];
+				b = srcw[3];
+				dstw[2] = a;
+				dstw[3] = b;
+				srcw += 4;
+				dstw += 4;
+			}
+			for (; len >= WORD_SIZE; len -= WORD_SIZE) {
+				*dstw++ = *srcw++;
+			}
+		} else {
+			/* Only aligned words are loaded, which never leaves the
+			   source's first or last page */
+			srcw = (size_t *) (src - (shift / 8));
+			a = *srcw++;
+			for (; len >= 2 * WORD_SIZE; len -= WORD_SIZE) {
+				b = *srcw++;
+				*dstw++ = MERGE_WORDS(a, b, shift);
+				a = b;
+			}
+		}
+		src += (Uint8 *) dstw - dst;
+		dst = (Uint8 *) dstw;
+	}
+	while (len--) {
+		*dst++ = *src++;
+	}
+}
+
+#endif
+
+/* Backward copy from the ends of the blocks, safe with dst above src */
+static void revcopy_words(Uint8 *dst, const Uint8 *src, size_t len) {
+	if(len >= 2 * WORD_SIZE) {
+		size_t *dstw, *srcw, a, b, shift;
+
+		while ((size_t) dst & WORD_MASK) {
+			*--dst = *--src;
+			--len;
+		}
+		dstw = (size_t *) dst;
+		shift = ((size_t) src & WORD_MASK) * 8;
+		if(shift == 0) {
+			srcw = (size_t *) src;
+			for (; len >= 4 * WORD_SIZE; len -= 4 * WORD_SIZE) {
+				srcw -= 4;
+				dstw -= 4;
+				a = srcw[3];
+				b = srcw[2];
+				dstw[3] = a;
+				dstw[2] = b;
+				a = srcw[1];
+				b = srcw[0];
+				dstw[1] = a;
+				dstw[0] = b;
+			}
+			for (; len >= WORD_SIZE; len -= WORD_SIZE) {
+				*--dstw = *--srcw;
+			}
+		} else {
+			srcw = (size_t *) (src - (shift / 8));
+			b = *srcw;
+			for (; len >= 2 * WORD_SIZE; len -= WORD_SIZE) {
+				a = *--srcw;
+				*--dstw = MERGE_WORDS(a, b, shift);
+				b = a;
+			}
+		}
+		src -= dst - (Uint8 *) dstw;
+		dst = (Uint8 *) dstw;
+	}
+	while (len--) {
+		*--dst = *--src;
+	}
+}
+
+static void fill_words(Uint8 *dst, Uint32 val, size_t len) {
+	size_t word = val;
+
+	if(WORD_SIZE > 4) {
+		word |= (word << 16) << 16;
+	}
+	/* The fill is aligned to dst, so start on a whole pixel */
+	while (((size_t) dst & WORD_MASK) && len >= 4) {
+		*(Uint32 *) dst = val;
+		dst += 4;
+		len -= 4;
+	}
+	if(((size_t) dst & WORD_MASK) == 0) {
+		size_t *dstw = (size_t *) dst;
+
+		for (; len >= 4 * WORD_SIZE; len -= 4 * WORD_SIZE) {
+			dstw[0] = word;
+			dstw[1] = word;
+			dstw[2] = word;
+			dstw[3] = word;
+			dstw += 4;
+		}
+		for (; len >= WORD_SIZE; len -= WORD_SIZE) {
+			*dstw++ = word;
+		}
+		dst = (Uint8 *) dstw;
+	}
+	for (; len >= 4; len -= 4) {
+		*(Uint32 *) dst = val;
+		dst += 4;
+	}
+}
+
+#ifndef SDL_memcpy
+
+void *SDL_memcpy(void *dst, const void *src, size_t len) {
+	Uint8 *dstp = (Uint8 *) dst;
+	const Uint8 *srcp = (const Uint8 *) src;
+
+#ifdef copy_simd
+	if(len >= SIMD_THRESHOLD && SDL_MemHasSIMD()) {
+		copy_simd(dstp, srcp, len / 64);
+		dstp += len & ~63;
+		srcp += len & ~63;
+		len &= 63;
+	}
+#endif
+	copy_words(dstp, srcp, len);
+	return dst;
+}
+
+#endif
+
+void *SDL_revcpy(void *dst, const void *src, size_t len) {
+	Uint8 *dstp = (Uint8 *) dst + len;
+	const Uint8 *srcp = (const Uint8 *) src + len;
+
+#ifdef revcopy_simd
+	if(len >= SIMD_THRESHOLD && SDL_MemHasSIMD()) {
+		revcopy_simd(dstp, srcp, len / 64);
+		dstp -= len & ~63;
+		srcp -= len & ~63;
+		len &= 63;
+	}
+#endif
+	revcopy_words(dstp, srcp, len);
+	return dst;
+}
+
+#ifndef SDL_memset
+
+void *SDL_memset(void *dst, int c, size_t len) {
+	Uint8 *dstp = (Uint8 *) dst;
+	Uint32 val = (Uint8) c * 0x01010101U;
+
+	while (((size_t) dstp & 3) && len) {
+		*dstp++ = (Uint8) c;
+		--len;
+	}
+#ifdef fill_simd
+	if(len >= SIMD_THRESHOLD && SDL_MemHasSIMD()) {
+		fill_simd(dstp, val, len / 64);
+		dstp += len & ~63;
+		len &= 63;
+	}
+#endif
+	fill_words(dstp, val, len);
+	dstp += len & ~3;
+	len &= 3;
+	while (len--) {
+		*dstp++ = (Uint8) c;
+	}
+	return dst;
+}
+
+#endif
+
+void SDL_memset4(void *dst, Uint32 val, size_t dwords) {
+	Uint8 *dstp = (Uint8 *) dst;
+	size_t len = dwords * 4;
+
+#ifdef fill_simd
+	if(len >= SIMD_THRESHOLD && SDL_MemHasSIMD()) {
+		fill_simd(dstp, val, len / 64);
+		dstp += len & ~63;
+		len &= 63;
+	}
+#endif
+	fill_words(dstp, val, len);
+}
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* Fixed-size object pools for SDL internals */
+
+#include "SDL_pool_c.h"
+
+/* Each object is preceded by a pointer to its slab, padded so the object
+   stays aligned for any member */
+typedef union SDL_PoolTag {
+	struct SDL_PoolSlab *slab;
+	Uint64 align;
+} SDL_PoolTag;
+
+typedef struct SDL_PoolSlab {
+	struct SDL_PoolSlab *prev;
+	struct SDL_PoolSlab *next;
+	void *free;         /* free objects, linked through their first word */
+	int used;
+	SDL_PoolTag first;  /* the objects start here */
+} SDL_PoolSlab;
+
+#define POOL_STRIDE(pool) \
+	((sizeof(SDL_PoolTag) + (pool)->size + sizeof(SDL_PoolTag) - 1) & ~(sizeof(SDL_PoolTag) - 1))
+
+static void SDL_PoolLink(SDL_Pool *pool, SDL_PoolSlab *slab) {
+	slab->prev = NULL;
+	slab->next = pool->partial;
+	if(pool->partial) {
+		pool->partial->prev = slab;
+	}
+	pool->partial = slab;
+}
+
+static void SDL_PoolUnlink(SDL_Pool *pool, SDL_PoolSlab *slab) {
+	if(slab->prev) {
+		slab->prev->next = slab->next;
+	} else {
+		pool->partial = slab->next;
+	}
+	if(slab->next) {
+		slab->next->prev = slab->prev;
+	}
+}
+
+static SDL_PoolSlab *SDL_PoolGrow(SDL_Pool *pool) {
+	size_t stride = POOL_STRIDE(pool);
+	SDL_PoolSlab *slab;
+	Uint8 *tag;
+	int i;
+
+	slab = (SDL_PoolSlab *) SDL_malloc(sizeof(*slab) - sizeof(slab->first) + pool->count * stride);
+	if(slab == NULL) {
+		return (NULL);
+	}
+	slab->used = 0;
+	slab->free = NULL;
+	tag = (Uint8 *) &slab->first + (pool->count - 1) * stride;
+	for (i = pool->count; i > 0; --i, tag -= stride) {
+		((SDL_PoolTag *) tag)->slab = slab;
+		*(void **) (tag + sizeof(SDL_PoolTag)) = slab->free;
+		slab->free = tag + sizeof(SDL_PoolTag);
+	}
+	SDL_PoolLink(pool, slab);
+	++pool->slabs;
+	++pool->empty;
+	return (slab);
+}
+
+void *SDL_PoolAlloc(SDL_Pool *pool) {
+	SDL_PoolSlab *slab;
+	void *object = NULL;
+
+	SDL_AtomicLock(&pool->lock);
+	slab = pool->partial;
+	if(slab == NULL) {
+		slab = SDL_PoolGrow(pool);
+	}
+	if(slab) {
+		object = slab->free;
+		slab->free = *(void **) object;
+		if(slab->used++ == 0) {
+			--pool->empty;
+		}
+		if(slab->free == NULL) {
+			SDL_PoolUnlink(pool, slab);
+		}
+	}
+	SDL_AtomicUnlock(&pool->lock);
+	return (object);
+}
+
+void SDL_PoolFree(SDL_Pool *pool, void *object) {
+	SDL_PoolSlab *slab;
+
+	if(object == NULL) {
+		return;
+	}
+	slab = ((SDL_PoolTag *) object - 1)->slab;
+
+	SDL_AtomicLock(&pool->lock);
+	if(slab->free == NULL) {
+		SDL_PoolLink(pool, slab);
+	}
+	*(void **) object = slab->free;
+	slab->free = object;
+	if(--slab->used == 0 && pool->empty > 0) {
+		/* There's already a spare, this one isn't needed */
+		SDL_PoolUnlink(pool, slab);
+		--pool->slabs;
+	} else {
+		if(slab->used == 0) {
+			++pool->empty;
+		}
+		slab = NULL;
+	}
+	SDL_AtomicUnlock(&pool->lock);
+
+	/* Give the slab back outside the lock */
+	SDL_free(slab);
+}
+
+void SDL_PoolTrim(SDL_Pool *pool) {
+	SDL_PoolSlab *slab, *next, *freeable = NULL;
+
+	SDL_AtomicLock(&pool->lock);
+	for (slab = pool->partial; slab; slab = next) {
+		next = slab->next;
+		if(slab->used == 0) {
+			SDL_PoolUnlink(pool, slab);
+			--pool->slabs;
+			--pool->empty;
+			slab->next = freeable;
+			freeable = slab;
+		}
+	}
+	SDL_AtomicUnlock(&pool->lock);
+
+	while (freeable) {
+		slab = freeable;
+		freeable = slab->next;
+		SDL_free(slab);
+	}
+}
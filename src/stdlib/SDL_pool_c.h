@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+#ifndef SDL_pool_c_h_
+#define SDL_pool_c_h_
+
+/* Pools of fixed-size objects carved out of slabs, for small structures
+   that are created and destroyed all the time.  Each object remembers its
+   slab and slabs with free objects are kept on a list.  One empty slab is
+   kept around as a spare so an object freed and allocated again every frame
+   doesn't malloc and free a whole slab each time; further empty slabs go back
+   to the heap, and SDL_PoolTrim() releases the spare as well.
+*/
+#include "SDL_stdinc.h"
+#include "SDL_atomic.h"
+
+struct SDL_PoolSlab;
+
+typedef struct SDL_Pool {
+	SDL_SpinLock lock;
+	size_t size;                    /* object size */
+	int count;                      /* objects per slab */
+	int slabs;
+	int empty;                      /* slabs with no objects in use */
+	struct SDL_PoolSlab *partial;   /* slabs with free objects */
+} SDL_Pool;
+
+#define SDL_POOL_INITIALIZER(type, count)    { 0, sizeof(type), count, 0, 0, NULL }
+
+/* Returns an uninitialized object, or NULL without setting an error */
+extern void *SDL_PoolAlloc(SDL_Pool *pool);
+
+extern void SDL_PoolFree(SDL_Pool *pool, void *object);
+
+/* Gives every empty slab back to the heap, objects still in use stay put */
+extern void SDL_PoolTrim(SDL_Pool *pool);
+
+#endif /* SDL_pool_c_h_ */
@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* Sorts that don't go through a comparison per element pair the way
+   SDL_qsort() does: a radix sort of 32-bit keys and a stable merge sort */
+
+#include "SDL_stdinc.h"
+#include "SDL_error.h"
+
+/* Below this many keys an insertion sort beats counting digits */
+#define RADIX_CUTOFF    32
+
+/* Runs this long are insertion sorted before merging */
+#define MERGE_RUN       8
+
+static void insertion_sort_keys(SDL_SortKey *keys, size_t count) {
+	size_t i, j;
+
+	for (i = 1; i < count; ++i) {
+		SDL_SortKey key = keys[i];
+
+		for (j = i; j > 0 && keys[j - 1].key > key.key; --j) {
+			keys[j] = keys[j - 1];
+		}
+		keys[j] = key;
+	}
+}
+
+int SDL_RadixSort(SDL_SortKey *keys, SDL_SortKey *scratch, size_t count) {
+	size_t hist[4][256];
+	SDL_SortKey *src, *dst, *tmp;
+	void *allocated = NULL;
+	size_t i, sum, n;
+	int pass, shift, b;
+
+	if(count <= RADIX_CUTOFF) {
+		insertion_sort_keys(keys, count);
+		return (0);
+	}
+	if(scratch == NULL) {
+		scratch = allocated = SDL_malloc(count * sizeof(*keys));
+		if(scratch == NULL) {
+			SDL_OutOfMemory();
+			return (-1);
+		}
+	}
+
+	/* Count all four digits in one pass over the keys */
+	SDL_memset(hist, 0, sizeof(hist));
+	for (i = 0; i < count; ++i) {
+		Uint32 key = keys[i].key;
+		++hist[0][key & 0xFF];
+		++hist[1][(key >> 8) & 0xFF];
+		++hist[2][(key >> 16) & 0xFF];
+		++hist[3][key >> 24];
+	}
+
+	src = keys;
+	dst = scratch;
+	for (pass = 0, shift = 0; pass < 4; ++pass, shift += 8) {
+		size_t *offset = hist[pass];
+
+		/* Skip digits every key shares, like the top bytes of small depths */
+		if(offset[(keys[0].key >> shift) & 0xFF] == count) {
+			continue;
+		}
+		for (b = 0, sum = 0; b < 256; ++b) {
+			n = offset[b];
+			offset[b] = sum;
+			sum += n;
+		}
+		for (i = 0; i < count; ++i) {
+			dst[offset[(src[i].key >> shift) & 0xFF]++] = src[i];
+		}
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+	if(src != keys) {
+		SDL_memcpy(keys, src, count * sizeof(*keys));
+	}
+	SDL_free(allocated);
+	return (0);
+}
+
+/* Element moves, with the common word sizes done without a call */
+static __inline__ void copy_element(void *dst, const void *src, size_t size, int words) {
+	if(words && size == sizeof(Uint32)) {
+		*(Uint32 *) dst = *(const Uint32 *) src;
+	} else if(words && size == sizeof(Uint64)) {
+		*(Uint64 *) dst = *(const Uint64 *) src;
+	} else {
+		SDL_memcpy(dst, src, size);
+	}
+}
+
+/* Sort one run in place, using tmp to hold the element being placed */
+static void insertion_sort_run(char *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *), void *tmp, int words) {
+	char *p, *q;
+	size_t i;
+
+	for (i = 1; i < nmemb; ++i) {
+		p = base + i * size;
+		if(compare(p - size, p) <= 0) {
+			continue;
+		}
+		copy_element(tmp, p, size, words);
+		for (q = p; q > base && compare(q - size, tmp) > 0; q -= size) {
+			copy_element(q, q - size, size, words);
+		}
+		copy_element(q, tmp, size, words);
+	}
+}
+
+/* Merge src[lo, mid) and src[mid, hi) into dst, taking from the left on
+   ties so equal elements keep their order */
+static void merge_runs(char *dst, const char *src, size_t lo, size_t mid, size_t hi, size_t size, int (*compare)(const void *, const void *), int words) {
+	const char *l = src + lo * size, *lend = src + mid * size;
+	const char *r = lend, *rend = src + hi * size;
+	char *d = dst + lo * size;
+
+	/* Already in order, which is usual for draw lists between frames */
+	if(r == rend || compare(lend - size, r) <= 0) {
+		SDL_memcpy(d, l, (hi - lo) * size);
+		return;
+	}
+	while (l < lend && r < rend) {
+		if(compare(l, r) <= 0) {
+			copy_element(d, l, size, words);
+			l += size;
+		} else {
+			copy_element(d, r, size, words);
+			r += size;
+		}
+		d += size;
+	}
+	if(l < lend) {
+		SDL_memcpy(d, l, lend - l);
+	} else {
+		SDL_memcpy(d, r, rend - r);
+	}
+}
+
+int SDL_MergeSort(void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *), void *scratch) {
+	char *src = (char *) base, *dst, *tmp;
+	void *allocated = NULL;
+	size_t lo, width;
+	int words;
+
+	if(nmemb <= 1) {
+		return (0);
+	}
+	if(scratch == NULL) {
+		scratch = allocated = SDL_malloc(nmemb * size);
+		if(scratch == NULL) {
+			SDL_OutOfMemory();
+			return (-1);
+		}
+	}
+	words = ((((size_t) base | (size_t) scratch | size) & (sizeof(Uint32) - 1)) == 0);
+	if(size == sizeof(Uint64) && ((size_t) base | (size_t) scratch) & (sizeof(Uint64) - 1)) {
+		words = 0;
+	}
+
+	for (lo = 0; lo < nmemb; lo += MERGE_RUN) {
+		insertion_sort_run(src + lo * size, SDL_min(MERGE_RUN, nmemb - lo), size, compare, scratch, words);
+	}
+
+	dst = (char *) scratch;
+	for (width = MERGE_RUN; width < nmemb; width *= 2) {
+		for (lo = 0; lo < nmemb; lo += 2 * width) {
+			size_t mid = SDL_min(lo + width, nmemb);
+			size_t hi = SDL_min(lo + 2 * width, nmemb);
+			merge_runs(dst, src, lo, mid, hi, size, compare, words);
+		}
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+	if(src != (char *) base) {
+		SDL_memcpy(base, src, nmemb * size);
+	}
+	SDL_free(allocated);
+	return (0);
+}
@@ -0,0 +1,468 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* A work-stealing task pool on top of the SDL thread primitives */
+
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_taskpool.h"
+
+/* Initial deque size per worker, grows as needed (power of two) */
+#define TASK_DEQUE_SIZE    64
+
+/* Chunks per thread when SDL_TaskParallelFor() picks the grain */
+#define TASK_CHUNKS_PER_THREAD    4
+
+typedef struct {
+	SDL_TaskFunction func;
+	void *data;
+	SDL_atomic_t *pending;
+} SDL_Task;
+
+typedef struct {
+	SDL_TaskPool *pool;
+	SDL_Thread *thread;
+	/* The owner pushes and pops at the tail, thieves take from the head */
+	SDL_SpinLock lock;
+	SDL_Task *tasks;
+	unsigned int size;
+	unsigned int head;
+	unsigned int tail;
+} SDL_TaskWorker;
+
+struct SDL_TaskPool {
+	int num_workers;
+	SDL_TaskWorker *workers;
+	SDL_sem *wakeup;            /* Posted once per queued task */
+	SDL_atomic_t shutdown;
+	SDL_atomic_t next_worker;   /* Round-robin target for outside submits */
+	SDL_atomic_t pending;       /* Tasks queued or running */
+	SDL_atomic_t waiters;       /* Threads sleeping in SDL_TaskWait() */
+	SDL_mutex *done_lock;
+	SDL_cond *done_cond;
+};
+
+/* The worker running on the current thread, if any */
+static SDL_TLSID SDL_task_worker;
+static SDL_SpinLock SDL_task_worker_lock;
+
+static SDL_TaskWorker *SDL_TaskCurrentWorker(SDL_TaskPool *pool) {
+	SDL_TaskWorker *worker;
+
+	if(!SDL_task_worker) {
+		return NULL;
+	}
+	worker = (SDL_TaskWorker *) SDL_TLSGet(SDL_task_worker);
+	if(worker && worker->pool == pool) {
+		return worker;
+	}
+	return NULL;
+}
+
+static int SDL_TaskPush(SDL_TaskWorker *worker, const SDL_Task *task) {
+	SDL_AtomicLock(&worker->lock);
+	if(worker->tail - worker->head == worker->size) {
+		unsigned int i, count = worker->size;
+		SDL_Task *tasks = (SDL_Task *) SDL_malloc(count * 2 * sizeof(*tasks));
+
+		if(!tasks) {
+			SDL_AtomicUnlock(&worker->lock);
+			SDL_OutOfMemory();
+			return -1;
+		}
+		for (i = 0; i < count; ++i) {
+			tasks[i] = worker->tasks[(worker->head + i) & (worker->size - 1)];
+		}
+		SDL_free(worker->tasks);
+		worker->tasks = tasks;
+		worker->size = count * 2;
+		worker->head = 0;
+		worker->tail = count;
+	}
+	worker->tasks[worker->tail & (worker->size - 1)] = *task;
+	++worker->tail;
+	SDL_AtomicUnlock(&worker->lock);
+	return 0;
+}
+
+static SDL_bool SDL_TaskPop(SDL_TaskWorker *worker, SDL_Task *task) {
+	SDL_bool found = SDL_FALSE;
+
+	SDL_AtomicLock(&worker->lock);
+	if(worker->tail != worker->head) {
+		--worker->tail;
+		*task = worker->tasks[worker->tail & (worker->size - 1)];
+		found = SDL_TRUE;
+	}
+	SDL_AtomicUnlock(&worker->lock);
+	return found;
+}
+
+static SDL_bool SDL_TaskSteal(SDL_TaskWorker *worker, SDL_Task *task) {
+	SDL_bool found = SDL_FALSE;
+
+	SDL_AtomicLock(&worker->lock);
+	if(worker->tail != worker->head) {
+		*task = worker->tasks[worker->head & (worker->size - 1)];
+		++worker->head;
+		found = SDL_TRUE;
+	}
+	SDL_AtomicUnlock(&worker->lock);
+	return found;
+}
+
+/* Take a task from our own deque first (most recent, still in cache),
+   then steal the oldest task of another worker */
+static SDL_bool SDL_TaskFind(SDL_TaskPool *pool, SDL_TaskWorker *self, SDL_Task *task) {
+	int i, first;
+
+	if(self && SDL_TaskPop(self, task)) {
+		return SDL_TRUE;
+	}
+	first = self ? (int) (self - pool->workers) + 1 : 0;
+	for (i = 0; i < pool->num_workers; ++i) {
+		SDL_TaskWorker *victim = &pool->workers[(first + i) % pool->num_workers];
+		if(victim != self && SDL_TaskSteal(victim, task)) {
+			return SDL_TRUE;
+		}
+	}
+	return SDL_FALSE;
+}
+
+/* Whether any worker still has queued tasks */
+static SDL_bool SDL_TaskPending(SDL_TaskPool *pool) {
+	SDL_bool queued = SDL_FALSE;
+	int i;
+
+	for (i = 0; i < pool->num_workers && !queued; ++i) {
+		SDL_TaskWorker *worker = &pool->workers[i];
+
+		SDL_AtomicLock(&worker->lock);
+		queued = (worker->tail != worker->head) ? SDL_TRUE : SDL_FALSE;
+		SDL_AtomicUnlock(&worker->lock);
+	}
+	return queued;
+}
+
+/* The read-modify-write is a full barrier, so whatever the caller just
+   queued or completed is visible to a waiter that registered before us */
+static void SDL_TaskNotifyWaiters(SDL_TaskPool *pool) {
+	if(SDL_AtomicAdd(&pool->waiters, 0) > 0) {
+		SDL_mutexP(pool->done_lock);
+		SDL_CondBroadcast(pool->done_cond);
+		SDL_mutexV(pool->done_lock);
+	}
+}
+
+static void SDL_TaskRun(SDL_TaskPool *pool, const SDL_Task *task) {
+	SDL_bool done;
+
+	task->func(task->data);
+
+	done = SDL_AtomicDecRef(&pool->pending);
+	if(task->pending && SDL_AtomicDecRef(task->pending)) {
+		done = SDL_TRUE;
+	}
+	if(done) {
+		SDL_TaskNotifyWaiters(pool);
+	}
+}
+
+static int SDLCALL SDL_TaskWorkerThread(void *data) {
+	SDL_TaskWorker *worker = (SDL_TaskWorker *) data;
+	SDL_TaskPool *pool = worker->pool;
+	SDL_Task task;
+
+	SDL_TLSSet(SDL_task_worker, worker, NULL);
+	for (;;) {
+		if(SDL_TaskFind(pool, worker, &task)) {
+			SDL_TaskRun(pool, &task);
+			continue;
+		}
+		if(SDL_AtomicGet(&pool->shutdown)) {
+			break;
+		}
+		SDL_SemWait(pool->wakeup);
+	}
+	SDL_TLSSet(SDL_task_worker, NULL, NULL);
+	return 0;
+}
+
+SDL_TaskPool *SDL_TaskPoolCreate(int num_workers) {
+	SDL_TaskPool *pool;
+	int i;
+
+	if(num_workers < 0) {
+		SDL_SetError("Invalid number of task workers");
+		return NULL;
+	}
+	if(num_workers == 0) {
+		num_workers = SDL_GetCPUCount() - 1;
+		if(num_workers < 1) {
+			num_workers = 1;
+		}
+	}
+
+	if(!SDL_task_worker) {
+		SDL_AtomicLock(&SDL_task_worker_lock);
+		if(!SDL_task_worker) {
+			SDL_task_worker = SDL_TLSCreate();
+		}
+		SDL_AtomicUnlock(&SDL_task_worker_lock);
+	}
+
+	pool = (SDL_TaskPool *) SDL_calloc(1, sizeof(*pool));
+	if(!pool) {
+		SDL_OutOfMemory();
+		return NULL;
+	}
+	pool->workers = (SDL_TaskWorker *) SDL_calloc(num_workers, sizeof(*pool->workers));
+	pool->wakeup = SDL_CreateSemaphore(0);
+	pool->done_lock = SDL_CreateFastMutex();
+	pool->done_cond = SDL_CreateCond();
+	if(!pool->workers || !pool->wakeup || !pool->done_lock || !pool->done_cond) {
+		/* No threads on this platform, run everything inline */
+		SDL_TaskPoolDestroy(pool);
+		pool = (SDL_TaskPool *) SDL_calloc(1, sizeof(*pool));
+		if(!pool) {
+			SDL_OutOfMemory();
+		}
+		return pool;
+	}
+
+	for (i = 0; i < num_workers; ++i) {
+		SDL_TaskWorker *worker = &pool->workers[i];
+
+		worker->pool = pool;
+		worker->size = TASK_DEQUE_SIZE;
+		worker->tasks = (SDL_Task *) SDL_malloc(worker->size * sizeof(*worker->tasks));
+		if(!worker->tasks) {
+			SDL_OutOfMemory();
+			SDL_TaskPoolDestroy(pool);
+			return NULL;
+		}
+		++pool->num_workers;
+	}
+	for (i = 0; i < num_workers; ++i) {
+		pool->workers[i].thread = SDL_CreateThread(SDL_TaskWorkerThread, &pool->workers[i]);
+		if(!pool->workers[i].thread) {
+			SDL_TaskPoolDestroy(pool);
+			return NULL;
+		}
+	}
+	return pool;
+}
+
+void SDL_TaskPoolDestroy(SDL_TaskPool *pool) {
+	int i;
+
+	if(!pool) {
+		return;
+	}
+	if(pool->num_workers) {
+		SDL_TaskWait(pool, NULL);
+		SDL_AtomicSet(&pool->shutdown, 1);
+		for (i = 0; i < pool->num_workers; ++i) {
+			SDL_SemPost(pool->wakeup);
+		}
+		for (i = 0; i < pool->num_workers; ++i) {
+			if(pool->workers[i].thread) {
+				SDL_WaitThread(pool->workers[i].thread, NULL);
+			}
+			SDL_free(pool->workers[i].tasks);
+		}
+	}
+	if(pool->done_cond) {
+		SDL_DestroyCond(pool->done_cond);
+	}
+	if(pool->done_lock) {
+		SDL_DestroyMutex(pool->done_lock);
+	}
+	if(pool->wakeup) {
+		SDL_DestroySemaphore(pool->wakeup);
+	}
+	SDL_free(pool->workers);
+	SDL_free(pool);
+}
+
+int SDL_TaskPoolWorkers(SDL_TaskPool *pool) {
+	if(!pool) {
+		SDL_SetError("Passed a NULL task pool");
+		return -1;
+	}
+	return pool->num_workers;
+}
+
+int SDL_TaskSubmit(SDL_TaskPool *pool, SDL_TaskFunction func, void *data, SDL_atomic_t *pending) {
+	SDL_TaskWorker *worker;
+	SDL_Task task;
+
+	if(!pool || !func) {
+		SDL_SetError("Passed a NULL task pool or function");
+		return -1;
+	}
+
+	if(pool->num_workers == 0) {
+		func(data);
+		return 0;
+	}
+
+	task.func = func;
+	task.data = data;
+	task.pending = pending;
+
+	worker = SDL_TaskCurrentWorker(pool);
+	if(!worker) {
+		unsigned int next = (unsigned int) SDL_AtomicAdd(&pool->next_worker, 1);
+		worker = &pool->workers[next % pool->num_workers];
+	}
+
+	SDL_AtomicIncRef(&pool->pending);
+	if(pending) {
+		SDL_AtomicIncRef(pending);
+	}
+	if(SDL_TaskPush(worker, &task) < 0) {
+		SDL_AtomicAdd(&pool->pending, -1);
+		if(pending) {
+			SDL_AtomicAdd(pending, -1);
+		}
+		return -1;
+	}
+	SDL_SemPost(pool->wakeup);
+
+	/* A waiter that found nothing to run may be asleep, let it help */
+	SDL_TaskNotifyWaiters(pool);
+	return 0;
+}
+
+void SDL_TaskWait(SDL_TaskPool *pool, SDL_atomic_t *pending) {
+	SDL_TaskWorker *self;
+	SDL_Task task;
+
+	if(!pool || pool->num_workers == 0) {
+		return;
+	}
+	if(!pending) {
+		pending = &pool->pending;
+	}
+
+	self = SDL_TaskCurrentWorker(pool);
+	while (SDL_AtomicGet(pending) > 0) {
+		if(SDL_TaskFind(pool, self, &task)) {
+			SDL_TaskRun(pool, &task);
+			continue;
+		}
+
+		/* Registering before the final check pairs with the counter
+		   decrement in SDL_TaskRun(), so the wakeup can't be missed */
+		SDL_AtomicIncRef(&pool->waiters);
+		SDL_mutexP(pool->done_lock);
+		if(SDL_AtomicGet(pending) > 0 && !SDL_TaskPending(pool)) {
+			SDL_CondWait(pool->done_cond, pool->done_lock);
+		}
+		SDL_mutexV(pool->done_lock);
+		SDL_AtomicAdd(&pool->waiters, -1);
+	}
+}
+
+typedef struct {
+	SDL_ParallelForFunction func;
+	void *data;
+	int start;
+	int end;
+} SDL_TaskRange;
+
+static void SDLCALL SDL_TaskRunRange(void *data) {
+	SDL_TaskRange *range = (SDL_TaskRange *) data;
+
+	range->func(range->start, range->end, range->data);
+}
+
+int SDL_TaskParallelFor(SDL_TaskPool *pool, int start, int end, int grain, SDL_ParallelForFunction func, void *data) {
+	SDL_TaskRange *ranges;
+	SDL_atomic_t pending;
+	Uint32 count, step, chunks, i;
+
+	if(!func) {
+		SDL_SetError("Passed a NULL function");
+		return -1;
+	}
+	if(end <= start) {
+		return 0;
+	}
+	/* end - start doesn't fit an int for ranges wider than INT_MAX */
+	count = (Uint32) ((Sint64) end - start);
+	if(!pool || pool->num_workers == 0) {
+		func(start, end, data);
+		return 0;
+	}
+
+	if(grain <= 0) {
+		step = count / ((pool->num_workers + 1) * TASK_CHUNKS_PER_THREAD);
+		if(step < 1) {
+			step = 1;
+		}
+	} else {
+		step = ((Uint32) grain < count) ? (Uint32) grain : count;
+	}
+	chunks = (count - 1) / step + 1;
+	if(chunks == 1) {
+		func(start, end, data);
+		return 0;
+	}
+
+	ranges = NULL;
+	if(chunks <= SDL_MAX_SINT32 / sizeof(*ranges)) {
+		ranges = (SDL_TaskRange *) SDL_malloc(chunks * sizeof(*ranges));
+	}
+	if(!ranges) {
+		SDL_OutOfMemory();
+		return -1;
+	}
+	SDL_AtomicSet(&pending, 0);
+	for (i = 0; i < chunks; ++i) {
+		ranges[i].func = func;
+		ranges[i].data = data;
+		ranges[i].start = (int) (start + (Sint64) i * step);
+		ranges[i].end = (i == chunks - 1) ? end : (int) (ranges[i].start + (Sint64) step);
+		/* The last chunk runs here, the rest are left to the pool */
+		if(i < chunks - 1 && SDL_TaskSubmit(pool, SDL_TaskRunRange, &ranges[i], &pending) < 0) {
+			SDL_TaskRunRange(&ranges[i]);
+		}
+	}
+	SDL_TaskRunRange(&ranges[chunks - 1]);
+	SDL_TaskWait(pool, &pending);
+	SDL_free(ranges);
+	return 0;
+}
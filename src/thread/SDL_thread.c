@@ -32,6 +32,7 @@
 
 /* System independent thread management routines for SDL */
 
+#include "SDL_atomic.h"
 #include "SDL_mutex.h"
 #include "SDL_thread.h"
 #include "SDL_thread_c.h"
@@ -145,27 +146,212 @@ static void SDL_DelThread(SDL_Thread *thread) {
 #endif
 }
 
-/* The default (non-thread-safe) global error variable */
+/* Thread local storage.
+   Each thread owns an SDL_TLSData array indexed by SDL_TLSID - 1, and the
+   backend only has to find that array for the calling thread.
+*/
+static SDL_atomic_t SDL_tls_id;
+
+SDL_TLSID SDL_TLSCreate(void) {
+	return (SDL_TLSID) (SDL_AtomicIncRef(&SDL_tls_id) + 1);
+}
+
+void *SDL_TLSGet(SDL_TLSID id) {
+	SDL_TLSData *storage;
+
+	storage = SDL_SYS_GetTLSData();
+	if(!storage || id == 0 || id > storage->limit) {
+		return NULL;
+	}
+	return storage->array[id - 1].data;
+}
+
+/* Store a value without reporting errors, so the error buffer itself can
+   live in thread local storage */
+static int SDL_TLSSetData(SDL_TLSID id, const void *value, void (SDLCALL *destructor)(void *)) {
+	SDL_TLSData *storage;
+
+	storage = SDL_SYS_GetTLSData();
+	if(!storage || (id > storage->limit)) {
+		SDL_TLSData *grown;
+		unsigned int i, oldlimit, newlimit;
+
+		/* Not realloc(), the old array has to stay valid and registered
+		   until the backend has taken the new one */
+		oldlimit = storage ? storage->limit : 0;
+		newlimit = (id + TLS_ALLOC_CHUNKSIZE);
+		grown = (SDL_TLSData *) SDL_malloc(sizeof(*grown) + (newlimit - 1) * sizeof(grown->array[0]));
+		if(!grown) {
+			return -1;
+		}
+		grown->limit = newlimit;
+		if(oldlimit) {
+			SDL_memcpy(grown->array, storage->array, oldlimit * sizeof(grown->array[0]));
+		}
+		for (i = oldlimit; i < newlimit; ++i) {
+			grown->array[i].data = NULL;
+			grown->array[i].destructor = NULL;
+		}
+		if(SDL_SYS_SetTLSData(grown) != 0) {
+			SDL_free(grown);
+			return -1;
+		}
+		SDL_free(storage);
+		storage = grown;
+	}
+
+	storage->array[id - 1].data = SDL_const_cast(void *, value);
+	storage->array[id - 1].destructor = destructor;
+	return 0;
+}
+
+int SDL_TLSSet(SDL_TLSID id, const void *value, void (SDLCALL *destructor)(void *)) {
+	if(id == 0) {
+		SDL_SetError("SDL_TLSSet() called with invalid ID");
+		return -1;
+	}
+	if(SDL_TLSSetData(id, value, destructor) < 0) {
+		SDL_OutOfMemory();
+		return -1;
+	}
+	return 0;
+}
+
+void SDL_TLSCleanupData(SDL_TLSData *storage) {
+	unsigned int i;
+
+	if(storage) {
+		for (i = 0; i < storage->limit; ++i) {
+			if(storage->array[i].destructor) {
+				storage->array[i].destructor(storage->array[i].data);
+			}
+		}
+		SDL_free(storage);
+	}
+}
+
+void SDL_TLSCleanup(void) {
+	SDL_TLSData *storage;
+
+	storage = SDL_SYS_GetTLSData();
+	if(storage) {
+		SDL_SYS_SetTLSData(NULL);
+		SDL_TLSCleanupData(storage);
+	}
+}
+
+/* This is a generic implementation of thread-local storage which doesn't
+   need to be fast: a list keyed by thread id, walked under a spinlock. */
+typedef struct SDL_TLSEntry {
+	Uint32 thread;
+	SDL_TLSData *storage;
+	struct SDL_TLSEntry *next;
+} SDL_TLSEntry;
+
+static SDL_SpinLock SDL_generic_TLS_lock;
+static SDL_TLSEntry *SDL_generic_TLS;
+
+SDL_TLSData *SDL_Generic_GetTLSData(void) {
+	Uint32 thread = SDL_ThreadID();
+	SDL_TLSEntry *entry;
+	SDL_TLSData *storage = NULL;
+
+	SDL_AtomicLock(&SDL_generic_TLS_lock);
+	for (entry = SDL_generic_TLS; entry; entry = entry->next) {
+		if(entry->thread == thread) {
+			storage = entry->storage;
+			break;
+		}
+	}
+	SDL_AtomicUnlock(&SDL_generic_TLS_lock);
+	return storage;
+}
+
+int SDL_Generic_SetTLSData(SDL_TLSData *storage) {
+	Uint32 thread = SDL_ThreadID();
+	SDL_TLSEntry *prev, *entry;
+
+	SDL_AtomicLock(&SDL_generic_TLS_lock);
+	prev = NULL;
+	for (entry = SDL_generic_TLS; entry; entry = entry->next) {
+		if(entry->thread == thread) {
+			if(storage) {
+				entry->storage = storage;
+			} else {
+				if(prev) {
+					prev->next = entry->next;
+				} else {
+					SDL_generic_TLS = entry->next;
+				}
+				SDL_free(entry);
+			}
+			break;
+		}
+		prev = entry;
+	}
+	if(!entry && storage) {
+		entry = (SDL_TLSEntry *) SDL_malloc(sizeof(*entry));
+		if(entry) {
+			entry->thread = thread;
+			entry->storage = storage;
+			entry->next = SDL_generic_TLS;
+			SDL_generic_TLS = entry;
+		}
+	}
+	SDL_AtomicUnlock(&SDL_generic_TLS_lock);
+
+	if(!entry && storage) {
+		return -1;
+	}
+	return 0;
+}
+
+/* The default (non-thread-safe) global error variable, used until thread
+   local storage is available or if allocating the thread's buffer fails */
 static SDL_error SDL_global_error;
 
 /* Routine to get the thread-specific error variable */
 SDL_error *SDL_GetErrBuf(void) {
+	static SDL_SpinLock tls_lock;
+	static SDL_bool tls_being_created;
+	static SDL_TLSID tls_errbuf;
+	SDL_error *const ALLOCATION_IN_PROGRESS = (SDL_error *) -1;
 	SDL_error *errbuf;
 
-	errbuf = &SDL_global_error;
-	if(SDL_Threads) {
-		int i;
-		Uint32 this_thread;
-
-		this_thread = SDL_ThreadID();
-		SDL_mutexP(thread_lock);
-		for (i = 0; i < SDL_numthreads; ++i) {
-			if(this_thread == SDL_Threads[i]->threadid) {
-				errbuf = &SDL_Threads[i]->errbuf;
-				break;
-			}
+	/* tls_being_created prevents recursion if SDL_TLSCreate() fails */
+	if(!tls_errbuf && !tls_being_created) {
+		SDL_AtomicLock(&tls_lock);
+		if(!tls_errbuf) {
+			SDL_TLSID slot;
+			tls_being_created = SDL_TRUE;
+			slot = SDL_TLSCreate();
+			tls_being_created = SDL_FALSE;
+			SDL_MemoryBarrierRelease();
+			tls_errbuf = slot;
 		}
-		SDL_mutexV(thread_lock);
+		SDL_AtomicUnlock(&tls_lock);
+	}
+	if(!tls_errbuf) {
+		return (&SDL_global_error);
+	}
+
+	SDL_MemoryBarrierAcquire();
+	errbuf = (SDL_error *) SDL_TLSGet(tls_errbuf);
+	if(errbuf == ALLOCATION_IN_PROGRESS) {
+		return (&SDL_global_error);
+	}
+	if(!errbuf) {
+		/* Mark that we're in the middle of allocating our buffer */
+		if(SDL_TLSSetData(tls_errbuf, ALLOCATION_IN_PROGRESS, NULL) < 0) {
+			return (&SDL_global_error);
+		}
+		errbuf = (SDL_error *) SDL_malloc(sizeof(*errbuf));
+		if(!errbuf) {
+			SDL_TLSSetData(tls_errbuf, NULL, NULL);
+			return (&SDL_global_error);
+		}
+		SDL_memset(errbuf, 0, sizeof(*errbuf));
+		SDL_TLSSetData(tls_errbuf, errbuf, SDL_free);
 	}
 	return (errbuf);
 }
@@ -205,6 +391,9 @@ void SDL_RunThread(void *data) {
 
 	/* Run the function */
 	*statusloc = userfunc(userdata);
+
+	/* Clean up thread-local storage */
+	SDL_TLSCleanup();
 }
 
 #ifdef SDL_PASSED_BEGINTHREAD_ENDTHREAD
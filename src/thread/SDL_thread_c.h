@@ -66,11 +66,40 @@ struct SDL_Thread {
 	Uint32 threadid;
 	SYS_ThreadHandle handle;
 	int status;
-	SDL_error errbuf;
 	void *data;
 };
 
 /* This is the function called to run a thread */
 extern void SDL_RunThread(void *data);
 
+/* This is the system-independent thread local storage structure */
+typedef struct {
+	unsigned int limit;
+	struct {
+		void *data;
+		void (SDLCALL *destructor)(void *);
+	} array[1];
+} SDL_TLSData;
+
+/* This is how many TLS entries we allocate at once */
+#define TLS_ALLOC_CHUNKSIZE    4
+
+/* Get cross-platform, slow, thread local storage for this thread.
+   This is only intended as a fallback if getting real thread-local
+   storage fails or isn't supported on this platform.
+ */
+extern SDL_TLSData *SDL_Generic_GetTLSData(void);
+
+/* Set cross-platform, slow, thread local storage for this thread.
+   This is only intended as a fallback if getting real thread-local
+   storage fails or isn't supported on this platform.
+ */
+extern int SDL_Generic_SetTLSData(SDL_TLSData *data);
+
+/* Run the destructors and free the thread local storage of a thread */
+extern void SDL_TLSCleanupData(SDL_TLSData *storage);
+
+/* Release the thread local storage of the calling thread */
+extern void SDL_TLSCleanup(void);
+
 #endif /* SDL_thread_c_h_ */
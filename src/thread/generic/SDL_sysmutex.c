@@ -63,6 +63,11 @@ SDL_mutex *SDL_CreateMutex(void) {
 	return mutex;
 }
 
+/* A semaphore based mutex has no cheaper non-recursive form */
+SDL_mutex *SDL_CreateFastMutex(void) {
+	return SDL_CreateMutex();
+}
+
 /* Free the mutex */
 void SDL_DestroyMutex(SDL_mutex *mutex) {
 	if(mutex) {
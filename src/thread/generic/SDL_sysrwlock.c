@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* An implementation of read/write locks using a mutex and a condition
+   variable. Waiting writers block new readers so they can't starve.
+*/
+
+#include "SDL_thread.h"
+#include "SDL_systhread_c.h"
+
+struct SDL_rwlock {
+	SDL_mutex *lock;
+	SDL_cond *cond;
+	int readers;            /* Number of threads holding the read lock */
+	int writer;             /* Non-zero while the write lock is held */
+	int waiting_writers;    /* Writers blocked in SDL_LockRWLockForWriting() */
+};
+
+SDL_rwlock *SDL_CreateRWLock(void) {
+	SDL_rwlock *rwlock;
+
+	rwlock = (SDL_rwlock *) SDL_calloc(1, sizeof(*rwlock));
+	if(rwlock) {
+#if !SDL_THREADS_DISABLED
+		rwlock->lock = SDL_CreateFastMutex();
+		rwlock->cond = SDL_CreateCond();
+		if(!rwlock->lock || !rwlock->cond) {
+			SDL_DestroyRWLock(rwlock);
+			rwlock = NULL;
+		}
+#endif
+	} else {
+		SDL_OutOfMemory();
+	}
+	return rwlock;
+}
+
+void SDL_DestroyRWLock(SDL_rwlock *rwlock) {
+	if(rwlock) {
+		if(rwlock->cond) {
+			SDL_DestroyCond(rwlock->cond);
+		}
+		if(rwlock->lock) {
+			SDL_DestroyMutex(rwlock->lock);
+		}
+		SDL_free(rwlock);
+	}
+}
+
+static int SDL_LockRWLock(SDL_rwlock *rwlock, SDL_bool write, SDL_bool block) {
+#if SDL_THREADS_DISABLED
+	return 0;
+#else
+	int retval = 0;
+
+	if(rwlock == NULL) {
+		SDL_SetError("Passed a NULL rwlock");
+		return -1;
+	}
+
+	SDL_mutexP(rwlock->lock);
+	if(write) {
+		++rwlock->waiting_writers;
+		while (rwlock->writer || rwlock->readers) {
+			if(!block) {
+				retval = SDL_MUTEX_TIMEDOUT;
+				break;
+			}
+			SDL_CondWait(rwlock->cond, rwlock->lock);
+		}
+		--rwlock->waiting_writers;
+		if(retval == 0) {
+			rwlock->writer = 1;
+		}
+	} else {
+		while (rwlock->writer || rwlock->waiting_writers) {
+			if(!block) {
+				retval = SDL_MUTEX_TIMEDOUT;
+				break;
+			}
+			SDL_CondWait(rwlock->cond, rwlock->lock);
+		}
+		if(retval == 0) {
+			++rwlock->readers;
+		}
+	}
+	SDL_mutexV(rwlock->lock);
+	return retval;
+#endif /* SDL_THREADS_DISABLED */
+}
+
+int SDL_LockRWLockForReading(SDL_rwlock *rwlock) {
+	return SDL_LockRWLock(rwlock, SDL_FALSE, SDL_TRUE);
+}
+
+int SDL_LockRWLockForWriting(SDL_rwlock *rwlock) {
+	return SDL_LockRWLock(rwlock, SDL_TRUE, SDL_TRUE);
+}
+
+int SDL_TryLockRWLockForReading(SDL_rwlock *rwlock) {
+	return SDL_LockRWLock(rwlock, SDL_FALSE, SDL_FALSE);
+}
+
+int SDL_TryLockRWLockForWriting(SDL_rwlock *rwlock) {
+	return SDL_LockRWLock(rwlock, SDL_TRUE, SDL_FALSE);
+}
+
+int SDL_UnlockRWLock(SDL_rwlock *rwlock) {
+#if SDL_THREADS_DISABLED
+	return 0;
+#else
+	if(rwlock == NULL) {
+		SDL_SetError("Passed a NULL rwlock");
+		return -1;
+	}
+
+	SDL_mutexP(rwlock->lock);
+	if(rwlock->writer) {
+		rwlock->writer = 0;
+	} else if(rwlock->readers > 0) {
+		--rwlock->readers;
+	} else {
+		SDL_mutexV(rwlock->lock);
+		SDL_SetError("rwlock not held by this thread");
+		return -1;
+	}
+	if(rwlock->readers == 0) {
+		SDL_CondBroadcast(rwlock->cond);
+	}
+	SDL_mutexV(rwlock->lock);
+	return 0;
+#endif /* SDL_THREADS_DISABLED */
+}
@@ -60,6 +60,11 @@ SDL_mutex *SDL_CreateMutex(void) {
 	return (mutex);
 }
 
+/* GNU pth has no cheaper non-recursive mutex */
+SDL_mutex *SDL_CreateFastMutex(void) {
+	return SDL_CreateMutex();
+}
+
 /* Free the mutex */
 void SDL_DestroyMutex(SDL_mutex *mutex) {
 	if(mutex) {
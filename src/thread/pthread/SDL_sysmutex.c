@@ -40,7 +40,7 @@
 
 #if !SDL_THREAD_PTHREAD_RECURSIVE_MUTEX && \
     !SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP
-#define FAKE_RECURSIVE_MUTEX
+#define FAKE_RECURSIVE_MUTEX 1
 #endif
 
 struct SDL_mutex {
@@ -48,25 +48,17 @@ struct SDL_mutex {
 #if FAKE_RECURSIVE_MUTEX
 	int recursive;
 	pthread_t owner;
+	SDL_bool fast;
 #endif
 };
 
-SDL_mutex *SDL_CreateMutex(void) {
+static SDL_mutex *SDL_CreateMutexWithAttr(pthread_mutexattr_t *attr) {
 	SDL_mutex *mutex;
-	pthread_mutexattr_t attr;
 
 	/* Allocate the structure */
 	mutex = (SDL_mutex *) SDL_calloc(1, sizeof(*mutex));
 	if(mutex) {
-		pthread_mutexattr_init(&attr);
-#if SDL_THREAD_PTHREAD_RECURSIVE_MUTEX
-		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-#elif SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP
-		pthread_mutexattr_setkind_np(&attr, PTHREAD_MUTEX_RECURSIVE_NP);
-#else
-		/* No extra attributes necessary */
-#endif
-		if(pthread_mutex_init(&mutex->id, &attr) != 0) {
+		if(pthread_mutex_init(&mutex->id, attr) != 0) {
 			SDL_SetError("pthread_mutex_init() failed");
 			SDL_free(mutex);
 			mutex = NULL;
@@ -74,6 +66,39 @@ SDL_mutex *SDL_CreateMutex(void) {
 	} else {
 		SDL_OutOfMemory();
 	}
+	pthread_mutexattr_destroy(attr);
+	return (mutex);
+}
+
+SDL_mutex *SDL_CreateMutex(void) {
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+#if SDL_THREAD_PTHREAD_RECURSIVE_MUTEX
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+#elif SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP
+	pthread_mutexattr_setkind_np(&attr, PTHREAD_MUTEX_RECURSIVE_NP);
+#else
+	/* No extra attributes necessary */
+#endif
+	return SDL_CreateMutexWithAttr(&attr);
+}
+
+SDL_mutex *SDL_CreateFastMutex(void) {
+	SDL_mutex *mutex;
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+#ifdef PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP
+	/* Spin for a short while in user space before sleeping in the kernel */
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+#endif
+	mutex = SDL_CreateMutexWithAttr(&attr);
+#if FAKE_RECURSIVE_MUTEX
+	if(mutex) {
+		mutex->fast = SDL_TRUE;
+	}
+#endif
 	return (mutex);
 }
 
@@ -98,6 +123,13 @@ int SDL_mutexP(SDL_mutex *mutex) {
 
 	retval = 0;
 #if FAKE_RECURSIVE_MUTEX
+	if(mutex->fast) {
+		if(pthread_mutex_lock(&mutex->id) != 0) {
+			SDL_SetError("pthread_mutex_lock() failed");
+			retval = -1;
+		}
+		return retval;
+	}
 	this_thread = pthread_self();
 	if ( mutex->owner == this_thread ) {
 		++mutex->recursive;
@@ -115,7 +147,7 @@ int SDL_mutexP(SDL_mutex *mutex) {
 		}
 	}
 #else
-	if(pthread_mutex_lock(&mutex->id) < 0) {
+	if(pthread_mutex_lock(&mutex->id) != 0) {
 		SDL_SetError("pthread_mutex_lock() failed");
 		retval = -1;
 	}
@@ -133,6 +165,13 @@ int SDL_mutexV(SDL_mutex *mutex) {
 
 	retval = 0;
 #if FAKE_RECURSIVE_MUTEX
+	if(mutex->fast) {
+		if(pthread_mutex_unlock(&mutex->id) != 0) {
+			SDL_SetError("pthread_mutex_unlock() failed");
+			retval = -1;
+		}
+		return retval;
+	}
 	/* We can only unlock the mutex if we own it */
 	if ( pthread_self() == mutex->owner ) {
 		if ( mutex->recursive ) {
@@ -152,7 +191,7 @@ int SDL_mutexV(SDL_mutex *mutex) {
 	}
 
 #else
-	if(pthread_mutex_unlock(&mutex->id) < 0) {
+	if(pthread_mutex_unlock(&mutex->id) != 0) {
 		SDL_SetError("pthread_mutex_unlock() failed");
 		retval = -1;
 	}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <pthread.h>
+
+#include "SDL_thread.h"
+
+struct SDL_rwlock {
+	pthread_rwlock_t id;
+};
+
+SDL_rwlock *SDL_CreateRWLock(void) {
+	SDL_rwlock *rwlock;
+
+	/* Allocate the structure */
+	rwlock = (SDL_rwlock *) SDL_calloc(1, sizeof(*rwlock));
+	if(rwlock) {
+		if(pthread_rwlock_init(&rwlock->id, NULL) != 0) {
+			SDL_SetError("pthread_rwlock_init() failed");
+			SDL_free(rwlock);
+			rwlock = NULL;
+		}
+	} else {
+		SDL_OutOfMemory();
+	}
+	return (rwlock);
+}
+
+void SDL_DestroyRWLock(SDL_rwlock *rwlock) {
+	if(rwlock) {
+		pthread_rwlock_destroy(&rwlock->id);
+		SDL_free(rwlock);
+	}
+}
+
+int SDL_LockRWLockForReading(SDL_rwlock *rwlock) {
+	if(rwlock == NULL) {
+		SDL_SetError("Passed a NULL rwlock");
+		return -1;
+	}
+	if(pthread_rwlock_rdlock(&rwlock->id) != 0) {
+		SDL_SetError("pthread_rwlock_rdlock() failed");
+		return -1;
+	}
+	return 0;
+}
+
+int SDL_LockRWLockForWriting(SDL_rwlock *rwlock) {
+	if(rwlock == NULL) {
+		SDL_SetError("Passed a NULL rwlock");
+		return -1;
+	}
+	if(pthread_rwlock_wrlock(&rwlock->id) != 0) {
+		SDL_SetError("pthread_rwlock_wrlock() failed");
+		return -1;
+	}
+	return 0;
+}
+
+int SDL_TryLockRWLockForReading(SDL_rwlock *rwlock) {
+	int rc;
+
+	if(rwlock == NULL) {
+		SDL_SetError("Passed a NULL rwlock");
+		return -1;
+	}
+	rc = pthread_rwlock_tryrdlock(&rwlock->id);
+	if(rc == EBUSY || rc == EAGAIN) {
+		return SDL_MUTEX_TIMEDOUT;
+	} else if(rc != 0) {
+		SDL_SetError("pthread_rwlock_tryrdlock() failed");
+		return -1;
+	}
+	return 0;
+}
+
+int SDL_TryLockRWLockForWriting(SDL_rwlock *rwlock) {
+	int rc;
+
+	if(rwlock == NULL) {
+		SDL_SetError("Passed a NULL rwlock");
+		return -1;
+	}
+	rc = pthread_rwlock_trywrlock(&rwlock->id);
+	if(rc == EBUSY) {
+		return SDL_MUTEX_TIMEDOUT;
+	} else if(rc != 0) {
+		SDL_SetError("pthread_rwlock_trywrlock() failed");
+		return -1;
+	}
+	return 0;
+}
+
+int SDL_UnlockRWLock(SDL_rwlock *rwlock) {
+	if(rwlock == NULL) {
+		SDL_SetError("Passed a NULL rwlock");
+		return -1;
+	}
+	if(pthread_rwlock_unlock(&rwlock->id) != 0) {
+		SDL_SetError("pthread_rwlock_unlock() failed");
+		return -1;
+	}
+	return 0;
+}
@@ -31,20 +31,160 @@
 #include "SDL_config.h"
 
 #include <pthread.h>
-#include <semaphore.h>
 #include <errno.h>
 #include <sys/time.h>
 
 #include "SDL_thread.h"
 #include "SDL_timer.h"
 
-/* Wrapper around POSIX 1003.1b semaphores */
-
 #ifdef __MACOSX__
 /* Mac OS X doesn't support sem_getvalue() as of version 10.4 */
 #include "../generic/SDL_syssem.c"
+#elif defined(__LINUX__)
+
+/* Semaphores on top of a Linux futex.
+   The count lives in user space and an uncontended wait or post is a
+   single atomic operation. Only a waiter that finds the count at zero
+   enters the kernel, and FUTEX_WAIT takes a relative timeout so timed
+   waits sleep instead of polling.
+*/
+
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#include "SDL_atomic.h"
+
+#ifndef FUTEX_PRIVATE_FLAG
+#define FUTEX_PRIVATE_FLAG    0
+#endif
+
+struct SDL_semaphore {
+	SDL_atomic_t count;
+	SDL_atomic_t waiters;
+};
+
+static int futex(SDL_atomic_t *a, int op, int val, const struct timespec *timeout) {
+	return syscall(SYS_futex, &a->value, op | FUTEX_PRIVATE_FLAG, val, timeout, NULL, 0);
+}
+
+/* Create a semaphore, initialized with value */
+SDL_sem *SDL_CreateSemaphore(Uint32 initial_value) {
+	SDL_sem *sem = (SDL_sem *) SDL_malloc(sizeof(SDL_sem));
+	if(sem) {
+		SDL_AtomicSet(&sem->count, (int) initial_value);
+		SDL_AtomicSet(&sem->waiters, 0);
+	} else {
+		SDL_OutOfMemory();
+	}
+	return sem;
+}
+
+void SDL_DestroySemaphore(SDL_sem *sem) {
+	if(sem) {
+		SDL_free(sem);
+	}
+}
+
+int SDL_SemTryWait(SDL_sem *sem) {
+	int value;
+
+	if(!sem) {
+		SDL_SetError("Passed a NULL semaphore");
+		return -1;
+	}
+	value = SDL_AtomicGet(&sem->count);
+	while (value > 0) {
+		if(SDL_AtomicCAS(&sem->count, value, value - 1)) {
+			return 0;
+		}
+		value = SDL_AtomicGet(&sem->count);
+	}
+	return SDL_MUTEX_TIMEDOUT;
+}
+
+int SDL_SemWaitTimeout(SDL_sem *sem, Uint32 timeout) {
+	struct timespec now, end, left;
+	int retval;
+
+	/* Try the easy cases first */
+	retval = SDL_SemTryWait(sem);
+	if(retval != SDL_MUTEX_TIMEDOUT || timeout == 0) {
+		return retval;
+	}
+
+	if(timeout != SDL_MUTEX_MAXWAIT) {
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		end.tv_sec += timeout / 1000;
+		end.tv_nsec += (timeout % 1000) * 1000000;
+		if(end.tv_nsec >= 1000000000) {
+			end.tv_nsec -= 1000000000;
+			end.tv_sec++;
+		}
+	}
+
+	/* Announce ourselves before looking at the count again, so a post
+	   either sees us waiting or we see its increment */
+	SDL_AtomicIncRef(&sem->waiters);
+	while ((retval = SDL_SemTryWait(sem)) == SDL_MUTEX_TIMEDOUT) {
+		if(timeout == SDL_MUTEX_MAXWAIT) {
+			futex(&sem->count, FUTEX_WAIT, 0, NULL);
+			continue;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		left.tv_sec = end.tv_sec - now.tv_sec;
+		left.tv_nsec = end.tv_nsec - now.tv_nsec;
+		if(left.tv_nsec < 0) {
+			left.tv_nsec += 1000000000;
+			left.tv_sec--;
+		}
+		if(left.tv_sec < 0) {
+			break;
+		}
+		/* Sleeps only while the count is still zero, wakeups that raced
+		   with us return EAGAIN and we simply try again */
+		futex(&sem->count, FUTEX_WAIT, 0, &left);
+	}
+	SDL_AtomicAdd(&sem->waiters, -1);
+
+	return retval;
+}
+
+int SDL_SemWait(SDL_sem *sem) {
+	return SDL_SemWaitTimeout(sem, SDL_MUTEX_MAXWAIT);
+}
+
+Uint32 SDL_SemValue(SDL_sem *sem) {
+	int ret = 0;
+	if(sem) {
+		ret = SDL_AtomicGet(&sem->count);
+		if(ret < 0) {
+			ret = 0;
+		}
+	}
+	return (Uint32) ret;
+}
+
+int SDL_SemPost(SDL_sem *sem) {
+	if(!sem) {
+		SDL_SetError("Passed a NULL semaphore");
+		return -1;
+	}
+
+	SDL_AtomicAdd(&sem->count, 1);
+	if(SDL_AtomicGet(&sem->waiters) > 0) {
+		futex(&sem->count, FUTEX_WAKE, 1, NULL);
+	}
+	return 0;
+}
+
 #else
 
+/* Wrapper around POSIX 1003.1b semaphores */
+
+#include <semaphore.h>
+
 struct SDL_semaphore {
 	sem_t sem;
 };
@@ -159,7 +299,7 @@ int SDL_SemWaitTimeout(SDL_sem *sem, Uint32 timeout) {
 #else
 	end = SDL_GetTicks() + timeout;
 	while ((retval = SDL_SemTryWait(sem)) == SDL_MUTEX_TIMEDOUT) {
-		if ((SDL_GetTicks() - end) >= 0) {
+		if ((Sint32) (SDL_GetTicks() - end) >= 0) {
 			break;
 		}
 		SDL_Delay(0);
@@ -195,4 +335,4 @@ int SDL_SemPost(SDL_sem *sem) {
 	return retval;
 }
 
-#endif /* __MACOSX__ */
+#endif /* __MACOSX__ / __LINUX__ */
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+#include <pthread.h>
+
+#include "SDL_atomic.h"
+#include "SDL_thread.h"
+#include "../SDL_thread_c.h"
+#include "../SDL_systhread.h"
+
+#define INVALID_PTHREAD_KEY ((pthread_key_t)-1)
+
+static pthread_key_t thread_local_storage = INVALID_PTHREAD_KEY;
+static SDL_bool generic_local_storage = SDL_FALSE;
+
+/* Also covers threads SDL didn't create, which never reach SDL_TLSCleanup() */
+static void SDL_SYS_TLSDestructor(void *data) {
+	SDL_TLSCleanupData((SDL_TLSData *) data);
+}
+
+SDL_TLSData *SDL_SYS_GetTLSData(void) {
+	if(thread_local_storage == INVALID_PTHREAD_KEY && !generic_local_storage) {
+		static SDL_SpinLock lock;
+		SDL_AtomicLock(&lock);
+		if(thread_local_storage == INVALID_PTHREAD_KEY) {
+			pthread_key_t storage;
+			if(pthread_key_create(&storage, SDL_SYS_TLSDestructor) == 0) {
+				SDL_MemoryBarrierRelease();
+				thread_local_storage = storage;
+			} else {
+				generic_local_storage = SDL_TRUE;
+			}
+		}
+		SDL_AtomicUnlock(&lock);
+	}
+	if(generic_local_storage) {
+		return SDL_Generic_GetTLSData();
+	}
+	SDL_MemoryBarrierAcquire();
+	return (SDL_TLSData *) pthread_getspecific(thread_local_storage);
+}
+
+int SDL_SYS_SetTLSData(SDL_TLSData *data) {
+	if(generic_local_storage) {
+		return SDL_Generic_SetTLSData(data);
+	}
+	if(pthread_setspecific(thread_local_storage, data) != 0) {
+		return -1;
+	}
+	return 0;
+}
@@ -30,10 +30,12 @@
  ******************************************************************************/
 #include "SDL_config.h"
 
+#include "SDL_atomic.h"
 #include "SDL_timer.h"
 #include "SDL_timer_c.h"
 #include "SDL_mutex.h"
 #include "SDL_systimer.h"
+#include "../stdlib/SDL_pool_c.h"
 
 /* #define DEBUG_TIMERS */
 
@@ -56,8 +58,9 @@ struct _SDL_TimerID {
 };
 
 static SDL_TimerID SDL_timers = NULL;
+static SDL_Pool SDL_timer_pool = SDL_POOL_INITIALIZER(struct _SDL_TimerID, 16);
 static SDL_mutex *SDL_timer_mutex;
-static volatile SDL_bool list_changed = SDL_FALSE;
+static SDL_atomic_t list_changed;
 
 /* Set whether or not the timer should use a thread.
    This should not be called while the timer subsystem is running.
@@ -105,6 +108,7 @@ void SDL_TimerQuit(void) {
 	}
 	SDL_timer_started = 0;
 	SDL_timer_threaded = 0;
+	SDL_PoolTrim(&SDL_timer_pool);
 }
 
 void SDL_ThreadedTimerCheck(void) {
@@ -113,7 +117,7 @@ void SDL_ThreadedTimerCheck(void) {
 	SDL_bool removed;
 
 	SDL_mutexP(SDL_timer_mutex);
-	list_changed = SDL_FALSE;
+	SDL_AtomicSet(&list_changed, SDL_FALSE);
 	now = SDL_GetTicks();
 	for (prev = NULL, t = SDL_timers; t; t = next) {
 		removed = SDL_FALSE;
@@ -135,7 +139,7 @@ void SDL_ThreadedTimerCheck(void) {
 			SDL_mutexV(SDL_timer_mutex);
 			ms = timer.cb(timer.interval, timer.param);
 			SDL_mutexP(SDL_timer_mutex);
-			if(list_changed) {
+			if(SDL_AtomicGet(&list_changed)) {
 				/* Abort, list of timers modified */
 				/* FIXME: what if ms was changed? */
 				break;
@@ -153,7 +157,7 @@ void SDL_ThreadedTimerCheck(void) {
 					} else {
 						SDL_timers = next;
 					}
-					SDL_free(t);
+					SDL_PoolFree(&SDL_timer_pool, t);
 					--SDL_timer_running;
 					removed = SDL_TRUE;
 				}
@@ -169,7 +173,7 @@ void SDL_ThreadedTimerCheck(void) {
 
 static SDL_TimerID SDL_AddTimerInternal(Uint32 interval, SDL_NewTimerCallback callback, void *param) {
 	SDL_TimerID t;
-	t = (SDL_TimerID) SDL_malloc(sizeof(struct _SDL_TimerID));
+	t = (SDL_TimerID) SDL_PoolAlloc(&SDL_timer_pool);
 	if(t) {
 		t->interval = ROUND_RESOLUTION(interval);
 		t->cb = callback;
@@ -178,7 +182,7 @@ static SDL_TimerID SDL_AddTimerInternal(Uint32 interval, SDL_NewTimerCallback ca
 		t->next = SDL_timers;
 		SDL_timers = t;
 		++SDL_timer_running;
-		list_changed = SDL_TRUE;
+		SDL_AtomicSet(&list_changed, SDL_TRUE);
 	}
 #ifdef DEBUG_TIMERS
 	printf("SDL_AddTimer(%d) = %08x num_timers = %d\n", interval, (Uint32)t, SDL_timer_running);
@@ -220,10 +224,10 @@ SDL_bool SDL_RemoveTimer(SDL_TimerID id) {
 			} else {
 				SDL_timers = t->next;
 			}
-			SDL_free(t);
+			SDL_PoolFree(&SDL_timer_pool, t);
 			--SDL_timer_running;
 			removed = SDL_TRUE;
-			list_changed = SDL_TRUE;
+			SDL_AtomicSet(&list_changed, SDL_TRUE);
 			break;
 		}
 	}
@@ -256,10 +260,10 @@ int SDL_SetTimer(Uint32 ms, SDL_TimerCallback callback) {
 			while (SDL_timers) {
 				SDL_TimerID freeme = SDL_timers;
 				SDL_timers = SDL_timers->next;
-				SDL_free(freeme);
+				SDL_PoolFree(&SDL_timer_pool, freeme);
 			}
 			SDL_timer_running = 0;
-			list_changed = SDL_TRUE;
+			SDL_AtomicSet(&list_changed, SDL_TRUE);
 		} else {
 			SDL_SYS_StopTimer();
 			SDL_timer_running = 0;
@@ -50,6 +50,9 @@ extern int SDL_SetTimerThreaded(int value);
 
 extern int SDL_TimerInit(void);
 
+/* Convert a CLOCK_MONOTONIC time, as found on input events, to ticks */
+extern Uint32 SDL_MonotonicToTicks(long sec, long usec);
+
 extern void SDL_TimerQuit(void);
 
 /* This function is called from the SDL event thread if it is available */
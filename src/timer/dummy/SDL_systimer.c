@@ -43,10 +43,23 @@ Uint32 SDL_GetTicks(void) {
 	return 0;
 }
 
+Uint32 SDL_MonotonicToTicks(long sec, long usec) {
+	return 0;
+}
+
 void SDL_Delay(Uint32 ms) {
 	SDL_Unsupported();
 }
 
+Uint64 SDL_GetPerformanceCounter(void) {
+	SDL_Unsupported();
+	return 0;
+}
+
+Uint64 SDL_GetPerformanceFrequency(void) {
+	return 1;
+}
+
 #include "SDL_thread.h"
 
 /* Data to handle a single periodic alarm */
@@ -94,6 +94,35 @@ Uint32 SDL_GetTicks(void) {
 #endif
 }
 
+Uint32 SDL_MonotonicToTicks(long sec, long usec) {
+#if HAVE_CLOCK_GETTIME
+	return ((sec - start.tv_sec) * 1000 + usec / 1000 - start.tv_nsec / 1000000);
+#else
+	/* Ticks aren't based on the monotonic clock here */
+	return (SDL_GetTicks());
+#endif
+}
+
+Uint64 SDL_GetPerformanceCounter(void) {
+#if HAVE_CLOCK_GETTIME
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((Uint64) now.tv_sec * 1000000000 + now.tv_nsec);
+#else
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	return ((Uint64) now.tv_sec * 1000000 + now.tv_usec);
+#endif
+}
+
+Uint64 SDL_GetPerformanceFrequency(void) {
+#if HAVE_CLOCK_GETTIME
+	return 1000000000;
+#else
+	return 1000000;
+#endif
+}
+
 void SDL_Delay(Uint32 ms) {
 #if SDL_THREAD_PTH
 	pth_time_t tv;
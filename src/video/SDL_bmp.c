@@ -54,7 +54,7 @@
 #endif
 
 
-SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, int freesrc) {
+static SDL_Surface *SDL_LoadBMP_Internal(SDL_RWops *src, int freesrc, SDL_bool inplace) {
 	SDL_bool was_error;
 	long fp_offset = 0;
 	int bmpPitch;
@@ -68,6 +68,11 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, int freesrc) {
 	Uint8 *top, *end;
 	SDL_bool topDown;
 	int ExpandBMP;
+	Uint8 colors[256 * 4];
+	int colorSize;
+	const Uint8 *mem;
+	int memSize;
+	Uint8 *mapped;
 
 	/* The Win32 BMP file header (14 bytes) */
 	char magic[2];
@@ -242,8 +247,30 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, int freesrc) {
 			goto done;
 	}
 
+	/* Top-down rows that need no expanding or swapping can be used as they
+	   are, as long as 16 and 32 bit pixels are aligned */
+	mapped = NULL;
+	bmpPitch = ((biWidth * ((biBitCount + 7) >> 3)) + 3) & ~3;
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+	if(biBitCount != 8 && biBitCount != 24) {
+		inplace = SDL_FALSE;
+	}
+#endif
+	if(inplace && topDown && !ExpandBMP && bmpPitch <= 0xFFFF) {
+		mem = (const Uint8 *) SDL_RWGetMemory(src, &memSize);
+		if(mem && fp_offset >= 0 &&
+		   (Uint64) fp_offset + bfOffBits + (Uint64) bmpPitch * biHeight <= (Uint64) memSize &&
+		   (((size_t) (mem + fp_offset + bfOffBits)) & ((biBitCount + 7) / 8 == 3 ? 0 : (biBitCount + 7) / 8 - 1)) == 0) {
+			mapped = (Uint8 *) mem + fp_offset + bfOffBits;
+		}
+	}
+
 	/* Create a compatible surface, note that the colors are RGB ordered */
-	surface = SDL_CreateRGBSurface(SDL_SWSURFACE, biWidth, biHeight, biBitCount, Rmask, Gmask, Bmask, 0);
+	if(mapped) {
+		surface = SDL_CreateRGBSurfaceFrom(mapped, biWidth, biHeight, biBitCount, bmpPitch, Rmask, Gmask, Bmask, 0);
+	} else {
+		surface = SDL_CreateRGBSurface(SDL_SWSURFACE, biWidth, biHeight, biBitCount, Rmask, Gmask, Bmask, 0);
+	}
 	if(surface == NULL) {
 		was_error = SDL_TRUE;
 		goto done;
@@ -259,24 +286,39 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, int freesrc) {
 			was_error = SDL_TRUE;
 			goto done;
 		}
-		if(biSize == 12) {
-			for (i = 0; i < (int) biClrUsed; ++i) {
-				SDL_RWread(src, &palette->colors[i].b, 1, 1);
-				SDL_RWread(src, &palette->colors[i].g, 1, 1);
-				SDL_RWread(src, &palette->colors[i].r, 1, 1);
-				palette->colors[i].unused = 0;
-			}
-		} else {
-			for (i = 0; i < (int) biClrUsed; ++i) {
-				SDL_RWread(src, &palette->colors[i].b, 1, 1);
-				SDL_RWread(src, &palette->colors[i].g, 1, 1);
-				SDL_RWread(src, &palette->colors[i].r, 1, 1);
-				SDL_RWread(src, &palette->colors[i].unused, 1, 1);
-			}
+		/* The whole color table in one go, BGR(A) entries */
+		colorSize = (biSize == 12) ? 3 : 4;
+		if(SDL_RWread(src, colors, colorSize, biClrUsed) != (int) biClrUsed) {
+			SDL_Error(SDL_EFREAD);
+			was_error = SDL_TRUE;
+			goto done;
+		}
+		for (i = 0; i < (int) biClrUsed; ++i) {
+			palette->colors[i].b = colors[i * colorSize];
+			palette->colors[i].g = colors[i * colorSize + 1];
+			palette->colors[i].r = colors[i * colorSize + 2];
+			palette->colors[i].unused = (colorSize == 4) ? colors[i * colorSize + 3] : 0;
 		}
 		palette->ncolors = biClrUsed;
 	}
 
+	if(mapped) {
+		/* Nothing to copy, only check the indices and leave src past the image */
+		if(8 == biBitCount && palette && biClrUsed < (1 << biBitCount)) {
+			for (bits = mapped; bits < mapped + biHeight * bmpPitch; bits += bmpPitch) {
+				for (i = 0; i < surface->w; ++i) {
+					if(bits[i] >= biClrUsed) {
+						SDL_SetError("A BMP image contains a pixel with a color out of the palette");
+						was_error = SDL_TRUE;
+						goto done;
+					}
+				}
+			}
+		}
+		SDL_RWseek(src, fp_offset + bfOffBits + biHeight * bmpPitch, RW_SEEK_SET);
+		goto done;
+	}
+
 	/* Read the surface pixels.  Note that the bmp image is upside down */
 	if(SDL_RWseek(src, fp_offset + bfOffBits, RW_SEEK_SET) < 0) {
 		SDL_Error(SDL_EFSEEK);
@@ -367,10 +409,7 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, int freesrc) {
 		}
 		/* Skip padding bytes, ugh */
 		if(pad) {
-			Uint8 padbyte;
-			for (i = 0; i < pad; ++i) {
-				SDL_RWread(src, &padbyte, 1, 1);
-			}
+			SDL_RWseek(src, pad, RW_SEEK_CUR);
 		}
 		if(topDown) {
 			bits += surface->pitch;
@@ -394,6 +433,14 @@ done:
 	return (surface);
 }
 
+SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, int freesrc) {
+	return SDL_LoadBMP_Internal(src, freesrc, SDL_FALSE);
+}
+
+SDL_Surface *SDL_LoadBMP_InPlace(SDL_RWops *src) {
+	return SDL_LoadBMP_Internal(src, 0, SDL_TRUE);
+}
+
 int SDL_SaveBMP_RW(SDL_Surface *saveme, SDL_RWops *dst, int freedst) {
 	long fp_offset;
 	int i, pad;
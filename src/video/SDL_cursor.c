@@ -126,29 +126,25 @@ SDL_Cursor *SDL_CreateCursor(Uint8 *data, Uint8 *mask, int w, int h, int hot_x,
 		return (NULL);
 	}
 
-	/* Allocate memory for the cursor */
-	cursor = (SDL_Cursor *) SDL_malloc(sizeof *cursor);
+	/* Allocate the cursor with its save areas and bitmaps in one block,
+	   the save areas first so their pixels stay aligned */
+	savelen = (w * 4) * h;
+	cursor = (SDL_Cursor *) SDL_malloc(sizeof *cursor + savelen * 2 + (w / 8) * h * 2);
 	if(cursor == NULL) {
 		SDL_OutOfMemory();
 		return (NULL);
 	}
-	savelen = (w * 4) * h;
 	cursor->area.x = 0;
 	cursor->area.y = 0;
 	cursor->area.w = w;
 	cursor->area.h = h;
 	cursor->hot_x = hot_x;
 	cursor->hot_y = hot_y;
-	cursor->data = (Uint8 *) SDL_malloc((w / 8) * h * 2);
-	cursor->mask = cursor->data + ((w / 8) * h);
-	cursor->save[0] = (Uint8 *) SDL_malloc(savelen * 2);
+	cursor->save[0] = (Uint8 *) (cursor + 1);
 	cursor->save[1] = cursor->save[0] + savelen;
+	cursor->data = cursor->save[1] + savelen;
+	cursor->mask = cursor->data + ((w / 8) * h);
 	cursor->wm_cursor = NULL;
-	if(!cursor->data || !cursor->save[0]) {
-		SDL_FreeCursor(cursor);
-		SDL_OutOfMemory();
-		return (NULL);
-	}
 	for (i = ((w / 8) * h) - 1; i >= 0; --i) {
 		cursor->data[i] = data[i];
 		cursor->mask[i] = mask[i] | data[i];
@@ -247,12 +243,6 @@ void SDL_FreeCursor(SDL_Cursor *cursor) {
 			SDL_VideoDevice *video = current_video;
 			SDL_VideoDevice *this = current_video;
 
-			if(cursor->data) {
-				SDL_free(cursor->data);
-			}
-			if(cursor->save[0]) {
-				SDL_free(cursor->save[0]);
-			}
 			if(video && cursor->wm_cursor) {
 				if(video->FreeWMCursor) {
 					video->FreeWMCursor(this, cursor->wm_cursor);
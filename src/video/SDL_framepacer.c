@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+#include "SDL_config.h"
+
+/* Frame pacing on top of SDL_Flip() */
+
+#include "SDL_video.h"
+#include "SDL_timer.h"
+#include "SDL_sysvideo.h"
+
+/* Assumed refresh rate when the video driver can't report one */
+#define PACER_DEFAULT_PERIOD    (1000000 / 60)
+
+/* Lateness still considered on time, in microseconds */
+#define PACER_TOLERANCE(period) ((period) / 8)
+
+/* Below this many microseconds we busy-wait instead of sleeping */
+#define PACER_SPIN_THRESHOLD    1500
+
+static struct {
+	SDL_VideoDevice *video;
+	Uint32 interval;
+	Uint64 freq_div;   /* counter ticks per microsecond */
+	Uint64 deadline;   /* next presentation target, in microseconds */
+	Uint64 last;       /* time of the last presentation */
+	SDL_FrameStats stats;
+} pacer = {NULL, 1, 0, 0, 0, {0, 1, 0, 0, 0, 0, 0}};
+
+static Uint64 SDL_PacerTicks(void) {
+	if(pacer.freq_div == 0) {
+		pacer.freq_div = SDL_GetPerformanceFrequency() / 1000000;
+		if(pacer.freq_div == 0) {
+			pacer.freq_div = 1;
+		}
+	}
+	return (SDL_GetPerformanceCounter() / pacer.freq_div);
+}
+
+static void SDL_PacerWaitUntil(Uint64 target) {
+	Uint64 now = SDL_PacerTicks();
+
+	while (now < target) {
+		/* Sleep for the bulk of the wait and spin for the tail, the
+		   scheduler will rarely wake us up with sub-millisecond accuracy */
+		if(target - now > PACER_SPIN_THRESHOLD) {
+			SDL_Delay((Uint32) ((target - now - PACER_SPIN_THRESHOLD) / 1000) + 1);
+		}
+		now = SDL_PacerTicks();
+	}
+}
+
+/* Pick up the refresh period of the current video mode */
+static void SDL_PacerSync(void) {
+	Uint32 period = SDL_GetRefreshPeriod();
+
+	if(period == 0) {
+		period = PACER_DEFAULT_PERIOD;
+	}
+	if(pacer.video != current_video || pacer.stats.refresh_period != period) {
+		pacer.video = current_video;
+		pacer.stats.refresh_period = period;
+		pacer.deadline = 0;
+		pacer.last = 0;
+	}
+}
+
+Uint32 SDL_GetRefreshPeriod(void) {
+	SDL_VideoDevice *video = current_video;
+	SDL_VideoDevice *this = current_video;
+
+	if(!video) {
+		SDL_SetError("Video subsystem has not been initialized");
+		return (0);
+	}
+	if(!video->GetRefreshPeriod) {
+		return (0);
+	}
+	return (video->GetRefreshPeriod(this));
+}
+
+int SDL_SetFrameInterval(int interval) {
+	if(interval < 1) {
+		SDL_SetError("Frame interval must be at least one refresh");
+		return (-1);
+	}
+	pacer.interval = interval;
+	pacer.stats.interval = interval;
+	pacer.deadline = 0;
+	return (0);
+}
+
+int SDL_PacedFlip(SDL_Surface *screen) {
+	Uint64 period, now, late;
+	Sint64 lateness;
+	Uint32 advance, missed;
+	int retval;
+
+	if(!current_video) {
+		SDL_SetError("Video subsystem has not been initialized");
+		return (-1);
+	}
+	SDL_PacerSync();
+	period = (Uint64) pacer.stats.refresh_period * pacer.interval;
+
+	now = SDL_PacerTicks();
+	if(pacer.deadline == 0) {
+		/* First frame of a new schedule, present right away */
+		pacer.deadline = now;
+	} else if(now < pacer.deadline) {
+		/* Wake up early by the average lateness so that the flip itself
+		   lands on the deadline, but never by more than half a frame */
+		advance = 0;
+		if(pacer.stats.drift > 0) {
+			advance = pacer.stats.drift;
+			if(advance > period / 2) {
+				advance = (Uint32) (period / 2);
+			}
+		}
+		SDL_PacerWaitUntil(pacer.deadline - advance);
+	} else {
+		late = now - pacer.deadline;
+		if(late > PACER_TOLERANCE(pacer.stats.refresh_period)) {
+			/* We overran our slot and the display has moved on; present
+			   on the next refresh rather than trying to catch up with a
+			   burst of back-to-back frames */
+			missed = (Uint32) (late / pacer.stats.refresh_period) + 1;
+			pacer.stats.missed += missed;
+			pacer.deadline += (Uint64) missed * pacer.stats.refresh_period;
+			SDL_PacerWaitUntil(pacer.deadline);
+		}
+	}
+
+	retval = SDL_Flip(screen);
+
+	now = SDL_PacerTicks();
+	lateness = (Sint64) (now - pacer.deadline);
+	if(lateness > (Sint64) period) {
+		lateness = period;
+	} else if(lateness < -(Sint64) period) {
+		lateness = -(Sint64) period;
+	}
+	pacer.stats.drift = (Sint32) ((pacer.stats.drift * 7 + lateness) / 8);
+
+	if(pacer.last) {
+		pacer.stats.last_frame = (Uint32) (now - pacer.last);
+		if(pacer.stats.last_frame > pacer.stats.worst_frame) {
+			pacer.stats.worst_frame = pacer.stats.last_frame;
+		}
+	}
+	pacer.last = now;
+	++pacer.stats.frames;
+
+	/* The next deadline follows the ideal schedule, not the actual flip */
+	pacer.deadline += period;
+
+	return (retval);
+}
+
+void SDL_GetFrameStats(SDL_FrameStats *stats) {
+	if(stats) {
+		*stats = pacer.stats;
+		stats->interval = pacer.interval;
+		if(current_video && stats->refresh_period == 0) {
+			stats->refresh_period = SDL_GetRefreshPeriod();
+		}
+	}
+}
+
+void SDL_ResetFrameStats(void) {
+	pacer.video = NULL;
+	pacer.deadline = 0;
+	pacer.last = 0;
+	SDL_memset(&pacer.stats, 0, sizeof(pacer.stats));
+	pacer.stats.interval = pacer.interval;
+}
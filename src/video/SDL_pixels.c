@@ -38,6 +38,12 @@
 #include "SDL_blit.h"
 #include "SDL_pixels_c.h"
 #include "SDL_RLEaccel_c.h"
+#include "../stdlib/SDL_pool_c.h"
+
+/* Every surface has a format and a blit map, so they share its churn */
+static SDL_Pool SDL_format_pool = SDL_POOL_INITIALIZER(SDL_PixelFormat, 32);
+static SDL_Pool SDL_blitmap_pool = SDL_POOL_INITIALIZER(SDL_BlitMap, 32);
+static SDL_Pool SDL_swaccel_pool = SDL_POOL_INITIALIZER(struct private_swaccel, 32);
 
 /* Helper functions */
 
@@ -327,7 +333,7 @@ SDL_PixelFormat *SDL_AllocFormat(int bpp, Uint32 Rmask, Uint32 Gmask, Uint32 Bma
 	Uint32 mask;
 
 	/* Allocate an empty pixel format structure */
-	format = SDL_malloc(sizeof(*format));
+	format = (SDL_PixelFormat *) SDL_PoolAlloc(&SDL_format_pool);
 	if(format == NULL) {
 		SDL_OutOfMemory();
 		return (NULL);
@@ -548,7 +554,7 @@ void SDL_FreeFormat(SDL_PixelFormat *format) {
 			}
 			SDL_free(format->palette);
 		}
-		SDL_free(format);
+		SDL_PoolFree(&SDL_format_pool, format);
 	}
 }
 
@@ -804,7 +810,7 @@ SDL_BlitMap *SDL_AllocBlitMap(void) {
 	SDL_BlitMap *map;
 
 	/* Allocate the empty map */
-	map = (SDL_BlitMap *) SDL_malloc(sizeof(*map));
+	map = (SDL_BlitMap *) SDL_PoolAlloc(&SDL_blitmap_pool);
 	if(map == NULL) {
 		SDL_OutOfMemory();
 		return (NULL);
@@ -812,7 +818,7 @@ SDL_BlitMap *SDL_AllocBlitMap(void) {
 	SDL_memset(map, 0, sizeof(*map));
 
 	/* Allocate the software blit data */
-	map->sw_data = (struct private_swaccel *) SDL_malloc(sizeof(*map->sw_data));
+	map->sw_data = (struct private_swaccel *) SDL_PoolAlloc(&SDL_swaccel_pool);
 	if(map->sw_data == NULL) {
 		SDL_FreeBlitMap(map);
 		SDL_OutOfMemory();
@@ -914,9 +920,13 @@ int SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst) {
 void SDL_FreeBlitMap(SDL_BlitMap *map) {
 	if(map) {
 		SDL_InvalidateMap(map);
-		if(map->sw_data != NULL) {
-			SDL_free(map->sw_data);
-		}
-		SDL_free(map);
+		SDL_PoolFree(&SDL_swaccel_pool, map->sw_data);
+		SDL_PoolFree(&SDL_blitmap_pool, map);
 	}
 }
+
+void SDL_TrimPixelPools(void) {
+	SDL_PoolTrim(&SDL_format_pool);
+	SDL_PoolTrim(&SDL_blitmap_pool);
+	SDL_PoolTrim(&SDL_swaccel_pool);
+}
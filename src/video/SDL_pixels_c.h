@@ -52,6 +52,9 @@ extern int SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst);
 
 extern void SDL_FreeBlitMap(SDL_BlitMap *map);
 
+/* Release the spare slabs of the format and blit map pools */
+extern void SDL_TrimPixelPools(void);
+
 /* Miscellaneous functions */
 extern Uint16 SDL_CalculatePitch(SDL_Surface *surface);
 
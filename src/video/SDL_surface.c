@@ -38,6 +38,9 @@
 #include "SDL_pixels_c.h"
 #include "SDL_leaks.h"
 #include "SDL_cpuinfo.h"
+#include "../stdlib/SDL_pool_c.h"
+
+static SDL_Pool SDL_surface_pool = SDL_POOL_INITIALIZER(SDL_Surface, 32);
 
 /** Public routines */
 
@@ -91,7 +94,7 @@ SDL_Surface *SDL_CreateRGBSurface(Uint32 flags, int width, int height, int depth
 	}
 
 	/* Allocate the surface */
-	surface = (SDL_Surface *) SDL_malloc(sizeof(*surface));
+	surface = (SDL_Surface *) SDL_PoolAlloc(&SDL_surface_pool);
 	if(surface == NULL) {
 		SDL_OutOfMemory();
 		return (NULL);
@@ -114,7 +117,7 @@ SDL_Surface *SDL_CreateRGBSurface(Uint32 flags, int width, int height, int depth
 	}
 	surface->format = SDL_AllocFormat(depth, Rmask, Gmask, Bmask, Amask);
 	if(surface->format == NULL) {
-		SDL_free(surface);
+		SDL_PoolFree(&SDL_surface_pool, surface);
 		return (NULL);
 	}
 	if(Amask) {
@@ -1068,8 +1071,12 @@ void SDL_FreeSurface(SDL_Surface *surface) {
 	if(surface->pixels && ((surface->flags & SDL_PREALLOC) != SDL_PREALLOC)) {
 		SDL_free(surface->pixels);
 	}
-	SDL_free(surface);
+	SDL_PoolFree(&SDL_surface_pool, surface);
 #ifdef CHECK_LEAKS
 	--surfaces_allocated;
 #endif
 }
+
+void SDL_TrimSurfacePool(void) {
+	SDL_PoolTrim(&SDL_surface_pool);
+}
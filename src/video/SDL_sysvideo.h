@@ -33,6 +33,7 @@
 #ifndef SDL_sysvideo_h_
 #define SDL_sysvideo_h_
 
+#include "SDL_keyboard.h"
 #include "SDL_mouse.h"
 
 #define SDL_PROTOTYPES_ONLY
@@ -163,6 +164,11 @@ struct SDL_VideoDevice {
 	/* Performs hardware flipping */
 	int (*FlipHWSurface)(_THIS, SDL_Surface *surface);
 
+	/* Returns the duration of one display refresh of the current video
+	   mode in microseconds, or 0 if the driver can't tell.
+	 */
+	Uint32 (*GetRefreshPeriod)(_THIS);
+
 	/* Frees a previously allocated video surface */
 	void (*FreeHWSurface)(_THIS, SDL_Surface *surface);
 
@@ -302,6 +308,9 @@ struct SDL_VideoDevice {
 	/* Handle any queued OS events */
 	void (*PumpEvents)(_THIS);
 
+	/* Remap raw key codes, optional */
+	int (*RemapKeys)(_THIS, const SDL_KeyRemap *table, int count);
+
 	/* * * */
 	/* Data common to all drivers */
 	SDL_Surface *screen;
@@ -381,6 +390,9 @@ extern VideoBootStrap DUMMY_bootstrap;
 /* This is the current video device */
 extern SDL_VideoDevice *current_video;
 
+/* Release the spare slabs of the surface pool */
+extern void SDL_TrimSurfacePool(void);
+
 #define SDL_VideoSurface    (current_video->screen)
 #define SDL_ShadowSurface    (current_video->shadow)
 #define SDL_PublicSurface    (current_video->visible)
@@ -832,6 +832,9 @@ SDL_Surface *SDL_SetVideoMode(int width, int height, int bpp, Uint32 flags) {
 	video->info.current_w = SDL_VideoSurface->w;
 	video->info.current_h = SDL_VideoSurface->h;
 
+	/* The refresh period may have changed with the mode */
+	SDL_ResetFrameStats();
+
 	/* We're done! */
 	return (SDL_PublicSurface);
 }
@@ -1292,6 +1295,10 @@ void SDL_VideoQuit(void) {
 		/* Finish cleaning up video subsystem */
 		video->free(this);
 		current_video = NULL;
+
+		/* Surfaces the application still holds keep their slabs */
+		SDL_TrimSurfacePool();
+		SDL_TrimPixelPools();
 	}
 	return;
 }
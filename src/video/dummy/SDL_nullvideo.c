@@ -80,6 +80,8 @@ static void DUMMY_FreeHWSurface(_THIS, SDL_Surface *surface);
 /* etc. */
 static void DUMMY_UpdateRects(_THIS, int numrects, SDL_Rect *rects);
 
+static Uint32 DUMMY_GetRefreshPeriod(_THIS);
+
 /* DUMMY driver bootstrap functions */
 static int DUMMY_Available(void) {
 	const char *envr = SDL_getenv("SDL_VIDEODRIVER");
@@ -130,6 +132,7 @@ static SDL_VideoDevice *DUMMY_CreateDevice(int devindex) {
 	device->UnlockHWSurface = DUMMY_UnlockHWSurface;
 	device->FlipHWSurface = NULL;
 	device->FreeHWSurface = DUMMY_FreeHWSurface;
+	device->GetRefreshPeriod = DUMMY_GetRefreshPeriod;
 	device->InitOSKeymap = DUMMY_InitOSKeymap;
 	device->PumpEvents = DUMMY_PumpEvents;
 
@@ -147,11 +150,22 @@ VideoBootStrap DUMMY_bootstrap = {
 
 
 int DUMMY_VideoInit(_THIS, SDL_PixelFormat *vformat) {
+	const char *refresh_env;
+	double refresh_rate;
+
 	/* Determine the screen depth (use default 8-bit depth) */
 	/* we change this during the SDL_SetVideoMode implementation... */
 	vformat->BitsPerPixel = 8;
 	vformat->BytesPerPixel = 1;
 
+	/* There is no display, so pretend to refresh at a fixed rate */
+	refresh_rate = DUMMY_DEFAULT_REFRESHRATE;
+	refresh_env = SDL_getenv("SDL_VIDEO_REFRESHRATE");
+	if(refresh_env && SDL_atof(refresh_env) > 0.0) {
+		refresh_rate = SDL_atof(refresh_env);
+	}
+	this->hidden->refresh_period = (Uint32) (1000000.0 / refresh_rate);
+
 	/* We're done! */
 	return (0);
 }
@@ -216,6 +230,10 @@ static void DUMMY_UpdateRects(_THIS, int numrects, SDL_Rect *rects) {
 	/* do nothing. */
 }
 
+static Uint32 DUMMY_GetRefreshPeriod(_THIS) {
+	return (this->hidden->refresh_period);
+}
+
 int DUMMY_SetColors(_THIS, int firstcolor, int ncolors, SDL_Color *colors) {
 	/* do nothing of note. */
 	return (1);
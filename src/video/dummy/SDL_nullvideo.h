@@ -35,6 +35,9 @@
 
 #include "../SDL_sysvideo.h"
 
+/* Default refresh rate. Can be set with the environment variable SDL_VIDEO_REFRESHRATE */
+#define DUMMY_DEFAULT_REFRESHRATE 60
+
 /* Hidden "this" pointer for the video functions */
 #define _THIS SDL_VideoDevice *this
 
@@ -42,6 +45,7 @@
 struct SDL_PrivateVideoData {
 	int w, h;
 	void *buffer;
+	Uint32 refresh_period;
 };
 
 #endif /* SDL_nullvideo_h_ */
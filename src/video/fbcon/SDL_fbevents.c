@@ -37,10 +37,6 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
-#include <limits.h>
-/* For parsing /proc */
-#include <dirent.h>
-#include <ctype.h>
 #include <linux/vt.h>
 #include <linux/kd.h>
 #include <linux/keyboard.h>
@@ -52,9 +48,15 @@
 #include "SDL_fbvideo.h"
 #include "SDL_fbevents_c.h"
 #include "SDL_fbkeys.h"
+#include "../../core/linux/SDL_evdev.h"
 
-#ifndef GPM_NODE_FIFO
-#define GPM_NODE_FIFO    "/dev/gpmdata"
+#ifdef SDL_USE_EVDEV
+#include <linux/input.h>
+#endif
+
+/* Keeps the console from seeing keys that are read from evdev */
+#ifndef K_OFF
+#define K_OFF    0x04
 #endif
 /* The translation tables from a console scancode to a SDL keysym */
 #define NUM_VGAKEYMAPS    (1<<KG_CAPSSHIFT)
@@ -185,7 +187,7 @@ int FB_EnterGraphicsMode(_THIS) {
 			return (-1);
 		}
 		/* This will fail if we aren't root or this isn't our tty */
-		if(ioctl(keyboard_fd, KDSKBMODE, K_MEDIUMRAW) < 0) {
+		if(ioctl(keyboard_fd, KDSKBMODE, evdev_classes ? K_OFF : K_MEDIUMRAW) < 0) {
 			FB_CloseKeyboard(this);
 			SDL_SetError("Unable to set keyboard in raw mode");
 			return (-1);
@@ -223,8 +225,18 @@ void FB_CloseKeyboard(_THIS) {
 		}
 	}
 	keyboard_fd = -1;
+#ifdef SDL_USE_EVDEV
+	if(evdev_classes) {
+		SDL_EVDEV_Quit();
+	}
+#endif
+	evdev_classes = 0;
 }
 
+#ifdef SDL_USE_EVDEV
+static int FB_EvdevKeyHook(void *userdata, int code, int value);
+#endif
+
 int FB_OpenKeyboard(_THIS) {
 	/* Open only if not already opened */
 	if(keyboard_fd < 0) {
@@ -286,6 +298,37 @@ int FB_OpenKeyboard(_THIS) {
 		}
 		/* Set up keymap */
 		FB_vgainitkeymaps(keyboard_fd);
+#ifdef SDL_USE_EVDEV
+		/* Read keyboards and mice from their event devices when udev can
+		   find them, a mouse protocol asked for by name keeps the old path */
+		if(keyboard_fd >= 0) {
+			int classes = SDL_UDEV_DEVICE_KEYBOARD;
+			if(!SDL_getenv("SDL_MOUSEDRV") && !SDL_getenv("SDL_MOUSEDEV")) {
+				classes |= SDL_UDEV_DEVICE_MOUSE;
+			}
+			if(SDL_EVDEV_Init(classes, FB_EvdevKeyHook, this) < 0) {
+				classes = 0;
+			}
+			/* Keep the PS/2 and GPM mice unless an event device replaces them */
+			if((classes & SDL_UDEV_DEVICE_MOUSE) && SDL_EVDEV_NumDevices(SDL_UDEV_DEVICE_MOUSE) == 0) {
+				SDL_EVDEV_Quit();
+				classes = SDL_UDEV_DEVICE_KEYBOARD;
+				if(SDL_EVDEV_Init(classes, FB_EvdevKeyHook, this) < 0) {
+					classes = 0;
+				}
+			}
+			/* Without a keyboard we could open, the console has to stay
+			   in raw mode or there's no way to type or switch away */
+			if(classes && SDL_EVDEV_NumDevices(SDL_UDEV_DEVICE_KEYBOARD) == 0) {
+				SDL_EVDEV_Quit();
+				classes = 0;
+			}
+			evdev_classes = classes;
+#ifdef DEBUG_KEYBOARD
+			fprintf(stderr, "evdev: %d keyboards, %d mice\n", SDL_EVDEV_NumDevices(SDL_UDEV_DEVICE_KEYBOARD), SDL_EVDEV_NumDevices(SDL_UDEV_DEVICE_MOUSE));
+#endif
+		}
+#endif /* SDL_USE_EVDEV */
 	}
 	return (keyboard_fd);
 }
@@ -314,114 +357,6 @@ void FB_CloseMouse(_THIS) {
 	mouse_fd = -1;
 }
 
-/* Returns processes listed in /proc with the desired name */
-static int find_pid(DIR *proc, const char *wanted_name) {
-	struct dirent *entry;
-	int pid;
-	/* First scan proc for the gpm process */
-	pid = 0;
-	while ((pid == 0) && ((entry = readdir(proc)) != NULL)) {
-		if(isdigit(entry->d_name[0])) {
-			FILE *status;
-			char path[PATH_MAX];
-			char name[PATH_MAX];
-			SDL_snprintf(path, SDL_arraysize(path), "/proc/%s/status", entry->d_name);
-			status = fopen(path, "r");
-			if(status) {
-				int matches = 0;
-				name[0] = '\0';
-				matches = fscanf(status, "Name: %s", name);
-				if((matches == 1) && (SDL_strcmp(name, wanted_name) == 0)) {
-					pid = SDL_atoi(entry->d_name);
-				}
-				fclose(status);
-			}
-		}
-	}
-	return pid;
-}
-
-/* Returns true if /dev/gpmdata is being written to by gpm */
-static int gpm_available(char *proto, size_t protolen) {
-	int available;
-	DIR *proc;
-	int pid;
-	int cmdline, len, arglen;
-	char path[PATH_MAX];
-	char args[PATH_MAX], *arg;
-	/* Don't bother looking if the fifo isn't there */
-#ifdef DEBUG_MOUSE
-	fprintf(stderr,"testing gpm\n");
-#endif
-	if(access(GPM_NODE_FIFO, F_OK) < 0) {
-		return (0);
-	}
-	available = 0;
-	proc = opendir("/proc");
-	if(proc) {
-		char raw_proto[10] = {
-			'\0'
-		};
-		char repeat_proto[10] = {
-			'\0'
-		};
-		while (!available && (pid = find_pid(proc, "gpm")) > 0) {
-			SDL_snprintf(path, SDL_arraysize(path), "/proc/%d/cmdline", pid);
-			cmdline = open(path, O_RDONLY, 0);
-			if(cmdline >= 0) {
-				len = read(cmdline, args, sizeof(args));
-				arg = args;
-				while (len > 0) {
-					arglen = SDL_strlen(arg) + 1;
-#ifdef DEBUG_MOUSE
-					fprintf(stderr,"gpm arg %s len %d\n",arg,arglen);
-#endif
-					if(SDL_strcmp(arg, "-t") == 0) {
-						/* protocol string, keep it for later */
-						char *t, *s;
-						t = arg + arglen;
-						s = SDL_strchr(t, ' ');
-						if(s) {
-							*s = 0;
-						}
-						SDL_strlcpy(raw_proto, t, SDL_arraysize(raw_proto));
-						if(s) {
-							*s = ' ';
-						}
-					}
-					if(SDL_strncmp(arg, "-R", 2) == 0) {
-						char *t, *s;
-						available = 1;
-						t = arg + 2;
-						s = SDL_strchr(t, ' ');
-						if(s) {
-							*s = 0;
-						}
-						SDL_strlcpy(repeat_proto, t, SDL_arraysize(repeat_proto));
-						if(s) {
-							*s = ' ';
-						}
-					}
-					len -= arglen;
-					arg += arglen;
-				}
-				close(cmdline);
-			}
-		}
-		closedir(proc);
-		if(available) {
-			if(SDL_strcmp(repeat_proto, "raw") == 0) {
-				SDL_strlcpy(proto, raw_proto, protolen);
-			} else if(*repeat_proto) {
-				SDL_strlcpy(proto, repeat_proto, protolen);
-			} else {
-				SDL_strlcpy(proto, "msc", protolen);
-			}
-		}
-	}
-	return available;
-}
-
 /* rcg06112001 Set up IMPS/2 mode, if possible. This gives
  *  us access to the mousewheel, etc. Returns zero if
  *  writes to device failed, but you still need to query the
@@ -467,51 +402,26 @@ static int set_imps2_mode(int fd) {
 	return retval;
 }
 
-/* Returns true if the mouse uses the IMPS/2 protocol */
-static int detect_imps2(int fd) {
-	int imps2;
-	imps2 = 0;
-	if(SDL_getenv("SDL_MOUSEDEV_IMPS2")) {
-		imps2 = 1;
-	}
-	if(!imps2) {
-		Uint8 query_ps2 = 0xF2;
-		fd_set fdset;
-		struct timeval tv;
-		/* Get rid of any mouse motion noise */
-		FD_ZERO(&fdset);
-		FD_SET(fd, &fdset);
-		tv.tv_sec = 0;
-		tv.tv_usec = 0;
-		while (select(fd + 1, &fdset, 0, 0, &tv) > 0) {
-			char temp[32];
-			if(read(fd, temp, sizeof(temp)) <= 0) {
-				break;
-			}
-		}
-		/* Query for the type of mouse protocol */
-		if(write(fd, &query_ps2, sizeof(query_ps2)) == sizeof(query_ps2)) {
-			Uint8 ch = 0;
-			/* Get the mouse protocol response */
-			do {
-				FD_ZERO(&fdset);
-				FD_SET(fd, &fdset);
-				tv.tv_sec = 1;
-				tv.tv_usec = 0;
-				if(select(fd + 1, &fdset, 0, 0, &tv) < 1) {
-					break;
-				}
-			} while ((read(fd, &ch, sizeof(ch)) == sizeof(ch)) && ((ch == 0xFA) || (ch == 0xAA)));
-			/* Experimental values (Logitech wheelmouse) */
-#ifdef DEBUG_MOUSE
-			fprintf(stderr, "Last mouse mode: 0x%x\n", ch);
-#endif
-			if((ch == 3) || (ch == 4)) {
-				imps2 = 1;
-			}
+/* The protocol is whatever SDL_MOUSEDRV says, mice aren't probed for it */
+static int FB_MouseProtocol(const char *mousedrv, int fallback) {
+	if(mousedrv == NULL) {
+		if(SDL_getenv("SDL_MOUSEDEV_IMPS2")) {
+			return (MOUSE_IMPS2);
 		}
+		return (fallback);
+	}
+	if(SDL_strcmp(mousedrv, "PS2") == 0) {
+		return (MOUSE_PS2);
+	} else if(SDL_strcmp(mousedrv, "IMPS2") == 0) {
+		return (MOUSE_IMPS2);
+	} else if(SDL_strcmp(mousedrv, "MS") == 0) {
+		return (MOUSE_MS);
+	} else if(SDL_strcmp(mousedrv, "MSC") == 0) {
+		return (MOUSE_MSC);
+	} else if(SDL_strcmp(mousedrv, "BM") == 0) {
+		return (MOUSE_BM);
 	}
-	return imps2;
+	return (fallback);
 }
 
 int FB_OpenMouse(_THIS) {
@@ -539,67 +449,36 @@ int FB_OpenMouse(_THIS) {
 		return mouse_fd;
 	}
 #endif /* SDL_INPUT_TSLIB */
+#ifdef SDL_USE_EVDEV
+	/* Mice come and go through SDL_EVDEV along with the keyboards */
+	if(evdev_classes & SDL_UDEV_DEVICE_MOUSE) {
+		mouse_drv = MOUSE_NONE;
+		return (0);
+	}
+#endif
 	/* STD MICE */
 	if(mousedev == NULL) {
-		/* FIXME someday... allow multiple mice in this driver */
 		static const char *ps2mice[] = {
 			"/dev/input/mice",
 			"/dev/usbmouse",
 			"/dev/psaux",
 			NULL
 		};
-		/* First try to use GPM in repeater mode */
-		if(mouse_fd < 0) {
-			char proto[10];
-			if(gpm_available(proto, SDL_arraysize(proto))) {
-				mouse_fd = open(GPM_NODE_FIFO, O_RDONLY, 0);
-				if(mouse_fd >= 0) {
-					if(SDL_strcmp(proto, "msc") == 0) {
-						mouse_drv = MOUSE_MSC;
-					} else if(SDL_strcmp(proto, "ps2") == 0) {
-						mouse_drv = MOUSE_PS2;
-					} else if(SDL_strcmp(proto, "imps2") == 0) {
-						mouse_drv = MOUSE_IMPS2;
-					} else if(SDL_strcmp(proto, "ms") == 0 || SDL_strcmp(proto, "bare") == 0) {
-						mouse_drv = MOUSE_MS;
-					} else if(SDL_strcmp(proto, "bm") == 0) {
-						mouse_drv = MOUSE_BM;
-					} else {
-						/* Unknown protocol... */
-#ifdef DEBUG_MOUSE
-						fprintf(stderr, "GPM mouse using unknown protocol = %s\n", proto);
-#endif
-						close(mouse_fd);
-						mouse_fd = -1;
-					}
-				}
-#ifdef DEBUG_MOUSE
-				if ( mouse_fd >= 0 ) {
-					fprintf(stderr, "Using GPM mouse, protocol = %s\n", proto);
-				}
-#endif /* DEBUG_MOUSE */
-			}
-		}
-		/* Now try to use a modern PS/2 mouse */
+		/* Try a modern PS/2 mouse */
 		for (i = 0; (mouse_fd < 0) && ps2mice[i]; ++i) {
 			mouse_fd = open(ps2mice[i], O_RDWR, 0);
 			if(mouse_fd < 0) {
 				mouse_fd = open(ps2mice[i], O_RDONLY, 0);
 			}
 			if(mouse_fd >= 0) {
-				/* rcg06112001 Attempt to set IMPS/2 mode */
-				set_imps2_mode(mouse_fd);
-				if(detect_imps2(mouse_fd)) {
-#ifdef DEBUG_MOUSE
-					fprintf(stderr, "Using IMPS2 mouse\n");
-#endif
-					mouse_drv = MOUSE_IMPS2;
-				} else {
+				mouse_drv = FB_MouseProtocol(mousedrv, MOUSE_PS2);
+				/* rcg06112001 The wheel needs the mouse in IMPS/2 mode */
+				if(mouse_drv == MOUSE_IMPS2) {
+					set_imps2_mode(mouse_fd);
+				}
 #ifdef DEBUG_MOUSE
-					fprintf(stderr, "Using PS2 mouse\n");
+				fprintf(stderr, "Using %s mouse\n", (mouse_drv == MOUSE_IMPS2) ? "IMPS2" : "PS2");
 #endif
-					mouse_drv = MOUSE_PS2;
-				}
 			}
 		}
 		/* Next try to use a PPC ADB port mouse */
@@ -633,17 +512,10 @@ int FB_OpenMouse(_THIS) {
 			mouse_termios.c_cflag |= CS8;
 			mouse_termios.c_cflag |= B1200;
 			tcsetattr(mouse_fd, TCSAFLUSH, &mouse_termios);
-			if(mousedrv && (SDL_strcmp(mousedrv, "PS2") == 0)) {
-#ifdef DEBUG_MOUSE
-				fprintf(stderr, "Using (user specified) PS2 mouse on %s\n", mousedev);
-#endif
-				mouse_drv = MOUSE_PS2;
-			} else {
+			mouse_drv = FB_MouseProtocol(mousedrv, MOUSE_MS);
 #ifdef DEBUG_MOUSE
-				fprintf(stderr, "Using (default) MS mouse on %s\n", mousedev);
+			fprintf(stderr, "Using mouse protocol %d on %s\n", mouse_drv, mousedev);
 #endif
-				mouse_drv = MOUSE_MS;
-			}
 		}
 	}
 	if(mouse_fd < 0) {
@@ -699,6 +571,16 @@ static void handle_tslib(_THIS) {
 /* For now, use MSC, PS/2, and MS protocols
    Driver adapted from the SVGAlib mouse driver code (taken from gpm, etc.)
  */
+/* Motion of consecutive packets with the same button state is summed up
+   and reported as a single event */
+#define FLUSH_MOUSE_MOTION() \
+	do { \
+		if(last_button >= 0) { \
+			FB_vgamousecallback(last_button, relative, sum_dx, sum_dy); \
+			sum_dx = sum_dy = 0; \
+		} \
+	} while(0)
+
 static void handle_mouse(_THIS) {
 	static int start = 0;
 	static unsigned char mousebuf[BUFSIZ];
@@ -707,6 +589,8 @@ static void handle_mouse(_THIS) {
 	int button = 0;
 	int dx = 0, dy = 0;
 	int packetsize = 0;
+	int last_button = -1;
+	int sum_dx = 0, sum_dy = 0;
 	/* Figure out the mouse packet size */
 	switch (mouse_drv) {
 		case MOUSE_NONE:
@@ -788,10 +672,14 @@ static void handle_mouse(_THIS) {
 					case 0x02: /* DX = -1 */
 						break;
 					case 0x0F: /* DY = +1 (map button 4) */
+						FLUSH_MOUSE_MOTION();
 						FB_vgamousecallback(button | (1 << 3), 1, 0, 0);
+						last_button = button | (1 << 3);
 						break;
 					case 0x01: /* DY = -1 (map button 5) */
+						FLUSH_MOUSE_MOTION();
 						FB_vgamousecallback(button | (1 << 4), 1, 0, 0);
+						last_button = button | (1 << 4);
 						break;
 				}
 				break;
@@ -825,7 +713,16 @@ static void handle_mouse(_THIS) {
 				dy = 0;
 				break;
 		}
-		FB_vgamousecallback(button, relative, dx, dy);
+		/* Report the motion so far whenever the buttons change */
+		if(button != last_button) {
+			FLUSH_MOUSE_MOTION();
+			last_button = button;
+		}
+		sum_dx += dx;
+		sum_dy += dy;
+	}
+	if(last_button >= 0) {
+		FB_vgamousecallback(last_button, relative, sum_dx, sum_dy);
 	}
 	if(i < nread) {
 		SDL_memcpy(mousebuf, &mousebuf[i], (nread - i));
@@ -865,6 +762,15 @@ static void switch_vt_done(_THIS) {
 		SDL_free(screen_contents);
 		screen_contents = NULL;
 	}
+}
+
+/* Called once our VC is back and hw_lock has been released, since
+   updating the screen locks the hardware surface again */
+static void switch_vt_resume(_THIS) {
+	/* Keys went up and down on the other VT without us seeing them */
+	SDL_ResetKeyboard();
+	SDL_SetModState(KMOD_NONE);
+
 	/* Get updates to the shadow surface while switched away */
 	if(SDL_ShadowSurface) {
 		SDL_UpdateRect(SDL_ShadowSurface, 0, 0, 0, 0);
@@ -888,7 +794,35 @@ static void switch_vt(_THIS, unsigned short which) {
 		switch_vt_done(this);
 	}
 	SDL_mutexV(hw_lock);
+	if(!switched_away) {
+		switch_vt_resume(this);
+	}
+}
+
+#ifdef SDL_USE_EVDEV
+/* Ctrl-Alt-Fn switches the virtual terminal, like it does on the console */
+static int FB_EvdevKeyHook(void *userdata, int code, int value) {
+	SDL_VideoDevice *this = (SDL_VideoDevice *) userdata;
+	int which;
+
+	if(code >= KEY_F1 && code <= KEY_F10) {
+		which = (code - KEY_F1) + 1;
+	} else if(code == KEY_F11) {
+		which = 11;
+	} else if(code == KEY_F12) {
+		which = 12;
+	} else {
+		return (0);
+	}
+	if(!(SDL_GetModState() & KMOD_CTRL) || !(SDL_GetModState() & KMOD_ALT)) {
+		return (0);
+	}
+	if(value) {
+		switch_vt(this, which);
+	}
+	return (1);
 }
+#endif /* SDL_USE_EVDEV */
 
 static void handle_keyboard(_THIS) {
 	unsigned char keybuf[BUFSIZ];
@@ -946,11 +880,14 @@ void FB_PumpEvents(_THIS) {
 				switch_vt_done(this);
 			}
 			SDL_mutexV(hw_lock);
+			if(!switched_away) {
+				switch_vt_resume(this);
+			}
 		}
 		posted = 0;
 		FD_ZERO(&fdset);
 		max_fd = 0;
-		if(keyboard_fd >= 0) {
+		if((keyboard_fd >= 0) && !evdev_classes) {
 			FD_SET(keyboard_fd, &fdset);
 			if(max_fd < keyboard_fd) {
 				max_fd = keyboard_fd;
@@ -963,7 +900,7 @@ void FB_PumpEvents(_THIS) {
 			}
 		}
 		if(select(max_fd + 1, &fdset, NULL, NULL, &zero) > 0) {
-			if(keyboard_fd >= 0) {
+			if((keyboard_fd >= 0) && !evdev_classes) {
 				if(FD_ISSET(keyboard_fd, &fdset)) {
 					handle_keyboard(this);
 				}
@@ -975,6 +912,26 @@ void FB_PumpEvents(_THIS) {
 			}
 		}
 	} while (posted);
+#ifdef SDL_USE_EVDEV
+	/* The event devices see every key, whichever VT is in front, and
+	   what's typed on another console is none of our business */
+	if(evdev_classes && switched_away) {
+		SDL_EVDEV_Flush();
+	} else if(evdev_classes) {
+		SDL_EVDEV_Poll();
+	}
+#endif
+}
+
+/* Only keys read from evdev can be remapped */
+int FB_RemapKeys(_THIS, const SDL_KeyRemap *table, int count) {
+#ifdef SDL_USE_EVDEV
+	if(evdev_classes) {
+		return (SDL_EVDEV_SetKeymap(table, count));
+	}
+#endif
+	SDL_Unsupported();
+	return (-1);
 }
 
 void FB_InitOSKeymap(_THIS) {
@@ -52,3 +52,5 @@ extern void FB_LeaveGraphicsMode(_THIS);
 extern void FB_InitOSKeymap(_THIS);
 
 extern void FB_PumpEvents(_THIS);
+
+extern int FB_RemapKeys(_THIS, const SDL_KeyRemap *table, int count);
@@ -50,6 +50,7 @@
 #include "../SDL_sysvideo.h"
 #include "../SDL_pixels_c.h"
 #include "../../events/SDL_events_c.h"
+#include "../../stdlib/SDL_pool_c.h"
 #include "SDL_fbvideo.h"
 #include "SDL_fbmouse_c.h"
 #include "SDL_fbevents_c.h"
@@ -156,6 +157,8 @@ static void FB_WaitIdle(_THIS);
 
 static int FB_FlipHWSurface(_THIS, SDL_Surface *surface);
 
+static Uint32 FB_GetRefreshPeriod(_THIS);
+
 #if !SDL_THREADS_DISABLED
 
 static int FB_TripleBufferingThread(void *d);
@@ -280,6 +283,7 @@ static SDL_VideoDevice *FB_CreateDevice(int devindex) {
 	this->UnlockHWSurface = FB_UnlockHWSurface;
 	this->FlipHWSurface = FB_FlipHWSurface;
 	this->FreeHWSurface = FB_FreeHWSurface;
+	this->GetRefreshPeriod = FB_GetRefreshPeriod;
 #ifdef HAVE_OSMESA
 	this->GL_LoadLibrary = SDL_OSMesa_LoadLibrary;
 	this->GL_GetProcAddress = SDL_OSMesa_GetProcAddress;
@@ -294,6 +298,7 @@ static SDL_VideoDevice *FB_CreateDevice(int devindex) {
 	this->GetWMInfo = NULL;
 	this->InitOSKeymap = FB_InitOSKeymap;
 	this->PumpEvents = FB_PumpEvents;
+	this->RemapKeys = FB_RemapKeys;
 
 	this->free = FB_DeleteDevice;
 
@@ -540,7 +545,8 @@ static int FB_VideoInit(_THIS, SDL_PixelFormat *vformat) {
 	}
 
 #if !SDL_THREADS_DISABLED
-	/* Create the hardware surface lock mutex */
+	/* Create the hardware surface lock mutex, it has to be recursive as
+	   a VT switch takes it while the application holds the screen lock */
 	hw_lock = SDL_CreateMutex();
 	if(hw_lock == NULL) {
 		SDL_SetError("Unable to create lock mutex");
@@ -1111,7 +1117,7 @@ static SDL_Surface *FB_SetVideoMode(_THIS, SDL_Surface *current, int width, int
 		current->flags |= SDL_TRIPLEBUF;
 		current_page = 0;
 		new_page = 2;
-		triplebuf_thread_stop = 0;
+		SDL_AtomicSet(&triplebuf_thread_stop, 0);
 
 		SDL_LockMutex(triplebuf_mutex);
 		triplebuf_thread = SDL_CreateThread(FB_TripleBufferingThread, this);
@@ -1187,6 +1193,9 @@ void FB_DumpHWSurfaces(_THIS) {
 }
 #endif
 
+/* Buckets are split and merged as hardware surfaces come and go */
+static SDL_Pool FB_bucket_pool = SDL_POOL_INITIALIZER(vidmem_bucket, 16);
+
 static int FB_InitHWSurfaces(_THIS, SDL_Surface *screen, char *base, int size) {
 	vidmem_bucket *bucket;
 
@@ -1194,7 +1203,7 @@ static int FB_InitHWSurfaces(_THIS, SDL_Surface *screen, char *base, int size) {
 	surfaces_memleft = size;
 
 	if(surfaces_memleft > 0) {
-		bucket = (vidmem_bucket *) SDL_malloc(sizeof(*bucket));
+		bucket = (vidmem_bucket *) SDL_PoolAlloc(&FB_bucket_pool);
 		if(bucket == NULL) {
 			SDL_OutOfMemory();
 			return (-1);
@@ -1226,7 +1235,7 @@ static void FB_FreeHWSurfaces(_THIS) {
 	while (bucket) {
 		freeable = bucket;
 		bucket = bucket->next;
-		SDL_free(freeable);
+		SDL_PoolFree(&FB_bucket_pool, freeable);
 	}
 	surfaces.next = NULL;
 }
@@ -1276,7 +1285,7 @@ static int FB_AllocHWSurface(_THIS, SDL_Surface *surface) {
 #ifdef DEBUG_FBCON
 		fprintf(stderr, "Adding new free bucket of %d bytes\n", extra);
 #endif
-		newbucket = (vidmem_bucket *) SDL_malloc(sizeof(*newbucket));
+		newbucket = (vidmem_bucket *) SDL_PoolAlloc(&FB_bucket_pool);
 		if(newbucket == NULL) {
 			SDL_OutOfMemory();
 			return (-1);
@@ -1328,7 +1337,7 @@ static void FB_FreeHWSurface(_THIS, SDL_Surface *surface) {
 			if(bucket->next) {
 				bucket->next->prev = bucket;
 			}
-			SDL_free(freeable);
+			SDL_PoolFree(&FB_bucket_pool, freeable);
 		}
 		if(bucket->prev && !bucket->prev->used) {
 			freeable = bucket;
@@ -1337,7 +1346,7 @@ static void FB_FreeHWSurface(_THIS, SDL_Surface *surface) {
 			if(bucket->next) {
 				bucket->next->prev = bucket->prev;
 			}
-			SDL_free(freeable);
+			SDL_PoolFree(&FB_bucket_pool, freeable);
 		}
 	}
 	surface->pixels = NULL;
@@ -1386,7 +1395,7 @@ static int FB_TripleBufferingThread(void *d) {
 		unsigned int page;
 
 		SDL_CondWait(triplebuf_cond, triplebuf_mutex);
-		if(triplebuf_thread_stop) {
+		if(SDL_AtomicGet(&triplebuf_thread_stop)) {
 			break;
 		}
 
@@ -1416,7 +1425,7 @@ static void FB_TripleBufferInit(_THIS) {
 
 static void FB_TripleBufferStop(_THIS) {
 	SDL_LockMutex(triplebuf_mutex);
-	triplebuf_thread_stop = 1;
+	SDL_AtomicSet(&triplebuf_thread_stop, 1);
 	SDL_CondSignal(triplebuf_cond);
 	SDL_UnlockMutex(triplebuf_mutex);
 
@@ -1475,6 +1484,32 @@ static int FB_FlipHWSurface(_THIS, SDL_Surface *surface) {
 	return (0);
 }
 
+/* Derive the frame duration from the timings of the active mode */
+static Uint32 FB_GetRefreshPeriod(_THIS) {
+	Uint64 htotal, vtotal;
+
+	/* Lots of embedded drivers don't fill in the timings at all */
+	if(cache_vinfo.pixclock == 0) {
+		return (0);
+	}
+
+	htotal = cache_vinfo.left_margin + cache_vinfo.xres + cache_vinfo.right_margin + cache_vinfo.hsync_len;
+	vtotal = cache_vinfo.upper_margin + cache_vinfo.yres + cache_vinfo.lower_margin + cache_vinfo.vsync_len;
+	switch (cache_vinfo.vmode & FB_VMODE_MASK) {
+		case FB_VMODE_INTERLACED :
+			vtotal /= 2;
+			break;
+		case FB_VMODE_DOUBLE :
+			vtotal *= 2;
+			break;
+		default:
+			break;
+	}
+
+	/* pixclock is the duration of a single pixel in picoseconds */
+	return ((Uint32) ((cache_vinfo.pixclock * htotal * vtotal) / 1000000));
+}
+
 static void FB_blit16(Uint8 *byte_src_pos, int src_right_delta, int src_down_delta, Uint8 *byte_dst_pos, int dst_linebytes, int width, int height) {
 	int w;
 	Uint16 *src_pos = (Uint16 *) byte_src_pos;
@@ -1781,6 +1816,7 @@ static void FB_VideoQuit(_THIS) {
 
 	/* Clean up the memory bucket list */
 	FB_FreeHWSurfaces(this);
+	SDL_PoolTrim(&FB_bucket_pool);
 
 	/* Close console and input file descriptors */
 	if(console_fd > 0) {
@@ -38,6 +38,7 @@
 #include <termios.h>
 #include <linux/fb.h>
 
+#include "SDL_atomic.h"
 #include "SDL_mouse.h"
 #include "SDL_mutex.h"
 #include "SDL_thread.h"
@@ -79,6 +80,7 @@ struct SDL_PrivateVideoData {
 	struct termios saved_kbd_termios;
 
 	int mouse_fd;
+	int evdev_classes;      /* Input read through SDL_EVDEV instead of the VT */
 #if SDL_INPUT_TSLIB
 	struct tsdev *ts_dev;
 #endif
@@ -96,7 +98,7 @@ struct SDL_PrivateVideoData {
 	SDL_mutex *triplebuf_mutex;
 	SDL_cond *triplebuf_cond;
 	SDL_Thread *triplebuf_thread;
-	int triplebuf_thread_stop;
+	SDL_atomic_t triplebuf_thread_stop;
 #endif
 	int rotate;
 	int shadow_fb;          /* Tells whether a shadow is being used. */
@@ -130,6 +132,7 @@ struct SDL_PrivateVideoData {
 #define saved_kbd_mode        (this->hidden->saved_kbd_mode)
 #define saved_kbd_termios     (this->hidden->saved_kbd_termios)
 #define mouse_fd              (this->hidden->mouse_fd)
+#define evdev_classes         (this->hidden->evdev_classes)
 #if SDL_INPUT_TSLIB
 #define ts_dev				  (this->hidden->ts_dev)
 #endif
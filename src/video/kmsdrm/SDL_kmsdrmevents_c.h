@@ -44,6 +44,8 @@ extern void KMSDRM_InitOSKeymap(_THIS);
 
 extern void KMSDRM_PumpEvents(_THIS);
 
+extern int KMSDRM_RemapKeys(_THIS, const SDL_KeyRemap *table, int count);
+
 extern void KMSDRM_InitInput(_THIS);
 
 extern void KMSDRM_ExitInput(_THIS);
@@ -46,6 +46,27 @@ static float mode_vrefresh(drmModeModeInfo *mode) {
 	return mode->clock * 1000.00 / (mode->htotal * mode->vtotal);
 }
 
+/* Duration of one refresh of the given mode, in microseconds. */
+Uint32 mode_period(drmModeModeInfo *mode) {
+	Uint64 vtotal = mode->vtotal;
+
+	if(mode->clock == 0) {
+		return 0;
+	}
+	if(mode->flags & DRM_MODE_FLAG_INTERLACE) {
+		vtotal /= 2;
+	}
+	if(mode->flags & DRM_MODE_FLAG_DBLSCAN) {
+		vtotal *= 2;
+	}
+	if(mode->vscan > 1) {
+		vtotal *= mode->vscan;
+	}
+
+	/* clock is the pixel clock in kHz */
+	return (Uint32) ((mode->htotal * vtotal * 1000) / mode->clock);
+}
+
 void dump_mode(drmModeModeInfo *mode) {
 	kmsdrm_dbg_printf("%s %.2f %d %d %d %d %d %d %d %d %d\n", mode->name, mode_vrefresh(mode), mode->hdisplay, mode->hsync_start, mode->hsync_end, mode->htotal, mode->vdisplay, mode->vsync_start, mode->vsync_end, mode->vtotal, mode->clock);
 }
@@ -40,6 +40,8 @@
 
 void dump_mode(drmModeModeInfo *mode);
 
+Uint32 mode_period(drmModeModeInfo *mode);
+
 int save_drm_pipe(_THIS, Uint32 plane, Uint32 crtc, Uint32 enc, drmModeConnector *conn);
 
 Uint32 get_prop_id(_THIS, Uint32 obj_id, const char *prop_name);
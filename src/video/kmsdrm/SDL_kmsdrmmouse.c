@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * KMS/DRM Video Backend for SDL 1.2.x
+ * Copyright (C) 2020 Paul Cercueil <paul@crapouillou.net>
+ * Copyright (C) 2020 João H. Spies <johnnyonflame@hotmail.com>
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+
+#include "SDL_config.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "SDL.h"
+#include "SDL_kmsdrmvideo.h"
+#include "SDL_kmsdrmmouse_c.h"
+
+/* A cursor image in a dumb buffer, shown on the CRTC's cursor plane */
+struct WMcursor {
+	struct drm_mode_create_dumb req_create;
+	int hot_x, hot_y;
+};
+
+static int KMSDRM_CursorSize(_THIS)
+{
+	uint64_t value;
+
+	if (this->hidden->cursor_w)
+		return 1;
+
+	/* Most drivers only take cursors of exactly this size, 64x64 if not told */
+	this->hidden->cursor_w = 64;
+	this->hidden->cursor_h = 64;
+	if (drmGetCap(drm_fd, DRM_CAP_CURSOR_WIDTH, &value) == 0 && value)
+		this->hidden->cursor_w = value;
+	if (drmGetCap(drm_fd, DRM_CAP_CURSOR_HEIGHT, &value) == 0 && value)
+		this->hidden->cursor_h = value;
+	return 1;
+}
+
+/* Returning NULL leaves the cursor to SDL_DrawCursor() */
+WMcursor *KMSDRM_CreateWMCursor(_THIS, Uint8 *data, Uint8 *mask, int w, int h, int hot_x, int hot_y)
+{
+	struct drm_mode_map_dumb req_map;
+	struct drm_mode_destroy_dumb req_destroy;
+	const char *env;
+	WMcursor *cursor;
+	Uint32 *row;
+	Uint8 *map;
+	int x, y, bit;
+
+	env = SDL_getenv("SDL_VIDEO_KMSDRM_HWCURSOR");
+	if (env && !SDL_atoi(env))
+		return NULL;
+
+	KMSDRM_CursorSize(this);
+	if (w > this->hidden->cursor_w || h > this->hidden->cursor_h)
+		return NULL;
+
+	cursor = (WMcursor *) SDL_calloc(1, sizeof(*cursor));
+	if (!cursor) {
+		SDL_OutOfMemory();
+		return NULL;
+	}
+	cursor->hot_x = hot_x;
+	cursor->hot_y = hot_y;
+
+	cursor->req_create.width = this->hidden->cursor_w;
+	cursor->req_create.height = this->hidden->cursor_h;
+	cursor->req_create.bpp = 32;
+	if (drmIoctl(drm_fd, DRM_IOCTL_MODE_CREATE_DUMB, &cursor->req_create) < 0) {
+		kmsdrm_dbg_printf("Cursor buffer request failed, %s.\n", strerror(errno));
+		SDL_free(cursor);
+		return NULL;
+	}
+
+	SDL_memset(&req_map, 0, sizeof(req_map));
+	req_map.handle = cursor->req_create.handle;
+	if (drmIoctl(drm_fd, DRM_IOCTL_MODE_MAP_DUMB, &req_map) < 0)
+		goto fail;
+
+	map = mmap(0, cursor->req_create.size, PROT_READ | PROT_WRITE, MAP_SHARED, drm_fd, req_map.offset);
+	if (map == MAP_FAILED)
+		goto fail;
+
+	/*
+	 * ARGB8888 from SDL's 1bpp pair: mask and data make black, mask alone
+	 * white, neither transparent. Data alone would invert the screen, which
+	 * the plane can't do, so it comes out black.
+	 */
+	SDL_memset(map, 0, cursor->req_create.size);
+	for (y = 0; y < h; ++y) {
+		row = (Uint32 *) (map + y * cursor->req_create.pitch);
+		for (x = 0; x < w; ++x) {
+			bit = 0x80 >> (x & 7);
+			if (data[x / 8] & bit)
+				row[x] = 0xFF000000;
+			else if (mask[x / 8] & bit)
+				row[x] = 0xFFFFFFFF;
+		}
+		data += (w + 7) / 8;
+		mask += (w + 7) / 8;
+	}
+	munmap(map, cursor->req_create.size);
+
+	return cursor;
+
+fail:
+	kmsdrm_dbg_printf("Cursor buffer mapping failed, %s.\n", strerror(errno));
+	req_destroy.handle = cursor->req_create.handle;
+	drmIoctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &req_destroy);
+	SDL_free(cursor);
+	return NULL;
+}
+
+void KMSDRM_FreeWMCursor(_THIS, WMcursor *cursor)
+{
+	struct drm_mode_destroy_dumb req_destroy;
+
+	if (cursor == this->hidden->cursor) {
+		if (drm_active_pipe)
+			drmModeSetCursor(drm_fd, drm_active_pipe->crtc, 0, 0, 0);
+		this->hidden->cursor = NULL;
+	}
+
+	req_destroy.handle = cursor->req_create.handle;
+	drmIoctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &req_destroy);
+	SDL_free(cursor);
+}
+
+int KMSDRM_ShowWMCursor(_THIS, WMcursor *cursor)
+{
+	int x, y;
+
+	/* No CRTC before the first mode set, draw in software until then */
+	if (!drm_active_pipe)
+		return 0;
+
+	if (!cursor) {
+		if (this->hidden->cursor)
+			drmModeSetCursor(drm_fd, drm_active_pipe->crtc, 0, 0, 0);
+		this->hidden->cursor = NULL;
+		return 1;
+	}
+
+	/* Only virtual GPUs use the hotspot, older kernels lack SetCursor2 */
+	if (drmModeSetCursor2(drm_fd, drm_active_pipe->crtc, cursor->req_create.handle,
+			cursor->req_create.width, cursor->req_create.height,
+			cursor->hot_x, cursor->hot_y) &&
+		drmModeSetCursor(drm_fd, drm_active_pipe->crtc, cursor->req_create.handle,
+			cursor->req_create.width, cursor->req_create.height)) {
+		kmsdrm_dbg_printf("No hardware cursor, %s.\n", strerror(errno));
+		this->hidden->cursor = NULL;
+		return 0;
+	}
+	this->hidden->cursor = cursor;
+
+	SDL_GetMouseState(&x, &y);
+	KMSDRM_MoveWMCursor(this, x, y);
+	return 1;
+}
+
+/* Called for every motion event, this is all a moving pointer costs now */
+void KMSDRM_MoveWMCursor(_THIS, int x, int y)
+{
+	WMcursor *cursor = this->hidden->cursor;
+	SDL_Rect *dst = &this->hidden->plane_rect;
+
+	if (!cursor || !drm_active_pipe || !this->hidden->w || !this->hidden->h)
+		return;
+
+	/* From surface to CRTC coordinates, the image itself isn't scaled */
+	x = dst->x + x * dst->w / this->hidden->w - cursor->hot_x;
+	y = dst->y + y * dst->h / this->hidden->h - cursor->hot_y;
+	drmModeMoveCursor(drm_fd, drm_active_pipe->crtc, x, y);
+}
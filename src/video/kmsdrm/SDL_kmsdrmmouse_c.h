@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*******************************************************************************
+ * Library       : SDLite 1.2.x
+ * Purpose       : Low-level access to a framebuffer, audio output and HID.
+ * Module        : Core
+ * Project       : Redux for Embedded System
+ * Description   : Stripped-down and optimized libraries for RISC processors
+ * License       : GNU General Public License v3.0
+ *******************************************************************************
+ *
+ * KMS/DRM Video Backend for SDL 1.2.x
+ * Copyright (C) 2020 Paul Cercueil <paul@crapouillou.net>
+ * Copyright (C) 2020 João H. Spies <johnnyonflame@hotmail.com>
+ *
+ * Rætro and SDLite 1.2.x:
+ * Copyright (c) 2019-2020 Marcus Andrade <marcus@raetro.org>
+ *
+ * Simple DirectMedia Layer and SDL:
+ * Copyright (c) 1997-2012 Sam Lantinga <slouken@libsdl.org>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ * If not, see <https://www.gnu.org/licenses/gpl-3.0.html>.
+ *
+ ******************************************************************************/
+
+#include "SDL_config.h"
+
+#include "SDL_kmsdrmvideo.h"
+
+/* Functions to be exported */
+extern WMcursor *KMSDRM_CreateWMCursor(_THIS, Uint8 *data, Uint8 *mask, int w, int h, int hot_x, int hot_y);
+
+extern void KMSDRM_FreeWMCursor(_THIS, WMcursor *cursor);
+
+extern int KMSDRM_ShowWMCursor(_THIS, WMcursor *cursor);
+
+extern void KMSDRM_MoveWMCursor(_THIS, int x, int y);
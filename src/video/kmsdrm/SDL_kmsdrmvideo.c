@@ -54,6 +54,7 @@
 #include "SDL_kmsdrmvideo.h"
 #include "SDL_kmsdrmevents_c.h"
 #include "SDL_kmsdrmmisc_c.h"
+#include "SDL_kmsdrmmouse_c.h"
 #include "SDL_kmsdrmcolordef.h"
 
 #define KMSDRM_DRIVER_NAME "kmsdrm"
@@ -368,6 +369,12 @@ static int KMSDRM_SetCrtcParams(_THIS, drmModeAtomicReqPtr req, Uint32 plane_id,
 			return 1;
 	}
 
+	/* The hardware cursor follows the same mapping */
+	this->hidden->plane_rect.x = (mode_width - crtc_w) / 2;
+	this->hidden->plane_rect.y = (mode_height - crtc_h) / 2;
+	this->hidden->plane_rect.w = crtc_w;
+	this->hidden->plane_rect.h = crtc_h;
+
 	if(!add_property(this, req, plane_id, "CRTC_X", 0, (mode_width - crtc_w) / 2)) {
 		return 1;
 	}
@@ -506,6 +513,7 @@ SDL_Surface *KMSDRM_SetVideoMode(_THIS, SDL_Surface *current, int width, int hei
 			this->hidden->crtc_w = closest_mode->hdisplay;
 			this->hidden->crtc_h = closest_mode->vdisplay;
 			this->hidden->bpp = bpp;
+			this->hidden->refresh_period = mode_period(closest_mode);
 			break;
 		} else {
 			kmsdrm_dbg_printf("SetVideoMode failed: %s, retrying.\n", strerror(errno));
@@ -550,7 +558,7 @@ SDL_Surface *KMSDRM_SetVideoMode(_THIS, SDL_Surface *current, int width, int hei
 
 	if((flags & SDL_TRIPLEBUF) == SDL_TRIPLEBUF) {
 		SDL_LockMutex(drm_triplebuf_mutex);
-		drm_triplebuf_thread_stop = 0;
+		SDL_AtomicSet(&drm_triplebuf_thread_stop, 0);
 		drm_triplebuf_thread = SDL_CreateThread(KMSDRM_TripleBufferingThread, this);
 
 		/* Wait until the triplebuf thread is ready */
@@ -594,6 +602,13 @@ static void KMSDRM_UnlockHWSurface(_THIS, SDL_Surface *surface) {
 	return;
 }
 
+static Uint32 KMSDRM_GetRefreshPeriod(_THIS) {
+	if(!drm_active_pipe) {
+		return (0);
+	}
+	return (this->hidden->refresh_period);
+}
+
 static int KMSDRM_TripleBufferingThread(void *d) {
 	SDL_VideoDevice *this = d;
 
@@ -604,7 +619,7 @@ static int KMSDRM_TripleBufferingThread(void *d) {
 		int page;
 
 		SDL_CondWait(drm_triplebuf_cond, drm_triplebuf_mutex);
-		if(drm_triplebuf_thread_stop) {
+		if(SDL_AtomicGet(&drm_triplebuf_thread_stop)) {
 			break;
 		}
 
@@ -644,7 +659,7 @@ static void KMSDRM_TripleBufferInit(_THIS) {
 
 static void KMSDRM_TripleBufferStop(_THIS) {
 	SDL_LockMutex(drm_triplebuf_mutex);
-	drm_triplebuf_thread_stop = 1;
+	SDL_AtomicSet(&drm_triplebuf_thread_stop, 1);
 	SDL_CondSignal(drm_triplebuf_cond);
 	SDL_UnlockMutex(drm_triplebuf_mutex);
 
@@ -844,13 +859,19 @@ static SDL_VideoDevice *KMSDRM_CreateDevice(int devindex) {
 	device->UnlockHWSurface = KMSDRM_UnlockHWSurface;
 	device->FlipHWSurface = KMSDRM_FlipHWSurface;
 	device->FreeHWSurface = KMSDRM_FreeHWSurface; // TODO: Obvious
+	device->GetRefreshPeriod = KMSDRM_GetRefreshPeriod;
 	device->SetCaption = NULL;
 	device->SetIcon = NULL;
 	device->IconifyWindow = NULL;
 	device->GrabInput = NULL;
 	device->GetWMInfo = NULL;
+	device->FreeWMCursor = KMSDRM_FreeWMCursor;
+	device->CreateWMCursor = KMSDRM_CreateWMCursor;
+	device->ShowWMCursor = KMSDRM_ShowWMCursor;
+	device->MoveWMCursor = KMSDRM_MoveWMCursor;
 	device->InitOSKeymap = KMSDRM_InitOSKeymap;
 	device->PumpEvents = KMSDRM_PumpEvents;
+	device->RemapKeys = KMSDRM_RemapKeys;
 
 	device->free = KMSDRM_DeleteDevice;
 
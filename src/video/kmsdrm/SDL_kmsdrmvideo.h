@@ -55,7 +55,10 @@
 #define kmsdrm_dbg_printf(fmt, ...)
 #endif
 
+#include "SDL_atomic.h"
 #include "../SDL_sysvideo.h"
+#include "../../events/SDL_events_c.h"
+#include "../../core/linux/SDL_evdev.h"
 
 /* Default refresh rate. Can be set with the environment variable SDL_VIDEO_REFRESHRATE */
 #define KMSDRM_DEFAULT_REFRESHRATE 60
@@ -103,12 +106,6 @@ typedef struct drm_buffer {
 	void *map;
 } drm_buffer;
 
-typedef struct drm_input_dev {
-	char *path;
-	int fd;
-	struct drm_input_dev *next;
-} drm_input_dev;
-
 typedef enum {
 	DRM_SCALING_MODE_FULLSCREEN,
 	DRM_SCALING_MODE_ASPECT_RATIO,
@@ -140,14 +137,19 @@ struct SDL_PrivateVideoData {
 	SDL_mutex *triplebuf_mutex;
 	SDL_cond *triplebuf_cond;
 	SDL_Thread *triplebuf_thread;
-	int triplebuf_thread_stop;
+	SDL_atomic_t triplebuf_thread_stop;
 
-	drm_input_dev *keyboards, *mice;
 	drm_scaling_mode scaling_mode;
+	SDL_Rect plane_rect; /* where the surface ends up on the CRTC */
+	int scaling_key;     /* key code cycling scaling_mode, -1 for none */
 
 	int w, h, crtc_w, crtc_h;
 	int bpp;
+	Uint32 refresh_period;
 	int has_damage_clips;
+
+	int cursor_w, cursor_h; /* cursor plane size, 0 until asked */
+	WMcursor *cursor;       /* on the cursor plane, NULL if hidden */
 };
 
 #define drm_vid_modes        (this->hidden->vid_modes)
@@ -0,0 +1,288 @@
+/* Pack files into an archive for SDL_OpenArchive(), then read them back
+
+   packassets [-z] archive.pak file...   Pack the files, -z tries LZ4 on each
+   packassets -t archive.pak file...     Check the archive against the files
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SDL.h"
+
+#define PAK_MAGIC   "SDLPAK\0\1"
+#define PAK_ALIGN   4096
+#define PAK_LZ4     0x01
+
+typedef struct {
+	const char *name;
+	Uint8 *data;
+	Uint32 size;
+	Uint8 *packed;
+	Uint32 stored;
+	Uint32 offset;
+} Asset;
+
+static void put32(Uint8 *p, Uint32 v) {
+	p[0] = v;
+	p[1] = v >> 8;
+	p[2] = v >> 16;
+	p[3] = v >> 24;
+}
+
+static Uint8 *put_length(Uint8 *op, Uint32 len) {
+	while (len >= 255) {
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = len;
+	return op;
+}
+
+/* Appends one sequence, returns NULL if it doesn't fit */
+static Uint8 *put_sequence(Uint8 *op, Uint8 *oend, const Uint8 *lit, Uint32 nlit, Uint32 offset, Uint32 mlen) {
+	Uint8 *token = op++;
+
+	if(op + nlit + nlit / 255 + 8 > oend) {
+		return NULL;
+	}
+	*token = (nlit >= 15 ? 15 : nlit) << 4;
+	if(nlit >= 15) {
+		op = put_length(op, nlit - 15);
+	}
+	memcpy(op, lit, nlit);
+	op += nlit;
+	if(mlen) {
+		*op++ = offset;
+		*op++ = offset >> 8;
+		mlen -= 4;
+		*token |= (mlen >= 15 ? 15 : mlen);
+		if(mlen >= 15) {
+			op = put_length(op, mlen - 15);
+		}
+	}
+	return op;
+}
+
+/* Greedy LZ4 block compressor, returns 0 when it doesn't save anything */
+static Uint32 lz4_compress(const Uint8 *src, Uint32 n, Uint8 *dst, Uint32 cap) {
+	static Uint32 table[4096];
+	const Uint8 *ip = src, *anchor = src, *end = src + n, *ref;
+	const Uint8 *mflimit = (n > 12) ? end - 12 : src;
+	const Uint8 *matchlimit = (n > 5) ? end - 5 : src;
+	Uint8 *op = dst, *oend = dst + cap;
+	Uint32 seq, h, len;
+
+	memset(table, 0, sizeof(table));
+	while (ip < mflimit) {
+		memcpy(&seq, ip, 4);
+		h = (seq * 2654435761U) >> 20;
+		ref = table[h] ? src + table[h] - 1 : NULL;
+		table[h] = ip - src + 1;
+		if(ref && ip - ref <= 65535 && memcmp(ref, ip, 4) == 0) {
+			len = 4;
+			while (ip + len < matchlimit && ref[len] == ip[len]) {
+				++len;
+			}
+			op = put_sequence(op, oend, anchor, ip - anchor, ip - ref, len);
+			if(op == NULL) {
+				return 0;
+			}
+			ip += len;
+			anchor = ip;
+		} else {
+			++ip;
+		}
+	}
+	op = put_sequence(op, oend, anchor, end - anchor, 0, 0);
+	if(op == NULL || (Uint32) (op - dst) >= n) {
+		return 0;
+	}
+	return op - dst;
+}
+
+static Uint8 *load(const char *file, Uint32 *size) {
+	SDL_RWops *src = SDL_RWFromFile(file, "rb");
+	Uint8 *data;
+	int end;
+
+	if(src == NULL) {
+		return NULL;
+	}
+	end = SDL_RWseek(src, 0, RW_SEEK_END);
+	SDL_RWseek(src, 0, RW_SEEK_SET);
+	data = (Uint8 *) malloc(end > 0 ? end : 1);
+	if(end > 0 && SDL_RWread(src, data, end, 1) != 1) {
+		free(data);
+		data = NULL;
+	}
+	SDL_RWclose(src);
+	*size = (end > 0) ? end : 0;
+	return data;
+}
+
+static int compare_assets(const void *a, const void *b) {
+	return strcmp(((const Asset *) a)->name, ((const Asset *) b)->name);
+}
+
+static int pack(const char *archive, Asset *assets, int count, int compress) {
+	static const Uint8 zeros[PAK_ALIGN];
+	Uint32 names_size, header, pos;
+	Uint8 *head;
+	FILE *out;
+	int i;
+
+	qsort(assets, count, sizeof(*assets), compare_assets);
+
+	names_size = 0;
+	for (i = 0; i < count; ++i) {
+		if(i > 0 && strcmp(assets[i - 1].name, assets[i].name) == 0) {
+			fprintf(stderr, "%s is listed twice\n", assets[i].name);
+			return 1;
+		}
+		names_size += strlen(assets[i].name) + 1;
+
+		assets[i].packed = assets[i].data;
+		assets[i].stored = assets[i].size;
+		if(compress) {
+			Uint8 *buf = (Uint8 *) malloc(assets[i].size + assets[i].size / 255 + 16);
+			Uint32 n = lz4_compress(assets[i].data, assets[i].size, buf, assets[i].size + assets[i].size / 255 + 16);
+			if(n) {
+				assets[i].packed = buf;
+				assets[i].stored = n;
+			} else {
+				free(buf);
+			}
+		}
+	}
+
+	header = 16 + count * 20 + names_size;
+	head = (Uint8 *) calloc(1, header);
+	memcpy(head, PAK_MAGIC, 8);
+	put32(head + 8, count);
+	put32(head + 12, names_size);
+
+	pos = (header + PAK_ALIGN - 1) & ~(PAK_ALIGN - 1);
+	names_size = 0;
+	for (i = 0; i < count; ++i) {
+		Uint8 *entry = head + 16 + i * 20;
+
+		assets[i].offset = pos;
+		put32(entry, names_size);
+		put32(entry + 4, (assets[i].packed != assets[i].data) ? PAK_LZ4 : 0);
+		put32(entry + 8, pos);
+		put32(entry + 12, assets[i].stored);
+		put32(entry + 16, assets[i].size);
+		strcpy((char *) head + 16 + count * 20 + names_size, assets[i].name);
+		names_size += strlen(assets[i].name) + 1;
+		pos = (pos + assets[i].stored + PAK_ALIGN - 1) & ~(PAK_ALIGN - 1);
+	}
+
+	out = fopen(archive, "wb");
+	if(out == NULL) {
+		fprintf(stderr, "Couldn't create %s\n", archive);
+		free(head);
+		return 1;
+	}
+	fwrite(head, header, 1, out);
+	pos = header;
+	for (i = 0; i < count; ++i) {
+		fwrite(zeros, assets[i].offset - pos, 1, out);
+		fwrite(assets[i].packed, assets[i].stored, 1, out);
+		pos = assets[i].offset + assets[i].stored;
+		printf("%-40s %8u -> %8u at %u\n", assets[i].name, (unsigned) assets[i].size, (unsigned) assets[i].stored, (unsigned) assets[i].offset);
+	}
+	fclose(out);
+	free(head);
+	return 0;
+}
+
+static int check(const char *file, Asset *assets, int count) {
+	SDL_Archive *archive;
+	SDL_RWops *rw;
+	Uint8 *data;
+	int i, size, failed = 0;
+	Uint32 then;
+
+	then = SDL_GetTicks();
+	archive = SDL_OpenArchive(file);
+	if(archive == NULL) {
+		fprintf(stderr, "Couldn't open %s: %s\n", file, SDL_GetError());
+		return 1;
+	}
+	for (i = 0; i < count; ++i) {
+		rw = SDL_RWFromArchive(archive, assets[i].name);
+		if(rw == NULL) {
+			printf("%s: %s\n", assets[i].name, SDL_GetError());
+			failed = 1;
+			continue;
+		}
+		size = SDL_RWseek(rw, 0, RW_SEEK_END);
+		SDL_RWseek(rw, 0, RW_SEEK_SET);
+		data = (Uint8 *) malloc(size > 0 ? size : 1);
+		if(size != (int) assets[i].size || (size && SDL_RWread(rw, data, size, 1) != 1) || memcmp(data, assets[i].data, size) != 0) {
+			printf("%s: contents differ\n", assets[i].name);
+			failed = 1;
+		}
+		free(data);
+		SDL_RWclose(rw);
+	}
+	if(SDL_RWFromArchive(archive, "no such file") != NULL) {
+		printf("Found a file that isn't there\n");
+		failed = 1;
+	}
+	SDL_CloseArchive(archive);
+	printf("%s: %d files %s in %u ms\n", file, count, failed ? "FAILED" : "OK", (unsigned) (SDL_GetTicks() - then));
+	return failed;
+}
+
+int main(int argc, char *argv[]) {
+	Asset *assets;
+	int compress = 0, test = 0;
+	int i, count, ret;
+
+	while (argc > 1 && argv[1][0] == '-') {
+		if(strcmp(argv[1], "-z") == 0) {
+			compress = 1;
+		} else if(strcmp(argv[1], "-t") == 0) {
+			test = 1;
+		} else {
+			break;
+		}
+		++argv;
+		--argc;
+	}
+	if(argc < 3) {
+		fprintf(stderr, "Usage: packassets [-z] archive file...\n       packassets -t archive file...\n");
+		return 1;
+	}
+
+	if(SDL_Init(0) < 0) {
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return 1;
+	}
+
+	count = argc - 2;
+	assets = (Asset *) calloc(count, sizeof(*assets));
+	for (i = 0; i < count; ++i) {
+		assets[i].name = argv[i + 2];
+		assets[i].data = load(argv[i + 2], &assets[i].size);
+		if(assets[i].data == NULL) {
+			fprintf(stderr, "Couldn't read %s\n", argv[i + 2]);
+			SDL_Quit();
+			return 1;
+		}
+	}
+
+	ret = test ? check(argv[1], assets, count) : pack(argv[1], assets, count, compress);
+
+	for (i = 0; i < count; ++i) {
+		if(assets[i].packed != assets[i].data) {
+			free(assets[i].packed);
+		}
+		free(assets[i].data);
+	}
+	free(assets);
+	SDL_Quit();
+	return ret;
+}
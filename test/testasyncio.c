@@ -0,0 +1,109 @@
+/* Test asynchronous file reads, loading a bitmap and a wave on the I/O thread */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SDL.h"
+#include "SDL_asyncio.h"
+
+typedef struct {
+	SDL_AudioSpec spec;
+	Uint8 *buf;
+	Uint32 len;
+} Wave;
+
+static void *SDLCALL LoadBitmap(SDL_RWops *src, void *data) {
+	return (SDL_LoadBMP_RW(src, 1));
+}
+
+static void *SDLCALL LoadWave(SDL_RWops *src, void *data) {
+	Wave *wave = (Wave *) data;
+
+	if(SDL_LoadWAV_RW(src, 1, &wave->spec, &wave->buf, &wave->len) == NULL) {
+		return NULL;
+	}
+	return (wave);
+}
+
+int main(int argc, char *argv[]) {
+	SDL_AsyncIO *bmp, *wav, *raw, *bad;
+	SDL_Surface *surface, *expected;
+	Wave wave;
+	SDL_Event event;
+	const void *data;
+	int size, finished, frames, failed = 0;
+
+	/* The event queue comes up with video, the dummy driver is enough */
+	if(getenv("SDL_VIDEODRIVER") == NULL) {
+		putenv("SDL_VIDEODRIVER=dummy");
+	}
+	if(SDL_Init(SDL_INIT_VIDEO) < 0) {
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return (1);
+	}
+
+	bmp = SDL_AsyncReadFile("sample.bmp", LoadBitmap, NULL, SDL_ASYNCIO_EVENT);
+	wav = SDL_AsyncReadFile("sample.wav", LoadWave, &wave, SDL_ASYNCIO_EVENT);
+	raw = SDL_AsyncReadFile("icon.bmp", NULL, NULL, 0);
+	bad = SDL_AsyncReadFile("no such file", NULL, NULL, SDL_ASYNCIO_EVENT);
+	if(!bmp || !wav || !raw || !bad) {
+		fprintf(stderr, "Couldn't queue reads: %s\n", SDL_GetError());
+		SDL_Quit();
+		return (1);
+	}
+
+	/* Keep "rendering" until every event has arrived */
+	finished = 0;
+	frames = 0;
+	while (finished < 3) {
+		while (SDL_PollEvent(&event)) {
+			if(event.type == SDL_ASYNCIODONE) {
+				printf("%s finished: %s\n", event.asyncio.io == bmp ? "sample.bmp" : event.asyncio.io == wav ? "sample.wav" : "no such file",
+				       event.asyncio.status == SDL_ASYNCIO_DONE ? "done" : "failed");
+				++finished;
+			}
+		}
+		++frames;
+		SDL_Delay(1);
+	}
+	printf("Main loop ran %d frames while loading\n", frames);
+
+	if(SDL_AsyncIOStatus(bad) != SDL_ASYNCIO_FAILED) {
+		printf("Reading a missing file didn't fail\n");
+		failed = 1;
+	} else {
+		printf("Missing file: %s\n", SDL_GetError());
+	}
+
+	surface = (SDL_Surface *) SDL_AsyncIOResult(bmp);
+	expected = SDL_LoadBMP("sample.bmp");
+	if(!surface || !expected || surface->w != expected->w || surface->h != expected->h) {
+		printf("sample.bmp came back wrong\n");
+		failed = 1;
+	}
+	SDL_FreeSurface(expected);
+	SDL_FreeSurface(surface);
+
+	if(SDL_AsyncIOResult(wav) != &wave) {
+		printf("sample.wav came back wrong\n");
+		failed = 1;
+	} else {
+		printf("sample.wav: %d Hz, %d channels, %u bytes\n", wave.spec.freq, wave.spec.channels, (unsigned) wave.len);
+		SDL_FreeWAV(wave.buf);
+	}
+
+	if(SDL_AsyncIOWait(raw) != SDL_ASYNCIO_DONE || (data = SDL_AsyncIOData(raw, &size)) == NULL || size < 2 || memcmp(data, "BM", 2) != 0) {
+		printf("icon.bmp came back wrong\n");
+		failed = 1;
+	}
+
+	SDL_AsyncIOFree(bmp);
+	SDL_AsyncIOFree(wav);
+	SDL_AsyncIOFree(raw);
+	SDL_AsyncIOFree(bad);
+
+	printf("%s\n", failed ? "FAILED" : "OK");
+	SDL_Quit();
+	return (failed);
+}
@@ -0,0 +1,103 @@
+/* Simple test of the SDL atomic operations and spinlocks */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+#include "SDL_atomic.h"
+#include "SDL_thread.h"
+
+#define NUM_THREADS 4
+#define NUM_ITERATIONS 100000
+
+static SDL_atomic_t counter;
+static SDL_SpinLock lock;
+static int guarded = 0;
+static int failed = 0;
+
+static void check(const char *what, int ok) {
+	printf("%-40s %s\n", what, ok ? "passed" : "FAILED");
+	if(!ok) {
+		failed = 1;
+	}
+}
+
+static void TestBasics(void) {
+	SDL_atomic_t a;
+	SDL_SpinLock l = 0;
+	void *ptr = NULL;
+	int value;
+
+	check("SpinLock: TryLock free lock", SDL_AtomicTryLock(&l));
+	check("SpinLock: TryLock held lock", !SDL_AtomicTryLock(&l));
+	SDL_AtomicUnlock(&l);
+	SDL_AtomicLock(&l);
+	SDL_AtomicUnlock(&l);
+	check("SpinLock: unlocked", SDL_AtomicTryLock(&l));
+	SDL_AtomicUnlock(&l);
+
+	SDL_AtomicSet(&a, 10);
+	check("AtomicSet/Get", SDL_AtomicGet(&a) == 10);
+	value = SDL_AtomicAdd(&a, 5);
+	check("AtomicAdd returns old value", value == 10 && SDL_AtomicGet(&a) == 15);
+	check("AtomicCAS with wrong value", !SDL_AtomicCAS(&a, 10, 20));
+	check("AtomicCAS with right value", SDL_AtomicCAS(&a, 15, 20) && SDL_AtomicGet(&a) == 20);
+	SDL_AtomicSet(&a, 1);
+	SDL_AtomicIncRef(&a);
+	check("AtomicDecRef not reaching zero", !SDL_AtomicDecRef(&a));
+	check("AtomicDecRef reaching zero", SDL_AtomicDecRef(&a));
+
+	check("AtomicSetPtr returns old value", SDL_AtomicSetPtr(&ptr, &a) == NULL);
+	check("AtomicGetPtr", SDL_AtomicGetPtr(&ptr) == &a);
+	check("AtomicCASPtr with wrong value", !SDL_AtomicCASPtr(&ptr, NULL, &l));
+	check("AtomicCASPtr with right value", SDL_AtomicCASPtr(&ptr, &a, &l) && ptr == &l);
+}
+
+static int SDLCALL ThreadFunc(void *data) {
+	int i;
+
+	for (i = 0; i < NUM_ITERATIONS; ++i) {
+		SDL_AtomicIncRef(&counter);
+
+		SDL_AtomicLock(&lock);
+		++guarded;
+		SDL_AtomicUnlock(&lock);
+	}
+	return 0;
+}
+
+static void TestThreads(void) {
+	SDL_Thread *threads[NUM_THREADS];
+	Uint32 start;
+	int i, n = 0;
+
+	SDL_AtomicSet(&counter, 0);
+	start = SDL_GetTicks();
+	for (i = 0; i < NUM_THREADS; ++i) {
+		threads[n] = SDL_CreateThread(ThreadFunc, NULL);
+		if(threads[n] == NULL) {
+			printf("Couldn't create thread: %s\n", SDL_GetError());
+			continue;
+		}
+		++n;
+	}
+	for (i = 0; i < n; ++i) {
+		SDL_WaitThread(threads[i], NULL);
+	}
+	printf("%d threads x %d iterations in %d ms\n", n, NUM_ITERATIONS, SDL_GetTicks() - start);
+	check("Threaded AtomicAdd", SDL_AtomicGet(&counter) == n * NUM_ITERATIONS);
+	check("Threaded SpinLock", guarded == n * NUM_ITERATIONS);
+}
+
+int main(int argc, char *argv[]) {
+	if(SDL_Init(0) < 0) {
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return (1);
+	}
+
+	TestBasics();
+	TestThreads();
+
+	SDL_Quit();
+	return (failed);
+}
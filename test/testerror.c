@@ -1,4 +1,4 @@
-/* Simple test of the SDL threading code and error handling */
+/* Simple test of the SDL threading code, thread local storage and error handling */
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -8,6 +8,7 @@
 #include "SDL_thread.h"
 
 static int alive = 0;
+static SDL_TLSID tls;
 
 /* Call this instead of exit(), so we can clean up SDL: atexit() is evil. */
 static void quit(int rc) {
@@ -18,11 +19,13 @@ static void quit(int rc) {
 int SDLCALL ThreadFunc(void *data) {
 	/* Set the child thread error string */
 	SDL_SetError("Thread %s (%d) had a problem: %s", (char *) data, SDL_ThreadID(), "nevermind");
+	SDL_TLSSet(tls, data, NULL);
 	while (alive) {
 		printf("Thread '%s' is alive!\n", (char *) data);
 		SDL_Delay(1 * 1000);
 	}
 	printf("Child thread error string: %s\n", SDL_GetError());
+	printf("Child thread local value: %s\n", (char *) SDL_TLSGet(tls));
 	return (0);
 }
 
@@ -38,6 +41,10 @@ int main(int argc, char *argv[]) {
 	/* Set the error value for the main thread */
 	SDL_SetError("No worries");
 
+	/* Give each thread its own value for the same key */
+	tls = SDL_TLSCreate();
+	SDL_TLSSet(tls, "main", NULL);
+
 	alive = 1;
 	thread = SDL_CreateThread(ThreadFunc, "#1");
 	if(thread == NULL) {
@@ -50,6 +57,7 @@ int main(int argc, char *argv[]) {
 	SDL_WaitThread(thread, NULL);
 
 	printf("Main thread error string: %s\n", SDL_GetError());
+	printf("Main thread local value: %s\n", (char *) SDL_TLSGet(tls));
 
 	SDL_Quit();
 	return (0);
@@ -33,6 +33,153 @@ static void rwops_error_quit(unsigned line, SDL_RWops *rwops) {
 
 #define RWOP_ERR_QUIT(x)    rwops_error_quit( __LINE__, (x) )
 
+/* Opens FBASENAME1 read-only, which holds "12345678901234567890" followed
+   by "1234567", and checks it reads back through the expected backend */
+static void check_reader(Uint32 type) {
+	SDL_RWops *rwops;
+	char test_buf[30];
+
+	rwops = SDL_RWFromFile(FBASENAME1, "rb");
+	if(!rwops)
+		RWOP_ERR_QUIT(rwops);
+	if(rwops->type != type)
+		RWOP_ERR_QUIT(rwops);
+	if(20 != rwops->seek(rwops, -7, RW_SEEK_END))
+		RWOP_ERR_QUIT(rwops);
+	if(7 != rwops->read(rwops, test_buf, 1, 7))
+		RWOP_ERR_QUIT(rwops);
+	if(SDL_memcmp(test_buf, "1234567", 7))
+		RWOP_ERR_QUIT(rwops);
+	if(0 != rwops->read(rwops, test_buf, 1, 1))
+		RWOP_ERR_QUIT(rwops);
+	if(0 != rwops->seek(rwops, -27, RW_SEEK_CUR))
+		RWOP_ERR_QUIT(rwops);
+	if(2 != rwops->read(rwops, test_buf, 10, 3))
+		RWOP_ERR_QUIT(rwops);
+	if(SDL_memcmp(test_buf, "12345678901234567890", 20))
+		RWOP_ERR_QUIT(rwops);
+	if(5 != rwops->seek(rwops, 5, RW_SEEK_SET))
+		RWOP_ERR_QUIT(rwops);
+	if(1 != rwops->read(rwops, test_buf, 5, 1))
+		RWOP_ERR_QUIT(rwops);
+	if(SDL_memcmp(test_buf, "67890", 5))
+		RWOP_ERR_QUIT(rwops);
+	if(0 != rwops->write(rwops, test_buf, 1, 1))
+		RWOP_ERR_QUIT(rwops); /* readonly mode */
+	rwops->close(rwops);
+}
+
+/* Reads FBASENAME1 when it's empty */
+static void check_empty(SDL_RWops *rwops, Uint32 type) {
+	char test_buf[4];
+
+	if(!rwops || rwops->type != type)
+		RWOP_ERR_QUIT(rwops);
+	if(0 != SDL_RWsize(rwops))
+		RWOP_ERR_QUIT(rwops);
+	if(0 != rwops->read(rwops, test_buf, 1, 4))
+		RWOP_ERR_QUIT(rwops);
+	if(0 != rwops->seek(rwops, 0, RW_SEEK_END) || 0 != SDL_RWtell(rwops))
+		RWOP_ERR_QUIT(rwops);
+	rwops->close(rwops);
+}
+
+static int SDLCALL fake_seek(SDL_RWops *context, int offset, int whence) {
+	return (0);
+}
+
+/* Byte found at a given offset of the boundary test file */
+#define PATTERN(i)    ((Uint8) ((i) * 7 + ((i) >> 8)))
+#define PATTERN_SIZE  (3 * 8192)
+
+static int check_pattern(const Uint8 *buf, int offset, int len) {
+	int i;
+
+	for (i = 0; i < len; ++i) {
+		if(buf[i] != PATTERN(offset + i)) {
+			return (0);
+		}
+	}
+	return (1);
+}
+
+/* Reads FBASENAME1, filled with PATTERN(), across the 8 KiB read-ahead
+   buffer boundaries */
+static void check_boundary(Uint32 type) {
+	SDL_RWops *rwops;
+	static Uint8 buf[PATTERN_SIZE];
+
+	rwops = SDL_RWFromFile(FBASENAME1, "rb");
+	if(!rwops || rwops->type != type)
+		RWOP_ERR_QUIT(rwops);
+	if(PATTERN_SIZE != SDL_RWsize(rwops))
+		RWOP_ERR_QUIT(rwops);
+	if(0 != SDL_RWtell(rwops))
+		RWOP_ERR_QUIT(rwops);
+	if(8190 != SDL_RWseek(rwops, 8190, RW_SEEK_SET))
+		RWOP_ERR_QUIT(rwops);
+	if(1 != SDL_RWread(rwops, buf, 4, 1) || !check_pattern(buf, 8190, 4))
+		RWOP_ERR_QUIT(rwops);
+	if(8192 != SDL_RWseek(rwops, -2, RW_SEEK_CUR))
+		RWOP_ERR_QUIT(rwops);
+	if(1 != SDL_RWread(rwops, buf, 2, 1) || !check_pattern(buf, 8192, 2))
+		RWOP_ERR_QUIT(rwops);
+	if(PATTERN_SIZE != SDL_RWsize(rwops) || 8194 != SDL_RWtell(rwops))
+		RWOP_ERR_QUIT(rwops);
+	if(1 != SDL_RWread(rwops, buf, 1, 1) || !check_pattern(buf, 8194, 1))
+		RWOP_ERR_QUIT(rwops);
+	if(16380 != SDL_RWseek(rwops, 16380, RW_SEEK_SET))
+		RWOP_ERR_QUIT(rwops);
+	if(8 != SDL_RWread(rwops, buf, 1, 8) || !check_pattern(buf, 16380, 8))
+		RWOP_ERR_QUIT(rwops);
+	if(100 != SDL_RWseek(rwops, 100, RW_SEEK_SET))
+		RWOP_ERR_QUIT(rwops);
+	if(1 != SDL_RWread(rwops, buf, 10000, 1) || !check_pattern(buf, 100, 10000))
+		RWOP_ERR_QUIT(rwops);
+	if(1 != SDL_RWread(rwops, buf, 16, 1) || !check_pattern(buf, 10100, 16))
+		RWOP_ERR_QUIT(rwops);
+	if(PATTERN_SIZE - 4 != SDL_RWseek(rwops, -4, RW_SEEK_END))
+		RWOP_ERR_QUIT(rwops);
+	if(4 != SDL_RWread(rwops, buf, 1, 10) || !check_pattern(buf, PATTERN_SIZE - 4, 4))
+		RWOP_ERR_QUIT(rwops);
+	rwops->close(rwops);
+}
+
+/* FBASENAME1 is a sparse file holding "END" at offset BIG_OFFSET */
+#define BIG_OFFSET    ((Sint64) 3 << 30)
+
+static void check_big(Uint32 type) {
+	SDL_RWops *rwops;
+	char test_buf[4];
+
+	rwops = SDL_RWFromFile(FBASENAME1, "rb");
+	if(!rwops || rwops->type != type)
+		RWOP_ERR_QUIT(rwops);
+	if(BIG_OFFSET + 3 != SDL_RWsize(rwops))
+		RWOP_ERR_QUIT(rwops);
+	if(BIG_OFFSET != SDL_RWseek64(rwops, BIG_OFFSET, RW_SEEK_SET))
+		RWOP_ERR_QUIT(rwops);
+	if(3 != SDL_RWread(rwops, test_buf, 1, 3) || SDL_memcmp(test_buf, "END", 3))
+		RWOP_ERR_QUIT(rwops);
+	if(BIG_OFFSET + 3 != SDL_RWtell64(rwops))
+		RWOP_ERR_QUIT(rwops);
+	if(-1 != SDL_RWtell(rwops))
+		RWOP_ERR_QUIT(rwops); /* too far for the int seek */
+	if(BIG_OFFSET + 1 != SDL_RWseek64(rwops, -2, RW_SEEK_END))
+		RWOP_ERR_QUIT(rwops);
+	if(2 != SDL_RWread(rwops, test_buf, 1, 2) || SDL_memcmp(test_buf, "ND", 2))
+		RWOP_ERR_QUIT(rwops);
+	if(BIG_OFFSET - 1 != SDL_RWseek64(rwops, -4, RW_SEEK_CUR))
+		RWOP_ERR_QUIT(rwops);
+	if(4 != SDL_RWread(rwops, test_buf, 1, 4) || SDL_memcmp(test_buf, "\0END", 4))
+		RWOP_ERR_QUIT(rwops);
+	if(BIG_OFFSET + 3 != SDL_RWsize(rwops))
+		RWOP_ERR_QUIT(rwops);
+	if(10 != SDL_RWseek64(rwops, 10, RW_SEEK_SET) || 10 != SDL_RWtell(rwops))
+		RWOP_ERR_QUIT(rwops);
+	rwops->close(rwops);
+}
+
 int main(int argc, char *argv[]) {
 	SDL_RWops *rwops = NULL;
 	char test_buf[30];
@@ -244,6 +391,165 @@ int main(int argc, char *argv[]) {
 		RWOP_ERR_QUIT(rwops);
 	rwops->close(rwops);
 	printf("test5 OK\n");
+
+	/* test6 : read-only files go through stdio unless SDL_RWOPS_FD asks
+	   for the read-ahead backend */
+	rwops = SDL_RWFromFile(FBASENAME1, "wb");
+	if(!rwops)
+		RWOP_ERR_QUIT(rwops);
+	if(2 != rwops->write(rwops, "12345678901234567890", 10, 2))
+		RWOP_ERR_QUIT(rwops);
+	if(7 != rwops->write(rwops, "1234567", 1, 7))
+		RWOP_ERR_QUIT(rwops);
+	rwops->close(rwops);
+	SDL_putenv("SDL_RWOPS_FD=0");
+	check_reader(SDL_RWOPS_STDFILE);
+	SDL_putenv("SDL_RWOPS_FD=1");
+	check_reader(SDL_RWOPS_FDFILE);
+	SDL_putenv("SDL_RWOPS_FD=0");
+	printf("test6 OK\n");
+
+	/* test7 : reads and seeks around the read-ahead buffer, and SDL_RWsize()
+	   on every kind of RWops */
+	{
+		static Uint8 pattern[PATTERN_SIZE];
+		int i;
+
+		for (i = 0; i < PATTERN_SIZE; ++i) {
+			pattern[i] = PATTERN(i);
+		}
+		rwops = SDL_RWFromFile(FBASENAME1, "wb");
+		if(!rwops)
+			RWOP_ERR_QUIT(rwops);
+		if(1 != rwops->write(rwops, pattern, PATTERN_SIZE, 1))
+			RWOP_ERR_QUIT(rwops);
+		if(PATTERN_SIZE != SDL_RWsize(rwops))
+			RWOP_ERR_QUIT(rwops);
+		rwops->close(rwops);
+		check_boundary(SDL_RWOPS_STDFILE);
+		SDL_putenv("SDL_RWOPS_FD=1");
+		check_boundary(SDL_RWOPS_FDFILE);
+		SDL_putenv("SDL_RWOPS_FD=0");
+
+		rwops = SDL_RWFromMem(pattern, 30);
+		if(!rwops)
+			RWOP_ERR_QUIT(rwops);
+		if(12 != SDL_RWseek(rwops, 12, RW_SEEK_SET))
+			RWOP_ERR_QUIT(rwops);
+		if(30 != SDL_RWsize(rwops) || 12 != SDL_RWtell(rwops))
+			RWOP_ERR_QUIT(rwops);
+		rwops->close(rwops);
+		rwops = SDL_RWFromConstMem(pattern, 0);
+		if(!rwops)
+			RWOP_ERR_QUIT(rwops);
+		if(0 != SDL_RWsize(rwops))
+			RWOP_ERR_QUIT(rwops);
+		rwops->close(rwops);
+	}
+	printf("test7 OK\n");
+
+	/* test8 : offsets past 2 GiB through SDL_RWseek64() */
+	rwops = SDL_RWFromFile(FBASENAME1, "wb");
+	if(!rwops)
+		RWOP_ERR_QUIT(rwops);
+	if(BIG_OFFSET != SDL_RWseek64(rwops, BIG_OFFSET, RW_SEEK_SET))
+		RWOP_ERR_QUIT(rwops);
+	if(3 != rwops->write(rwops, "END", 1, 3))
+		RWOP_ERR_QUIT(rwops);
+	rwops->close(rwops);
+	check_big(SDL_RWOPS_STDFILE);
+	SDL_putenv("SDL_RWOPS_FD=1");
+	check_big(SDL_RWOPS_FDFILE);
+	SDL_putenv("SDL_RWOPS_FD=0");
+	printf("test8 OK\n");
+
+	/* test9 : mapped files, empty files and SDL_RWGetMemory() */
+	{
+		static const char text[] = "12345678901234567890";
+		const Uint8 *mem;
+		int size;
+
+		if(SDL_RWFromMappedFile(NULL, 0) || SDL_RWFromMappedFile("", 0))
+			RWOP_ERR_QUIT(NULL);
+		if(SDL_RWFromMappedFile(FBASENAME2, 0)) /* doesn't exist */
+			RWOP_ERR_QUIT(NULL);
+		if(SDL_RWFromMappedFile(".", 0)) /* not a regular file */
+			RWOP_ERR_QUIT(NULL);
+
+		rwops = SDL_RWFromFile(FBASENAME1, "wb");
+		if(!rwops)
+			RWOP_ERR_QUIT(rwops);
+		if(1 != rwops->write(rwops, text, 20, 1))
+			RWOP_ERR_QUIT(rwops);
+		rwops->close(rwops);
+
+		rwops = SDL_RWFromMappedFile(FBASENAME1, SDL_RWMAP_SEQUENTIAL | SDL_RWMAP_WILLNEED);
+		if(!rwops || rwops->type != SDL_RWOPS_MAPPED)
+			RWOP_ERR_QUIT(rwops);
+		mem = (const Uint8 *) SDL_RWGetMemory(rwops, &size);
+		if(!mem || size != 20 || SDL_memcmp(mem, text, 20))
+			RWOP_ERR_QUIT(rwops);
+		if(20 != SDL_RWsize(rwops))
+			RWOP_ERR_QUIT(rwops);
+		if(15 != rwops->seek(rwops, -5, RW_SEEK_END))
+			RWOP_ERR_QUIT(rwops);
+		if(5 != rwops->read(rwops, test_buf, 1, 10) || SDL_memcmp(test_buf, "67890", 5))
+			RWOP_ERR_QUIT(rwops);
+		if(3 != rwops->seek(rwops, 3, RW_SEEK_SET))
+			RWOP_ERR_QUIT(rwops);
+		if(1 != rwops->read(rwops, test_buf, 4, 1) || SDL_memcmp(test_buf, "4567", 4))
+			RWOP_ERR_QUIT(rwops);
+		if(2 != rwops->seek(rwops, -5, RW_SEEK_CUR))
+			RWOP_ERR_QUIT(rwops);
+		if(0 != rwops->seek(rwops, -5, RW_SEEK_SET))
+			RWOP_ERR_QUIT(rwops); /* clamped like memory */
+		if(20 != rwops->seek(rwops, 50, RW_SEEK_SET) || 0 != rwops->read(rwops, test_buf, 1, 1))
+			RWOP_ERR_QUIT(rwops);
+		if(-1 != rwops->write(rwops, "x", 1, 1))
+			RWOP_ERR_QUIT(rwops); /* read-only mapping */
+		rwops->close(rwops);
+
+		/* SDL_RWGetMemory() only hands out our own memory streams */
+		rwops = SDL_RWFromConstMem(text, 20);
+		if(!rwops)
+			RWOP_ERR_QUIT(rwops);
+		if(SDL_RWGetMemory(rwops, &size) != (const void *) text || size != 20)
+			RWOP_ERR_QUIT(rwops);
+		rwops->close(rwops);
+		rwops = SDL_RWFromFile(FBASENAME1, "rb");
+		if(!rwops || SDL_RWGetMemory(rwops, &size))
+			RWOP_ERR_QUIT(rwops);
+		rwops->close(rwops);
+		SDL_putenv("SDL_RWOPS_FD=1");
+		rwops = SDL_RWFromFile(FBASENAME1, "rb");
+		SDL_putenv("SDL_RWOPS_FD=0");
+		if(!rwops || SDL_RWGetMemory(rwops, &size))
+			RWOP_ERR_QUIT(rwops);
+		rwops->close(rwops);
+		rwops = SDL_AllocRW();
+		if(!rwops)
+			RWOP_ERR_QUIT(rwops);
+		rwops->type = SDL_RWOPS_MEMORY; /* anyone can claim to be memory */
+		rwops->seek = fake_seek;
+		if(SDL_RWGetMemory(rwops, &size) || SDL_RWGetMemory(NULL, &size))
+			RWOP_ERR_QUIT(NULL);
+		SDL_FreeRW(rwops);
+
+		/* Empty files read as empty through every backend */
+		rwops = SDL_RWFromFile(FBASENAME1, "wb");
+		if(!rwops)
+			RWOP_ERR_QUIT(rwops);
+		rwops->close(rwops);
+		check_empty(SDL_RWFromFile(FBASENAME1, "rb"), SDL_RWOPS_STDFILE);
+		SDL_putenv("SDL_RWOPS_FD=1");
+		check_empty(SDL_RWFromFile(FBASENAME1, "rb"), SDL_RWOPS_FDFILE);
+		SDL_putenv("SDL_RWOPS_FD=0");
+		rwops = SDL_RWFromMappedFile(FBASENAME1, 0);
+		if(!rwops || SDL_RWGetMemory(rwops, &size) || size != 0)
+			RWOP_ERR_QUIT(rwops);
+		check_empty(rwops, SDL_RWOPS_MAPPED);
+	}
+	printf("test9 OK\n");
 	cleanup();
 	return 0; /* all ok */
 }
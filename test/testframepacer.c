@@ -0,0 +1,73 @@
+/* Test program for the frame pacing API.
+   Run with SDL_VIDEODRIVER=dummy and SDL_VIDEO_REFRESHRATE=<hz> to pace
+   against a synthetic display refresh.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define DEFAULT_FRAMES  300
+
+int main(int argc, char *argv[]) {
+	SDL_Surface *screen;
+	SDL_FrameStats stats;
+	Uint32 start, elapsed;
+	int frames, interval;
+	int i;
+
+	frames = DEFAULT_FRAMES;
+	interval = 1;
+	for (i = 1; argv[i]; ++i) {
+		if((SDL_strcmp(argv[i], "-frames") == 0) && argv[i + 1]) {
+			frames = atoi(argv[++i]);
+		} else if((SDL_strcmp(argv[i], "-interval") == 0) && argv[i + 1]) {
+			interval = atoi(argv[++i]);
+		} else {
+			fprintf(stderr, "Usage: %s [-frames N] [-interval N]\n", argv[0]);
+			return (1);
+		}
+	}
+
+	if(SDL_Init(SDL_INIT_VIDEO) < 0) {
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return (1);
+	}
+	screen = SDL_SetVideoMode(320, 240, 16, SDL_DOUBLEBUF);
+	if(screen == NULL) {
+		fprintf(stderr, "Couldn't set video mode: %s\n", SDL_GetError());
+		SDL_Quit();
+		return (1);
+	}
+	if(SDL_SetFrameInterval(interval) < 0) {
+		fprintf(stderr, "Couldn't set frame interval: %s\n", SDL_GetError());
+		SDL_Quit();
+		return (1);
+	}
+
+	printf("Refresh period: %u us\n", SDL_GetRefreshPeriod());
+	printf("Presenting %d frames every %d refresh(es)\n", frames, interval);
+
+	start = SDL_GetTicks();
+	for (i = 0; i < frames; ++i) {
+		/* Fake a workload, with an occasional frame that overruns */
+		SDL_FillRect(screen, NULL, SDL_MapRGB(screen->format, i & 0xFF, 0, 0));
+		if((i % 50) == 49) {
+			SDL_Delay((SDL_GetRefreshPeriod() * interval) / 1000 + 5);
+		}
+		if(SDL_PacedFlip(screen) < 0) {
+			fprintf(stderr, "Flip failed: %s\n", SDL_GetError());
+			break;
+		}
+	}
+	elapsed = SDL_GetTicks() - start;
+
+	SDL_GetFrameStats(&stats);
+	printf("Elapsed: %u ms (%.2f fps)\n", elapsed, elapsed ? (stats.frames * 1000.0) / elapsed : 0.0);
+	printf("Frames: %u, missed refreshes: %u\n", stats.frames, stats.missed);
+	printf("Drift: %d us, last frame: %u us, worst frame: %u us\n", stats.drift, stats.last_frame, stats.worst_frame);
+
+	SDL_Quit();
+	return (0);
+}
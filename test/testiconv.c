@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "SDL.h"
 
@@ -11,6 +12,126 @@ static size_t widelen(char *data) {
 	return len;
 }
 
+/* Bytes in a converted string up to and including its terminator */
+static size_t encodedlen(const char *data, const char *format) {
+	size_t unit = SDL_strstr(format, "16") ? 2 : SDL_strstr(format, "8") ? 1 : 4;
+	size_t len = 0;
+
+	while (SDL_memcmp(data + len, "\0\0\0\0", unit) != 0) {
+		len += unit;
+	}
+	return (len + unit);
+}
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#define UTF16NATIVE "UTF-16BE"
+#define UTF32NATIVE "UTF-32BE"
+#else
+#define UTF16NATIVE "UTF-16LE"
+#define UTF32NATIVE "UTF-32LE"
+#endif
+
+static int check(const char *name, int ok) {
+	if(!ok) {
+		fprintf(stderr, "FAIL: %s\n", name);
+	}
+	return (ok ? 0 : 1);
+}
+
+/* SDL_UTF8ToUTF16() and friends on the awkward cases */
+static int test_bulk(void) {
+	static const char emoji[] = "a\xF0\x9F\x98\x80";
+	static const char bad[] = "\xC0\xAF" "\xE0\x80\x80" "\xED\xA0\x80" "\xF4\x90\x80\x80" "\xEF\xBF\xBE" "\xE2\x82";
+	static const Uint16 lone[] = { 0xD800, 'a', 0xDC00 };
+	static const Uint32 wide[] = { 'a', 0xE9, 0x20AC, 0x1F600, 0xD800, 0x110000 };
+	Uint16 utf16[16];
+	Uint32 ucs4[16];
+	char utf8[32];
+	int errors = 0;
+	size_t i, len;
+
+	/* A surrogate pair, measured without a buffer and never split */
+	errors += check("UTF-8 to UTF-16 measuring", SDL_UTF8ToUTF16(emoji, 5, NULL, 0) == 3);
+	len = SDL_UTF8ToUTF16(emoji, 5, utf16, SDL_arraysize(utf16));
+	errors += check("UTF-8 to UTF-16 surrogates", len == 3 && utf16[0] == 'a' && utf16[1] == 0xD83D && utf16[2] == 0xDE00);
+	utf16[1] = 0;
+	errors += check("UTF-8 to UTF-16 truncation", SDL_UTF8ToUTF16(emoji, 5, utf16, 2) == 3 && utf16[0] == 'a' && utf16[1] == 0);
+	len = SDL_UTF16ToUTF8(utf16, 1, NULL, 0);
+	errors += check("UTF-16 to UTF-8 measuring", len == 1);
+
+	/* Overlong, surrogate, out of range, noncharacter and cut short */
+	len = SDL_UTF8ToUCS4(bad, sizeof(bad) - 1, ucs4, SDL_arraysize(ucs4));
+	i = 0;
+	while (i < len && ucs4[i] == 0xFFFD) {
+		++i;
+	}
+	errors += check("invalid UTF-8", len == 7 && i == len);
+	errors += check("invalid UTF-8 measuring", SDL_UTF8ToUCS4(bad, sizeof(bad) - 1, NULL, 0) == len);
+	len = SDL_UTF16ToUTF8(lone, SDL_arraysize(lone), utf8, sizeof(utf8));
+	errors += check("lone surrogates", len == 7 && SDL_memcmp(utf8, "\xEF\xBF\xBD" "a" "\xEF\xBF\xBD", 7) == 0);
+
+	len = SDL_UCS4ToUTF8(wide, SDL_arraysize(wide), utf8, sizeof(utf8));
+	errors += check("UCS-4 to UTF-8", len == 16 && SDL_memcmp(utf8, "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xEF\xBF\xBD\xEF\xBF\xBD", 16) == 0);
+	errors += check("UCS-4 to UTF-8 truncation", SDL_UCS4ToUTF8(wide, SDL_arraysize(wide), utf8, 4) == 16);
+
+	/* Latin-1 has no euro sign */
+	len = SDL_UTF8ToLatin1("a\xC3\xA9\xE2\x82\xAC", 6, utf8, sizeof(utf8));
+	errors += check("UTF-8 to Latin-1", len == 3 && SDL_memcmp(utf8, "a\xE9?", 3) == 0);
+	len = SDL_Latin1ToUTF8("a\xE9\xFF", 3, utf8, sizeof(utf8));
+	errors += check("Latin-1 to UTF-8", len == 5 && SDL_memcmp(utf8, "a\xC3\xA9\xC3\xBF", 5) == 0);
+	return (errors);
+}
+
+/* The bulk converters and SDL_iconv_string() agree, ASCII runs included */
+static int test_iconv_string(void) {
+	static const char *pieces[] = { "plain ascii text long enough for a vector ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "x" };
+	char text[2048], *conv, *back, *odd;
+	Uint16 utf16[2048];
+	Uint32 ucs4[2048];
+	size_t i, len = 0, n;
+	int errors = 0;
+
+	srand(1);
+	while (len < sizeof(text) - 64) {
+		const char *piece = pieces[rand() % SDL_arraysize(pieces)];
+		SDL_memcpy(text + len, piece, SDL_strlen(piece));
+		len += SDL_strlen(piece);
+	}
+
+	n = SDL_UTF8ToUTF16(text, len, utf16, SDL_arraysize(utf16));
+	conv = SDL_iconv_string(UTF16NATIVE, "UTF-8", text, len);
+	errors += check("UTF-16 against SDL_iconv_string", conv && SDL_memcmp(conv, utf16, n * 2) == 0 && conv[n * 2] == 0);
+	back = SDL_iconv_string("UTF-8", UTF16NATIVE, conv, n * 2);
+	errors += check("UTF-16 round trip", back && SDL_memcmp(back, text, len) == 0);
+	SDL_free(back);
+
+	/* Input at an odd address takes the generic path with the same result */
+	odd = (char *) SDL_malloc(n * 2 + 1);
+	SDL_memcpy(odd + 1, conv, n * 2);
+	back = SDL_iconv_string("UTF-8", UTF16NATIVE, odd + 1, n * 2);
+	errors += check("unaligned UTF-16", back && SDL_memcmp(back, text, len) == 0);
+	SDL_free(back);
+	SDL_free(odd);
+	SDL_free(conv);
+
+	n = SDL_UTF8ToUCS4(text, len, ucs4, SDL_arraysize(ucs4));
+	conv = SDL_iconv_string(UTF32NATIVE, "UTF-8", text, len);
+	errors += check("UTF-32 against SDL_iconv_string", conv && SDL_memcmp(conv, ucs4, n * 4) == 0);
+	SDL_free(conv);
+
+	for (i = 0; i < n; ++i) {
+		if(ucs4[i] > 0xFF) {
+			ucs4[i] = '?';
+		}
+	}
+	n = SDL_UCS4ToUTF8(ucs4, n, text, sizeof(text));
+	conv = SDL_iconv_string("ISO-8859-1", "UTF-8", text, n);
+	len = SDL_UTF8ToLatin1(text, n, (char *) utf16, sizeof(utf16));
+	errors += check("Latin-1 against SDL_iconv_string", conv && SDL_memcmp(conv, utf16, len) == 0);
+	SDL_free(conv);
+	return (errors);
+}
+
 int main(int argc, char *argv[]) {
 	const char *formats[] = {
 		"UTF8",
@@ -33,6 +154,9 @@ int main(int argc, char *argv[]) {
 	FILE *file;
 	int errors = 0;
 
+	errors += test_bulk();
+	errors += test_iconv_string();
+
 	if(!argv[1]) {
 		argv[1] = "utf8.txt";
 	}
@@ -49,8 +173,8 @@ int main(int argc, char *argv[]) {
 		len = (widelen(ucs4) + 1) * 4;
 		for (i = 0; i < SDL_arraysize(formats); ++i) {
 			test[0] = SDL_iconv_string(formats[i], "UCS-4", ucs4, len);
-			test[1] = SDL_iconv_string("UCS-4", formats[i], test[0], len);
-			if(!test[1] || SDL_memcmp(test[1], ucs4, len) != 0) {
+			test[1] = test[0] ? SDL_iconv_string("UCS-4", formats[i], test[0], encodedlen(test[0], formats[i])) : NULL;
+			if(!test[1] || (widelen(test[1]) + 1) * 4 != len || SDL_memcmp(test[1], ucs4, len) != 0) {
 				fprintf(stderr, "FAIL: %s\n", formats[i]);
 				++errors;
 			}
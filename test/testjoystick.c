@@ -14,6 +14,7 @@ void WatchJoystick(SDL_Joystick *joystick) {
 	const char *name;
 	int i, done;
 	SDL_Event event;
+	SDL_JoystickState state;
 	int x, y, draw;
 	SDL_Rect axis_area[2];
 
@@ -39,7 +40,7 @@ void WatchJoystick(SDL_Joystick *joystick) {
 		while (SDL_PollEvent(&event)) {
 			switch (event.type) {
 				case SDL_JOYAXISMOTION:
-					printf("Joystick %d axis %d value: %d\n", event.jaxis.which, event.jaxis.axis, event.jaxis.value);
+					printf("Joystick %d axis %d value: %d (%u ms ago)\n", event.jaxis.which, event.jaxis.axis, event.jaxis.value, SDL_GetTicks() - SDL_GetEventTimestamp());
 					break;
 				case SDL_JOYHATMOTION:
 					printf("Joystick %d hat %d value:", event.jhat.which, event.jhat.hat);
@@ -69,7 +70,31 @@ void WatchJoystick(SDL_Joystick *joystick) {
 				case SDL_JOYBUTTONUP:
 					printf("Joystick %d button %d up\n", event.jbutton.which, event.jbutton.button);
 					break;
+				case SDL_JOYDEVICEADDED:
+					printf("Joystick %d plugged in\n", event.jdevice.which);
+					break;
+				case SDL_JOYDEVICEREMOVED:
+					printf("Joystick %d unplugged\n", event.jdevice.which);
+					break;
 				case SDL_KEYDOWN:
+					if(event.key.keysym.sym == SDLK_r) {
+						SDL_InputRate rates[8];
+						int n = SDL_GetInputRates(rates, SDL_arraysize(rates));
+						while (n--) {
+							printf("%s: %u reports/s, %u events/s\n", rates[n].device, rates[n].reports, rates[n].events);
+						}
+						break;
+					}
+					if(event.key.keysym.sym == SDLK_s) {
+						if(SDL_JoystickEventState(SDL_QUERY) == SDL_JOYSTICK_STATEONLY) {
+							SDL_JoystickEventState(SDL_ENABLE);
+							printf("Joystick events enabled\n");
+						} else {
+							SDL_JoystickEventState(SDL_JOYSTICK_STATEONLY);
+							printf("Joystick state only, no events\n");
+						}
+						break;
+					}
 					if(event.key.keysym.sym != SDLK_ESCAPE) {
 						break;
 					}
@@ -82,14 +107,15 @@ void WatchJoystick(SDL_Joystick *joystick) {
 			}
 		}
 		/* Update visual joystick state */
-		for (i = 0; i < SDL_JoystickNumButtons(joystick); ++i) {
+		SDL_JoystickGetState(joystick, &state);
+		for (i = 0; i < state.nbuttons; ++i) {
 			SDL_Rect area;
 
 			area.x = i * 34;
 			area.y = SCREEN_HEIGHT - 34;
 			area.w = 32;
 			area.h = 32;
-			if(SDL_JoystickGetButton(joystick, i) == SDL_PRESSED) {
+			if(state.buttons[i] == SDL_PRESSED) {
 				SDL_FillRect(screen, &area, 0xFFFF);
 			} else {
 				SDL_FillRect(screen, &area, 0x0000);
@@ -102,7 +128,7 @@ void WatchJoystick(SDL_Joystick *joystick) {
 
 		/* Draw the X/Y axis */
 		draw = !draw;
-		x = (((int) SDL_JoystickGetAxis(joystick, 0)) + 32768);
+		x = (((int) (state.naxes > 0 ? state.axes[0] : 0)) + 32768);
 		x *= SCREEN_WIDTH;
 		x /= 65535;
 		if(x < 0) {
@@ -110,7 +136,7 @@ void WatchJoystick(SDL_Joystick *joystick) {
 		} else if(x > (SCREEN_WIDTH - 16)) {
 			x = SCREEN_WIDTH - 16;
 		}
-		y = (((int) SDL_JoystickGetAxis(joystick, 1)) + 32768);
+		y = (((int) (state.naxes > 1 ? state.axes[1] : 0)) + 32768);
 		y *= SCREEN_HEIGHT;
 		y /= 65535;
 		if(y < 0) {
@@ -0,0 +1,122 @@
+/* Test the read/write lock and fast mutex functions */
+
+#include <stdio.h>
+
+#include "SDL.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+
+#define NUM_READERS 4
+#define NUM_WRITERS 2
+#define NUM_ITERATIONS 20000
+
+static SDL_rwlock *rwlock = NULL;
+static SDL_mutex *mutex = NULL;
+static int shared[2];
+static int counter = 0;
+static int torn = 0;
+
+static int SDLCALL Reader(void *data) {
+	int i;
+
+	for (i = 0; i < NUM_ITERATIONS; ++i) {
+		SDL_LockRWLockForReading(rwlock);
+		if(shared[0] != shared[1]) {
+			++torn;
+		}
+		SDL_UnlockRWLock(rwlock);
+	}
+	return 0;
+}
+
+static int SDLCALL Writer(void *data) {
+	int i;
+
+	for (i = 0; i < NUM_ITERATIONS; ++i) {
+		SDL_LockRWLockForWriting(rwlock);
+		++shared[0];
+		++shared[1];
+		SDL_UnlockRWLock(rwlock);
+
+		SDL_mutexP(mutex);
+		++counter;
+		SDL_mutexV(mutex);
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	SDL_Thread *threads[NUM_READERS + NUM_WRITERS];
+	Uint32 start;
+	int i, writers = 0, failed = 0;
+
+	if(SDL_Init(0) < 0) {
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return (1);
+	}
+
+	rwlock = SDL_CreateRWLock();
+	mutex = SDL_CreateFastMutex();
+	if(!rwlock || !mutex) {
+		fprintf(stderr, "Couldn't create locks: %s\n", SDL_GetError());
+		SDL_Quit();
+		return (1);
+	}
+
+	/* Readers share the lock, a writer excludes everyone */
+	if(SDL_TryLockRWLockForReading(rwlock) != 0 || SDL_TryLockRWLockForReading(rwlock) != 0) {
+		fprintf(stderr, "Couldn't share the read lock\n");
+		failed = 1;
+	}
+	if(SDL_TryLockRWLockForWriting(rwlock) != SDL_MUTEX_TIMEDOUT) {
+		fprintf(stderr, "Write lock taken while readers hold the lock\n");
+		failed = 1;
+	}
+	SDL_UnlockRWLock(rwlock);
+	SDL_UnlockRWLock(rwlock);
+	if(SDL_TryLockRWLockForWriting(rwlock) != 0) {
+		fprintf(stderr, "Couldn't take the free write lock\n");
+		failed = 1;
+	}
+	if(SDL_TryLockRWLockForReading(rwlock) != SDL_MUTEX_TIMEDOUT) {
+		fprintf(stderr, "Read lock taken while a writer holds the lock\n");
+		failed = 1;
+	}
+	SDL_UnlockRWLock(rwlock);
+
+	start = SDL_GetTicks();
+	for (i = 0; i < NUM_READERS + NUM_WRITERS; ++i) {
+		if(i < NUM_WRITERS) {
+			threads[i] = SDL_CreateThread(Writer, NULL);
+			if(threads[i]) {
+				++writers;
+			}
+		} else {
+			threads[i] = SDL_CreateThread(Reader, NULL);
+		}
+		if(threads[i] == NULL) {
+			fprintf(stderr, "Couldn't create thread: %s\n", SDL_GetError());
+		}
+	}
+	for (i = 0; i < NUM_READERS + NUM_WRITERS; ++i) {
+		if(threads[i]) {
+			SDL_WaitThread(threads[i], NULL);
+		}
+	}
+	printf("%d readers, %d writers x %d iterations in %d ms\n", NUM_READERS, NUM_WRITERS, NUM_ITERATIONS, SDL_GetTicks() - start);
+
+	if(torn) {
+		fprintf(stderr, "Readers saw %d partial updates\n", torn);
+		failed = 1;
+	}
+	if(shared[0] != writers * NUM_ITERATIONS || counter != writers * NUM_ITERATIONS) {
+		fprintf(stderr, "Lost updates: %d/%d, expected %d\n", shared[0], counter, writers * NUM_ITERATIONS);
+		failed = 1;
+	}
+	printf("%s\n", failed ? "FAILED" : "All tests passed");
+
+	SDL_DestroyMutex(mutex);
+	SDL_DestroyRWLock(rwlock);
+	SDL_Quit();
+	return (failed);
+}
@@ -0,0 +1,147 @@
+/* Benchmark SDL_RadixSort() and SDL_MergeSort() against SDL_qsort() on
+   sprite draw lists sorted by depth
+
+   testsort [sprites] [frames]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+typedef struct {
+	Sint32 depth;
+	Uint32 index;
+} Sprite;
+
+static int compare_sprites(const void *a, const void *b) {
+	const Sprite *sa = (const Sprite *) a;
+	const Sprite *sb = (const Sprite *) b;
+
+	return (sa->depth > sb->depth) - (sa->depth < sb->depth);
+}
+
+/* The same order SDL_MergeSort() gives, for a sort that isn't stable */
+static int compare_sprites_index(const void *a, const void *b) {
+	const Sprite *sa = (const Sprite *) a;
+	const Sprite *sb = (const Sprite *) b;
+	int order = compare_sprites(a, b);
+
+	if(order) {
+		return order;
+	}
+	return (sa->index > sb->index) - (sa->index < sb->index);
+}
+
+/* Sorted by depth, and by index where depths are equal */
+static int check(const char *name, const Sprite *sprites, const SDL_SortKey *keys, int count) {
+	int i;
+
+	for (i = 1; i < count; ++i) {
+		Sint32 prev = sprites ? sprites[i - 1].depth : (Sint32) (keys[i - 1].key ^ 0x80000000);
+		Sint32 depth = sprites ? sprites[i].depth : (Sint32) (keys[i].key ^ 0x80000000);
+		Uint32 previndex = sprites ? sprites[i - 1].index : keys[i - 1].value;
+		Uint32 index = sprites ? sprites[i].index : keys[i].value;
+
+		if(prev > depth || (prev == depth && previndex > index)) {
+			printf("%s: out of order at %d\n", name, i);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	Sprite *world, *list, *scratch;
+	SDL_SortKey *keys, *keyscratch;
+	Uint32 qsort_ticks = 0, merge_ticks = 0, radix_ticks = 0, then;
+	int count = 10000, frames = 200;
+	int i, frame, failed = 0;
+
+	if(argc > 1) {
+		count = atoi(argv[1]);
+	}
+	if(argc > 2) {
+		frames = atoi(argv[2]);
+	}
+	if(count < 1 || frames < 1) {
+		fprintf(stderr, "Usage: testsort [sprites] [frames]\n");
+		return 1;
+	}
+	if(SDL_Init(SDL_INIT_TIMER) < 0) {
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return 1;
+	}
+
+	world = (Sprite *) malloc(count * sizeof(*world));
+	list = (Sprite *) malloc(count * sizeof(*list));
+	scratch = (Sprite *) malloc(count * sizeof(*scratch));
+	keys = (SDL_SortKey *) malloc(count * sizeof(*keys));
+	keyscratch = (SDL_SortKey *) malloc(count * sizeof(*keyscratch));
+	if(!world || !list || !scratch || !keys || !keyscratch) {
+		fprintf(stderr, "Out of memory\n");
+		SDL_Quit();
+		return 1;
+	}
+
+	srand(1);
+	for (i = 0; i < count; ++i) {
+		world[i].depth = (rand() % 2048) - 1024;
+		world[i].index = i;
+	}
+
+	for (frame = 0; frame < frames && !failed; ++frame) {
+		/* A few sprites move each frame, the draw list comes in unsorted */
+		for (i = 0; i < count / 50 + 1; ++i) {
+			world[rand() % count].depth += (rand() % 9) - 4;
+		}
+
+		/* SDL_qsort() isn't stable, so it gets the index as a tie break */
+		for (i = 0; i < count; ++i) {
+			list[i] = world[i];
+		}
+		then = SDL_GetTicks();
+		SDL_qsort(list, count, sizeof(*list), compare_sprites_index);
+		qsort_ticks += SDL_GetTicks() - then;
+		failed |= check("SDL_qsort", list, NULL, count);
+
+		for (i = 0; i < count; ++i) {
+			list[i] = world[i];
+		}
+		then = SDL_GetTicks();
+		SDL_MergeSort(list, count, sizeof(*list), compare_sprites, scratch);
+		merge_ticks += SDL_GetTicks() - then;
+		failed |= check("SDL_MergeSort", list, NULL, count);
+
+		for (i = 0; i < count; ++i) {
+			keys[i].key = (Uint32) world[i].depth ^ 0x80000000;
+			keys[i].value = world[i].index;
+		}
+		then = SDL_GetTicks();
+		SDL_RadixSort(keys, keyscratch, count);
+		radix_ticks += SDL_GetTicks() - then;
+		failed |= check("SDL_RadixSort", NULL, keys, count);
+	}
+
+	printf("%d sprites, %d frames\n", count, frames);
+	printf("SDL_qsort:     %u ms\n", (unsigned) qsort_ticks);
+	printf("SDL_MergeSort: %u ms\n", (unsigned) merge_ticks);
+	printf("SDL_RadixSort: %u ms\n", (unsigned) radix_ticks);
+
+	/* The draw list of the last frame, already in order, merges in one pass */
+	then = SDL_GetTicks();
+	for (frame = 0; frame < frames; ++frame) {
+		SDL_MergeSort(list, count, sizeof(*list), compare_sprites, scratch);
+	}
+	printf("SDL_MergeSort, sorted input: %u ms\n", (unsigned) (SDL_GetTicks() - then));
+	failed |= check("SDL_MergeSort", list, NULL, count);
+
+	free(world);
+	free(list);
+	free(scratch);
+	free(keys);
+	free(keyscratch);
+	printf("%s\n", failed ? "FAILED" : "OK");
+	SDL_Quit();
+	return failed;
+}
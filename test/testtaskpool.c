@@ -0,0 +1,104 @@
+/* Test the work-stealing task pool */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+#include "SDL_taskpool.h"
+
+#define NUM_ITEMS (4 * 1024 * 1024)
+#define NUM_TASKS 1000
+#define NUM_SUBTASKS 10
+
+static SDL_TaskPool *pool;
+static Uint32 *items;
+static SDL_atomic_t ran;
+
+static void SDLCALL Square(int start, int end, void *data) {
+	int i;
+
+	for (i = start; i < end; ++i) {
+		items[i] = (Uint32) i * (Uint32) i;
+	}
+}
+
+static void SDLCALL Leaf(void *data) {
+	SDL_AtomicIncRef(&ran);
+}
+
+/* Spawns more tasks and waits on them from inside the pool */
+static void SDLCALL Parent(void *data) {
+	SDL_atomic_t pending;
+	int i;
+
+	SDL_AtomicSet(&pending, 0);
+	for (i = 0; i < NUM_SUBTASKS; ++i) {
+		SDL_TaskSubmit(pool, Leaf, NULL, &pending);
+	}
+	SDL_TaskWait(pool, &pending);
+	SDL_AtomicIncRef(&ran);
+}
+
+static int Check(void) {
+	int i;
+
+	for (i = 0; i < NUM_ITEMS; ++i) {
+		if(items[i] != (Uint32) i * (Uint32) i) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int main(int argc, char *argv[]) {
+	Uint32 start, serial, parallel;
+	int i, workers = 0, failed = 0;
+
+	if(argc > 1) {
+		workers = atoi(argv[1]);
+	}
+	if(SDL_Init(0) < 0) {
+		fprintf(stderr, "Couldn't initialize SDL: %s\n", SDL_GetError());
+		return (1);
+	}
+	items = (Uint32 *) malloc(NUM_ITEMS * sizeof(*items));
+	pool = SDL_TaskPoolCreate(workers);
+	if(!items || !pool) {
+		fprintf(stderr, "Couldn't create task pool: %s\n", SDL_GetError());
+		SDL_Quit();
+		return (1);
+	}
+	printf("%d CPUs, %d workers\n", SDL_GetCPUCount(), SDL_TaskPoolWorkers(pool));
+
+	start = SDL_GetTicks();
+	SDL_TaskParallelFor(NULL, 0, NUM_ITEMS, 0, Square, NULL);
+	serial = SDL_GetTicks() - start;
+	SDL_memset(items, 0, NUM_ITEMS * sizeof(*items));
+
+	start = SDL_GetTicks();
+	SDL_TaskParallelFor(pool, 0, NUM_ITEMS, 0, Square, NULL);
+	parallel = SDL_GetTicks() - start;
+	printf("Parallel for: %d ms serial, %d ms on the pool\n", serial, parallel);
+	if(!Check()) {
+		fprintf(stderr, "Parallel for produced wrong results\n");
+		failed = 1;
+	}
+
+	SDL_AtomicSet(&ran, 0);
+	start = SDL_GetTicks();
+	for (i = 0; i < NUM_TASKS; ++i) {
+		SDL_TaskSubmit(pool, Parent, NULL, NULL);
+	}
+	SDL_TaskWait(pool, NULL);
+	printf("%d nested tasks in %d ms\n", SDL_AtomicGet(&ran), SDL_GetTicks() - start);
+	if(SDL_AtomicGet(&ran) != NUM_TASKS * (NUM_SUBTASKS + 1)) {
+		fprintf(stderr, "Expected %d tasks to run\n", NUM_TASKS * (NUM_SUBTASKS + 1));
+		failed = 1;
+	}
+
+	SDL_TaskPoolDestroy(pool);
+	free(items);
+	printf("%s\n", failed ? "FAILED" : "All tests passed");
+	SDL_Quit();
+	return (failed);
+}